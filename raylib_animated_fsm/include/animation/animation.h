@@ -3,23 +3,29 @@
 
 #include <raylib.h>
 
+#include "animation_system.h"
+
 typedef struct
 {
-    Texture2D texture;   // Animated Sprite Sheet Texture
-    Rectangle *frames;   // Array of frames (rectangles)
-    int currentFrame;    // Current frame index
-    int frameCount;      // Total number of frames
-    float frameDuration; // Duration of each frame
-    float frameTimer;    // Timer to track frame duration
-    bool active;         // Is the animation active?
-    bool loop;           // Should the animation loop?
+    Texture2D texture;       // Animated Sprite Sheet Texture
+    const Rectangle *frames; // Array of frames (rectangles), the clip's table is not copied
+    int frameCount;          // Total number of frames
+    float frameDuration;     // Duration of each frame
+    bool active;             // Is the animation active?
+    int cursor;              // Playback cursor in the animation system (frame and timer)
 } AnimationData;
 
-// Init Animation
-void InitAnimation(AnimationData *animationData, Texture2D texture, Rectangle *frames, int frameCount, float frameDuration, bool loop);
+// Init Animation (plays the clip on the animation's cursor, acquiring one if it has none)
+void InitAnimation(AnimationData *animationData, Texture2D texture, const Rectangle *frames, int frameCount, float frameDuration, bool loop);
+
+// Release the animation's playback cursor
+void ReleaseAnimation(AnimationData *animationData);
+
+// Current frame index (advanced by UpdateAnimationSystem)
+int GetAnimationFrame(const AnimationData *animationData);
 
-// Update Animation
-void UpdateAnimation(AnimationData *animationData);
+// Total play time of one pass through the animation (seconds)
+float GetAnimationDuration(const AnimationData *animationData);
 
 // Render Animation
 void RenderAnimation(const AnimationData *animationData, Vector2 position, Color tint);
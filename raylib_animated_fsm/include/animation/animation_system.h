@@ -0,0 +1,62 @@
+#ifndef ANIMATION_SYSTEM_H
+#define ANIMATION_SYSTEM_H
+
+#include <stdbool.h>
+
+// Cursor that is not bound to a slot in the animation system
+#define ANIMATION_CURSOR_NONE (-1)
+
+// How often a cursor turns its elapsed time into frames
+typedef enum
+{
+    ANIMATION_LOD_FULL,    // Every tick (on screen)
+    ANIMATION_LOD_REDUCED, // Every ANIMATION_LOD_REDUCED_INTERVAL ticks (just off screen)
+    ANIMATION_LOD_FROZEN   // Only when its frame is read (far off screen)
+} AnimationLod;
+
+// Ticks between advances of a reduced cursor (a power of two)
+#define ANIMATION_LOD_REDUCED_INTERVAL 4
+
+// Playback cursors of every animation, one array per field so they update in one loop
+typedef struct
+{
+    float *frameTimer;    // Time into the current frame (seconds)
+    float *frameDuration; // Duration of each frame (seconds)
+    float *frame;         // Current frame index
+    float *frameCount;    // Total number of frames
+    float *loop;          // 1 if the animation loops, 0 if it holds on the last frame
+    float *rate;          // 1 while playing, 0 for free or stopped cursors
+    float *pending;       // Time elapsed but not yet turned into frames (reduced and frozen cursors)
+    unsigned char *lod;   // AnimationLod
+    int count;            // Cursors in use or free (the arrays' used length)
+    int capacity;         // Length of the arrays
+} AnimationCursors;
+
+// Initialise the animation system
+void InitAnimationSystem();
+
+// Get a playback cursor (stopped until started)
+int AcquireAnimationCursor();
+
+// Return a playback cursor to the system
+void ReleaseAnimationCursor(int cursor);
+
+// Restart a cursor at the first frame of a clip
+void StartAnimationCursor(int cursor, int frameCount, float frameDuration, bool loop);
+
+// Stop or resume a cursor, a stopped cursor keeps its frame
+void SetAnimationCursorPlaying(int cursor, bool playing);
+
+// Set how often a cursor is advanced (full rate by default)
+void SetAnimationCursorLod(int cursor, AnimationLod lod);
+
+// Advance every playing cursor by dt seconds (once per tick), at its LOD's rate
+void UpdateAnimationSystem(float dt);
+
+// Get a cursor's current frame index (catching up the time it has not been advanced)
+int GetAnimationCursorFrame(int cursor);
+
+// Release the animation system storage
+void ExitAnimationSystem();
+
+#endif // ANIMATION_SYSTEM_H
@@ -21,6 +21,7 @@ typedef enum
     COMMAND_NONE,            // No command (used to represent a neutral or idle state)
    // COMMAND_COUNT,            // Total number of commands, useful for looping or limits
     COMMAND_SHIELD,           //for the shield
+    COMMAND_CHASE,            // Command to chase the target along its flow field (NPCs)
 } Command;
 
 // Function to execute a command
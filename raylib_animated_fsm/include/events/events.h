@@ -31,6 +31,7 @@ typedef enum
     // EVENT_HURT,    // Represents the player character taking damage (e.g., from enemies, traps, or environmental hazards).
     // EVENT_HEAL,    // Represents the player character receiving healing (e.g., health items or regenerative effects).
     EVENT_SHIELD,
+    EVENT_TIMEOUT, // Represents a scheduled timer expiring (e.g., death animation finished, shield duration over).
     // Collision Events:
     EVENT_COLLISION_START, // Represents the start of a collision (e.g., player colliding with a wall, enemy, or object).
     EVENT_COLLISION_END,   // Represents the end of a collision (e.g., player moving away from a colliding object or enemy).
@@ -5,7 +5,7 @@
 #include <stdio.h>
 
 // Include the events header file that defines the 'Event' enum
-#include "../include/events/events.h"
+#include "../events/events.h"
 
 // Forward declaration of the GameObject structure
 typedef struct GameObject GameObject;
@@ -13,6 +13,7 @@ typedef struct GameObject GameObject;
 // Define function pointer types for event handling and state management
 typedef void (*EventFunction)(GameObject *, Event); // Function type for event handlers
 typedef void (*StateFunction)(GameObject *);        // Function type for state entry, update, and exit handlers
+typedef void (*ResumeFunction)(GameObject *, float); // Function type for catching up a state after sleeping (seconds asleep)
 
 // Define an enumeration for different states of the game object
 typedef enum
@@ -35,6 +36,14 @@ typedef enum
     STATE_COUNT,      // Represents the total number of states (for counting purposes)
 } State;             // Define 'State' as the type of the enum
 
+// Archetypes with generated switch dispatch (see FSM_GENERATED_DISPATCH in fsm.c)
+typedef enum
+{
+    FSM_ARCHETYPE_DYNAMIC, // Dispatch through the StateConfig function pointers
+    FSM_ARCHETYPE_PLAYER,  // Generated from assets/fsm/player.fsm
+    FSM_ARCHETYPE_NPC,     // Generated from assets/fsm/npc.fsm
+} FsmArchetype;
+
 /**
 STATES TO BE IMPLEMENTED
 Define an enumeration for different states of the game object
@@ -57,8 +66,11 @@ typedef struct StateConfig
     StateFunction Entry;       // Pointer to the function that is called when entering this state
     StateFunction Update;      // Pointer to the function that is called to update the state
     StateFunction Exit;        // Pointer to the function that is called when exiting this state
+    ResumeFunction Resume;     // Optional function reconstructing the work skipped while asleep (see scheduler.h)
     State *nextStates;         // Array of possible next states (state transitions)
     int nextStatesCount;       // Number of possible next states
+    unsigned int transitionMask; // Bit per state in nextStates, used by CanEnterState
+    unsigned int eventMask;      // Bit per event the state reacts to, 0 if it reacts to every event
 } StateConfig;                 // Define 'StateConfig' as a structure that holds all state-related configurations
 
 // Handles an event for the given game object, triggering changes in state
@@ -70,12 +82,24 @@ bool CanEnterState(GameObject *obj, State newState);
 // Changes the state of the game object to the new state if possible
 bool ChangeState(GameObject *obj, State newState);
 
+// Records a state change that is applied at the next sync point (see entity_commands.h)
+void DeferChangeState(GameObject *obj, State newState);
+
 // Updates the current state of the game object (for example, animations, actions)
 void UpdateState(GameObject *obj);
 
+// Catches up the current state after the game object slept for the given number of seconds
+void ResumeState(GameObject *obj, float elapsed);
+
+// Schedules EVENT_TIMEOUT for the current state, cancelled automatically when the state changes
+void SetStateTimeout(GameObject *obj, float seconds);
+
 // Function to initialize valid state transitions
 void StateTransitions(StateConfig *stateConfig, State *transitions, int count);
 
+// Function to set the events a state reacts to (every event if never called)
+void StateEvents(StateConfig *stateConfig, Event *events, int count);
+
 // Function to print each state configuration
 void PrintStateConfigs(StateConfig *stateConfigs, int stateCount);
 
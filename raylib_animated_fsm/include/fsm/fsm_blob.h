@@ -0,0 +1,59 @@
+#ifndef FSM_BLOB_H
+#define FSM_BLOB_H
+
+#include <stdint.h>
+
+/**
+ * Binary layout of a precompiled FSM graph (.fsmb), written by tools/fsm_compiler
+ * from a text definition in assets/fsm/ and memory-mapped by LoadFsmGraph.
+ *
+ * [FsmBlobHeader][uint32 handler name offsets][FsmBlobState x stateCount]
+ * [int32 next states][strings]
+ *
+ * Every offset is in bytes from the start of the blob and 4 byte aligned, string
+ * offsets point at NUL terminated names. The next state lists use the in-memory
+ * layout of State, so StateConfig.nextStates points straight into the mapping.
+ */
+
+#define FSM_BLOB_MAGIC 0x424D5346u // "FSMB"
+#define FSM_BLOB_VERSION 1u
+
+// Handler id / string offset meaning "none"
+#define FSM_BLOB_NONE 0xFFFFFFFFu
+
+// Handler slots of a state, in StateConfig order
+typedef enum
+{
+    FSM_HANDLER_EVENT,  // HandleEvent (EventFunction)
+    FSM_HANDLER_ENTRY,  // Entry (StateFunction)
+    FSM_HANDLER_UPDATE, // Update (StateFunction)
+    FSM_HANDLER_EXIT,   // Exit (StateFunction)
+    FSM_HANDLER_RESUME, // Resume (ResumeFunction)
+    FSM_HANDLER_KIND_COUNT
+} FsmHandlerKind;
+
+typedef struct
+{
+    uint32_t magic;             // FSM_BLOB_MAGIC
+    uint32_t version;           // FSM_BLOB_VERSION
+    uint32_t stateCount;        // STATE_COUNT the graph was compiled against
+    uint32_t eventCount;        // EVENT_COUNT the graph was compiled against
+    uint32_t handlerCount;      // Number of distinct handler names
+    uint32_t handlersOffset;    // uint32 name offset per handler id
+    uint32_t statesOffset;      // FsmBlobState per state
+    uint32_t transitionsOffset; // int32 next state lists
+    uint32_t transitionCount;   // Total entries in the next state lists
+    uint32_t size;              // Total size of the blob in bytes
+} FsmBlobHeader;
+
+typedef struct
+{
+    uint32_t name;                             // Offset of the state name (FSM_BLOB_NONE if unused)
+    uint32_t handlers[FSM_HANDLER_KIND_COUNT]; // Handler id per slot (FSM_BLOB_NONE if not set)
+    uint32_t transitionMask;                   // Bit per state that can be entered from this state
+    uint32_t eventMask;                        // Bit per event the state reacts to (0 = every event)
+    uint32_t nextStatesFirst;                  // First entry in the next state lists
+    uint32_t nextStatesCount;                  // Number of next states
+} FsmBlobState;
+
+#endif // FSM_BLOB_H
@@ -0,0 +1,35 @@
+#ifndef FSM_LOADER_H
+#define FSM_LOADER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "fsm.h"
+#include "fsm_blob.h"
+
+// Generic handler pointer stored in the registry, cast back to the slot's type when bound
+typedef void (*FsmHandler)(void);
+
+// Register a handler under the name used in .fsm definitions
+#define REGISTER_FSM_HANDLER(kind, function) RegisterFsmHandler(#function, kind, (FsmHandler)(function))
+
+// A precompiled FSM graph shared by every object of one archetype
+typedef struct
+{
+    const char *path;                // Blob the graph was loaded from
+    void *data;                      // Mapped (or read) blob
+    size_t size;                     // Size of the blob in bytes
+    bool mapped;                     // True if data is a memory mapping
+    StateConfig states[STATE_COUNT]; // State table bound to the registered handlers
+} FsmGraph;
+
+// Register a handler function so compiled graphs can bind to it by name
+void RegisterFsmHandler(const char *name, FsmHandlerKind kind, FsmHandler handler);
+
+// Get the shared graph for a blob, loading it on first use (NULL if it is missing or invalid)
+FsmGraph *GetFsmGraph(const char *path);
+
+// Unmap every loaded graph and clear the handler registry
+void UnloadFsmGraphs();
+
+#endif // FSM_LOADER_H
@@ -0,0 +1,15 @@
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include "game.h"
+
+// Start the frame pipeline (after InitGame), the simulation gets its own thread where the platform allows
+void StartFramePipeline(GameData *gameData);
+
+// Run one frame: poll input, update the game and draw the last published snapshot
+void RunFramePipeline(GameData *gameData);
+
+// Stop the simulation thread and release the snapshots (before CloseGame)
+void StopFramePipeline();
+
+#endif // FRAME_PIPELINE_H
@@ -4,27 +4,35 @@
 #include "../utils/mediator.h"
 #include "../gameobjects/player.h"
 #include "../gameobjects/npc.h"
-#include "../utils/ai_manager.h"
 #include "../utils/input_manager.h"
+#include "../utils/entity_commands.h"
+#include "../utils/constants.h"
+#include "../render/render_snapshot.h"
+#include "../render/tilemap.h"
+#include "../utils/flow_field.h"
 
-// Define the GameData struct to store the main game components (player, npc, and mediator)
+// Define the GameData struct to store the main game components (player, npcs, and mediator)
 typedef struct
 {
-    Player *player;     // Pointer to the Player object
-    NPC *npc;           // Pointer to the NPC object
-    Mediator *mediator; // Pointer to the Mediator object for managing interactions
-                        // Mediator between command and FSM
-    Texture2D backgroundTexture;
+    Player *player;                // Pointer to the Player object
+    NPC *npcs[MAX_NPCS];           // The NPCs alive, in spawn order
+    int npcCount;                  // Number of NPCs alive
+    Mediator *mediator;            // Pointer to the Mediator object for managing interactions
+                                   // Mediator between command and FSM
+    EntityCommandBuffer *commands; // Spawns, despawns and state changes deferred to the end of the update
+    Texture2D backgroundTexture;   // Tileset of the tilemap
+    Tilemap *tilemap;              // Static level layers under the objects
+    FlowField *chaseField;         // Leads NPCs to the player, shared by all of them
 } GameData;
 
 // Initialises the game components (player, npc, mediator)
 void InitGame(GameData *gameData);
 
-// Updates the game state each frame (handles game logic)
-void UpdateGame(GameData *gameData);
+// Updates the game state each frame (handles game logic) with the input polled and the time since the last update
+void UpdateGame(GameData *gameData, Command command, float dt);
 
-// Draws or renders the current game state (e.g., player, npc, environment)
-void DrawGame(GameData *gameData);
+// Records what the current game state draws (e.g., player, npc, environment) into a render snapshot
+void BuildRenderSnapshot(GameData *gameData, RenderSnapshot *snapshot);
 
 // Closes the game, performing necessary cleanup and freeing resources
 void CloseGame(GameData *gameData);
@@ -12,15 +12,20 @@
 #include "../include/events/events.h"
 #include "../include/fsm/fsm.h"
 #include "../include/animation/animation.h"
+#include "../include/utils/timer_wheel.h"
+#include "../include/utils/random.h"
 
 // Base structure for a game object
 typedef struct GameObject
 {
     const char *name;    // The name of the game object (e.g., "Player", "Enemy")
+    int id;              // Unique id, assigned in creation order
     State previousState; // The state the game object was previously in
     State currentState;  // The current state of the game object
 
     StateConfig *stateConfigs; // Pointer to the array of state configurations for this game object
+    bool sharedStateConfigs;   // True if stateConfigs belongs to a shared, precompiled FSM graph
+    FsmArchetype archetype;    // Selects generated switch dispatch, FSM_ARCHETYPE_DYNAMIC uses stateConfigs
 
     // Position Vectors
     Vector2 position; // Gameobjects position in the game world
@@ -37,11 +42,28 @@ typedef struct GameObject
     Texture2D keyframes;
 
     // Animation
-    AnimationData animation; // Player Animation
+    AnimationData animation;      // Player Animation
+    int spriteInstance;           // Instance drawn by the sprite instancing (SPRITE_INSTANCE_NONE if drawn by RenderGameObject)
+    RandomStream animationRandom; // Animation choices (e.g., the idle variant), reproducible from the world seed
 
     int health; // The health of the game object
     float speed;
     State lastDirection;
+
+    TimerHandle stateTimer; // Timer delivering EVENT_TIMEOUT to the current state (cancelled on state change)
+
+    // Scheduling (see scheduler.h)
+    bool asleep;            // Asleep objects are not in the update set
+    unsigned int sleepTick; // Timer tick the object fell asleep on, used to catch up on wake
+    int updateSlot;         // Index in the scheduler's update set (-1 if not in it)
+    int sleepEntry;         // Entry in the scheduler's proximity grid (-1 if none)
+    float wakeRadius;       // Distance to the scheduler focus that wakes the object
+    TimerHandle wakeTimer;  // Timer that wakes the object (if any)
+
+    int crowdSlot;       // Index in the crowd (-1 if its velocity is not steered, see crowd.h)
+    int squad;           // Squad the object acts with (-1 if it decides alone, see squad.h)
+    bool hasMoveGoal;    // True if the crowd steers the object to moveGoal instead of along the flow field
+    Vector2 moveGoal;    // Spot the object's AI picked from the influence maps (e.g., to flank the player)
 } GameObject;
 
 // Initialize a new game object with the given name and default values
@@ -60,6 +82,9 @@ void InitGameObject(GameObject *obj,
 // Helper function to initialize animation
 void InitGameObjectAnimation(GameObject *obj, Rectangle *frames, int frameCount, float speed);
 
+// Render the game object's animation (objects with a sprite instance are drawn by DrawSpriteInstancesBefore)
+void RenderGameObject(const GameObject *obj, Color tint);
+
 // Check collision
 bool CheckCollision(GameObject *lhs, GameObject *rhs);
 
@@ -8,16 +8,18 @@
 
 // Include the header for the base game object
 #include "gameobject.h"
+#include "../utils/behaviour_tree.h"
 
 // Define the NPC structure that extends GameObject with an additional aggression property
 typedef struct
 {
-    GameObject base; // The base game object (inherits from GameObject)
-    int aggression;  // The aggression level of the NPC (could affect behavior)
+    GameObject base;    // The base game object (inherits from GameObject)
+    int aggression;     // The aggression level of the NPC (could affect behavior)
+    Vector2 spawnPoint; // Where the NPC spawned, its replacement spawns here after it dies
 } NPC;
 
-// Initialize a new NPC with a given name (returns a pointer to the NPC)
-NPC *InitNPC(const char *name);
+// Initialize a new NPC with a given name at a position (returns a pointer to the NPC)
+NPC *InitNPC(const char *name, Vector2 position);
 
 // Cleanup NPC
 void DeleteNPC(GameObject *obj);
@@ -25,6 +27,24 @@ void DeleteNPC(GameObject *obj);
 // Initialize NPC-specific states for the given GameObject
 void InitNPCFSM(GameObject *obj);
 
+// Register the NPC's state handlers so the compiled FSM graph can bind to them (once at startup)
+void RegisterNPCFSMHandlers();
+
+// Register the NPC's animation clips with the texture atlas (once at startup, before BuildTextureAtlas)
+void RegisterNPCAnimationClips();
+
+// Draw NPCs instanced with their frames picked on the GPU (once at startup, after BuildTextureAtlas)
+bool InitNPCSpriteInstancing();
+
+// Build the behaviour tree every NPC decides with (once at startup, before the first NPC spawns)
+void InitNPCBehaviourTree();
+
+// Get the behaviour tree every NPC decides with
+const BehaviourTree *GetNPCBehaviourTree();
+
+// Delete the NPC behaviour tree (once at shutdown)
+void ExitNPCBehaviourTree();
+
 // NPC-specific behaviors for different states
 
 // Handle events in the idle state
@@ -34,6 +54,15 @@ void NPCIdleHandleEvent(GameObject *obj, Event event);
 void NPCEnterIdle(GameObject *obj);
 void NPCUpdateIdle(GameObject *obj);
 void NPCExitIdle(GameObject *obj);
+void NPCResumeIdle(GameObject *obj, float elapsed);
+
+// Handle events in the walking state
+void NPCWalkingHandleEvent(GameObject *obj, Event event);
+
+// State transition functions for walking state
+void NPCEnterWalking(GameObject *obj);
+void NPCUpdateWalking(GameObject *obj);
+void NPCExitWalking(GameObject *obj);
 
 // Handle events in the attacking state
 void NPCAttackingHandleEvent(GameObject *obj, Event event);
@@ -21,6 +21,8 @@ typedef struct
     Color shieldColor;
     float shieldRadius;
     bool shieldActive;
+    TimerHandle attackCooldown; // Pending while the attack is cooling down (COMMAND_FIRE_COOLDOWN)
+    unsigned int regenTick;     // Timer tick stamina and mana have been regenerated up to while idle
 } Player;
 
 // Initialize a new Player with a given name (returns a pointer to the Player)
@@ -32,6 +34,12 @@ void DeletePlayer(GameObject *obj);
 // Initialize the finite state machine (FSM) for the Player (sets up the player's states)
 void InitPlayerFSM(GameObject *obj);
 
+// Register the Player's state handlers so the compiled FSM graph can bind to them (once at startup)
+void RegisterPlayerFSMHandlers();
+
+// Register the Player's animation clips with the texture atlas (once at startup, before BuildTextureAtlas)
+void RegisterPlayerAnimationClips();
+
 // Player-specific behaviors for different states
 
 // Handle events in the idle state (when the player is not performing any action)
@@ -41,6 +49,7 @@ void PlayerIdleHandleEvent(GameObject *obj, Event event);
 void PlayerEnterIdle(GameObject *obj);  // Called when entering the idle state
 void PlayerUpdateIdle(GameObject *obj); // Called to update the player's behavior while idle
 void PlayerExitIdle(GameObject *obj);   // Called when exiting the idle state
+void PlayerResumeIdle(GameObject *obj, float elapsed); // Called on wake to catch up regeneration skipped while asleep
 
 // Handle events in the walking state (when the player is walking)
 void PlayerWalkingHandleEvent(GameObject *obj, Event event);
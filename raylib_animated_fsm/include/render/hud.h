@@ -0,0 +1,33 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <stdbool.h>
+
+#include <raylib.h>
+
+// Values shown on the HUD
+typedef enum
+{
+    HUD_VALUE_LIVES,
+    HUD_VALUE_HEALTH,
+    HUD_VALUE_STAMINA,
+    HUD_VALUE_MANA,
+    HUD_VALUE_COUNT
+} HudValue;
+
+// Initialise the HUD (once, after InitWindow)
+void InitHud();
+
+// Set a value shown on the HUD, the HUD is only redrawn if it changed
+void SetHudValue(HudValue value, int amount);
+
+// Check if the HUD will be redrawn on the next DrawHud
+bool IsHudDirty();
+
+// Draw the HUD over the screen (outside BeginMode2D), redrawing its texture first if a value changed
+void DrawHud();
+
+// Release the HUD's texture
+void ExitHud();
+
+#endif // HUD_H
@@ -0,0 +1,62 @@
+#ifndef OVERLAY_BATCH_H
+#define OVERLAY_BATCH_H
+
+#include <stdbool.h>
+
+#include <raylib.h>
+
+// A vertex of an overlay triangle
+typedef struct
+{
+    Vector2 position; // Position in world coordinates
+    Color color;      // Vertex color
+} OverlayVertex;
+
+// Triangles taken out of the batch, ready to draw (e.g., in a render snapshot)
+typedef struct
+{
+    OverlayVertex *vertices;
+    int count;
+    int capacity;
+} OverlayList;
+
+// Initialise the overlay batch
+void InitOverlayBatch();
+
+// Start recording overlay primitives for a frame
+void BeginOverlayBatch();
+
+// Record a filled rectangle
+void SubmitOverlayRect(Rectangle rect, Color color);
+
+// Record a filled circle
+void SubmitOverlayCircle(Vector2 center, float radius, Color color);
+
+// Record a line with a thickness
+void SubmitOverlayLine(Vector2 start, Vector2 end, float thickness, Color color);
+
+// Record the outline of a circle
+void SubmitOverlayCircleLines(Vector2 center, float radius, float thickness, Color color);
+
+// Check if overlay primitives are being recorded
+bool IsOverlayBatchActive();
+
+// Draw every primitive recorded since BeginOverlayBatch as one block of triangles
+void EndOverlayBatch();
+
+// Stop recording and move the triangles into a list instead of drawing them
+void TakeOverlayBatch(OverlayList *list);
+
+// Draw a list taken from the batch as one block of triangles
+void DrawOverlayList(const OverlayList *list);
+
+// Release a list's storage
+void ReleaseOverlayList(OverlayList *list);
+
+// Number of draw calls the last EndOverlayBatch or DrawOverlayList issued
+int GetOverlayBatchDrawCalls();
+
+// Release the overlay batch storage
+void ExitOverlayBatch();
+
+#endif // OVERLAY_BATCH_H
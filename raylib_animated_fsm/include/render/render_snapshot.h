@@ -0,0 +1,28 @@
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include <raylib.h>
+
+#include "sprite_batch.h"
+#include "overlay_batch.h"
+#include "hud.h"
+#include "tilemap.h"
+
+// Everything needed to draw one frame, published by the simulation and only read while drawn
+typedef struct
+{
+    Camera2D camera;                // Camera the world is drawn with
+    Rectangle view;                 // Part of the world the camera sees
+    Tilemap *tilemap;               // Static level layers, under everything else (tiles do not change while drawn)
+    SpriteList sprites;             // Sprites in draw order
+    OverlayList overlays;           // Health bars, the shield and debug shapes
+    int hudValues[HUD_VALUE_COUNT]; // Values shown on the HUD
+} RenderSnapshot;
+
+// Draw a snapshot to the screen (BeginDrawing to EndDrawing, on the thread that owns the window)
+void DrawRenderSnapshot(const RenderSnapshot *snapshot);
+
+// Release a snapshot's sprite and overlay storage
+void ReleaseRenderSnapshot(RenderSnapshot *snapshot);
+
+#endif // RENDER_SNAPSHOT_H
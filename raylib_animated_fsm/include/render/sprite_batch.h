@@ -0,0 +1,69 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <stdbool.h>
+
+#include <raylib.h>
+
+// Draw order of sprites, lower layers are drawn first
+typedef enum
+{
+    SPRITE_LAYER_BACKGROUND, // Backgrounds and floor decals
+    SPRITE_LAYER_ACTORS,     // Player and NPCs
+    SPRITE_LAYER_EFFECTS,    // Drawn over the actors
+    SPRITE_LAYER_COUNT
+} SpriteLayer;
+
+// A sprite recorded for the current frame
+typedef struct
+{
+    Texture2D texture; // Texture the source rectangle is in
+    Rectangle source;  // Source rectangle (negative width/height flips the sprite)
+    Vector2 position;  // Top left corner in world coordinates
+    Color tint;        // Tint applied to the sprite
+    int layer;         // SpriteLayer
+    float depth;       // Draw order within the layer (world y, lower is drawn first)
+} Sprite;
+
+// Sprites taken out of the batch, sorted and ready to draw (e.g., in a render snapshot)
+typedef struct
+{
+    Sprite *sprites;
+    int count;
+    int capacity;
+} SpriteList;
+
+// Initialise the sprite batch
+void InitSpriteBatch();
+
+// Start recording sprites for a frame
+void BeginSpriteBatch();
+
+// Record a sprite, drawn immediately if no batch is being recorded
+void SubmitSprite(Texture2D texture, Rectangle source, Vector2 position, Color tint, SpriteLayer layer, float depth);
+
+// Check if sprites are being recorded
+bool IsSpriteBatchActive();
+
+// Sort the recorded sprites by layer, depth and texture and draw them (one draw call per run of a texture)
+void EndSpriteBatch();
+
+// Stop recording and move the sorted sprites into a list instead of drawing them
+void TakeSpriteBatch(SpriteList *list);
+
+// Draw a list taken from the batch (one draw call per run of a texture)
+void DrawSpriteList(const SpriteList *list);
+
+// Draw count sprites of a list taken from the batch from the first one on (one draw call per run of a texture)
+void DrawSpriteListRange(const SpriteList *list, int first, int count);
+
+// Release a list's storage
+void ReleaseSpriteList(SpriteList *list);
+
+// Number of draw calls the last EndSpriteBatch, DrawSpriteList or DrawSpriteListRange issued
+int GetSpriteBatchDrawCalls();
+
+// Release the sprite batch storage
+void ExitSpriteBatch();
+
+#endif // SPRITE_BATCH_H
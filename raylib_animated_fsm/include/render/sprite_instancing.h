@@ -0,0 +1,65 @@
+#ifndef SPRITE_INSTANCING_H
+#define SPRITE_INSTANCING_H
+
+#include <stdbool.h>
+
+#include <raylib.h>
+
+// Instance that is not drawn by the sprite instancing
+#define SPRITE_INSTANCE_NONE (-1)
+
+// Most clips, and frames across all clips, in the GPU clip table
+#define MAX_SPRITE_INSTANCE_CLIPS 32
+#define MAX_SPRITE_INSTANCE_FRAMES 192
+
+// Per instance data uploaded to the GPU, the shader picks the frame from it
+typedef struct
+{
+    float clip;       // Clip id in the clip table
+    float startTime;  // Time the clip started (seconds since InitSpriteInstancing)
+    float speed;      // Frames per second
+    Vector2 position; // Centre of the sprite in world coordinates
+    Color tint;       // Tint applied to the sprite
+} SpriteInstance;
+
+// Initialise instanced drawing of sprites from a texture, false if the platform cannot
+bool InitSpriteInstancing(Texture2D texture);
+
+// Check if instanced sprites are drawn (InitSpriteInstancing succeeded)
+bool IsSpriteInstancingEnabled();
+
+// Add a clip to the GPU clip table (its frames are read when the table is next uploaded)
+int AddSpriteInstanceClip(const Rectangle *frames, int frameCount);
+
+// Find the clip id of a clip's frames (-1 if the clip is not in the table)
+int FindSpriteInstanceClip(const Rectangle *frames, int frameCount);
+
+// Add an instance (returns its handle)
+int AddSpriteInstance(Vector2 position, Color tint);
+
+// Play a clip on an instance from now (on state change)
+void SetSpriteInstanceClip(int instance, int clip, float frameDuration);
+
+// Move an instance (only uploaded if the position changed)
+void SetSpriteInstancePosition(int instance, Vector2 position);
+
+// Remove an instance
+void RemoveSpriteInstance(int instance);
+
+// Sort the instances by depth and upload the ones changed since the last sync (render thread, while
+// the simulation is not running)
+void SyncSpriteInstances();
+
+// Start drawing the instances as of the last sync for a frame, culling the ones above and below the view
+void BeginSpriteInstances(Rectangle view, float margin);
+
+// Check if DrawSpriteInstancesBefore would draw anything at this depth
+bool HasSpriteInstancesBefore(float depth);
+
+// Draw the instances in view above a depth not drawn yet in one instanced draw call (inside BeginMode2D)
+void DrawSpriteInstancesBefore(float depth);
+
+// Release the shader, buffers and instances
+void ExitSpriteInstancing();
+
+#endif // SPRITE_INSTANCING_H
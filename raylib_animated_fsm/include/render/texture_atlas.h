@@ -0,0 +1,18 @@
+#ifndef TEXTURE_ATLAS_H
+#define TEXTURE_ATLAS_H
+
+#include <raylib.h>
+
+// Register a clip's frames on a sprite sheet, BuildTextureAtlas rewrites them to atlas coordinates
+void AddAtlasClip(const char *sheetPath, Rectangle *frames, int frameCount);
+
+// Pack every frame the registered clips reference into shared textures (once, after InitWindow)
+void BuildTextureAtlas();
+
+// Get the texture to draw a sheet's clips with (its atlas page, or the sheet itself if it was not packed)
+Texture2D GetAtlasTexture(const char *sheetPath);
+
+// Unload the atlas pages and any sheets loaded as a fallback
+void UnloadTextureAtlas();
+
+#endif // TEXTURE_ATLAS_H
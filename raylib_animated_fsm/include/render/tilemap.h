@@ -0,0 +1,70 @@
+#ifndef TILEMAP_H
+#define TILEMAP_H
+
+#include <stdbool.h>
+
+#include <raylib.h>
+
+// Tile that draws nothing
+#define TILE_EMPTY (-1)
+
+// Static layers composited into each chunk, lower layers are drawn first
+typedef enum
+{
+    TILEMAP_LAYER_GROUND,     // Floor, covers the whole map
+    TILEMAP_LAYER_DECORATION, // Drawn over the ground (mostly empty)
+    TILEMAP_LAYER_COUNT
+} TilemapLayer;
+
+// Tiles along each side of a chunk
+#define TILEMAP_CHUNK_TILES 16
+
+// Most chunks rendered into their cache texture per frame, the rest are drawn tile by tile until cached
+#define TILEMAP_CHUNK_BUILDS_PER_FRAME 2
+
+// A block of TILEMAP_CHUNK_TILES x TILEMAP_CHUNK_TILES tiles, cached as one texture while near the camera
+typedef struct
+{
+    RenderTexture2D texture; // Every layer of the chunk, drawn once
+    bool cached;             // True if texture holds the chunk's tiles
+    bool dirty;              // A tile changed since the texture was drawn
+} TilemapChunk;
+
+// A grid of tiles taken from a tileset texture, in layers
+typedef struct
+{
+    Texture2D tileset; // Tiles in a grid of tileSize x tileSize cells, numbered row by row
+    int tileSize;      // Size of a tile in the world and on the tileset
+    int columns;       // Tiles across the map
+    int rows;          // Tiles down the map
+    int *tiles[TILEMAP_LAYER_COUNT];
+
+    TilemapChunk *chunks;
+    int chunkColumns;
+    int chunkRows;
+    int *cached;      // Indices of the chunks with a cache texture loaded
+    int cachedChunks; // Length of cached
+} Tilemap;
+
+// Create an empty tilemap of columns x rows tiles
+Tilemap *CreateTilemap(Texture2D tileset, int tileSize, int columns, int rows);
+
+// Set a tile (before the frame pipeline starts, chunks are not locked against the render thread)
+void SetTile(Tilemap *tilemap, TilemapLayer layer, int column, int row, int tile);
+
+// Get a tile (TILE_EMPTY outside the map)
+int GetTile(const Tilemap *tilemap, TilemapLayer layer, int column, int row);
+
+// Cache the chunks around the view and release the far ones (render thread, outside BeginMode2D)
+void StreamTilemapChunks(Tilemap *tilemap, Rectangle view);
+
+// Draw the part of the tilemap in view (inside BeginMode2D), one draw per cached chunk
+void DrawTilemap(const Tilemap *tilemap, Rectangle view);
+
+// Number of chunks with a cache texture loaded
+int GetCachedTilemapChunks(const Tilemap *tilemap);
+
+// Delete a tilemap and its chunk textures
+void DeleteTilemap(Tilemap *tilemap);
+
+#endif // TILEMAP_H
@@ -0,0 +1,26 @@
+#ifndef WORLD_CAMERA_H
+#define WORLD_CAMERA_H
+
+#include <stdbool.h>
+
+#include <raylib.h>
+
+// Initialise the world camera centred on a target (once, after InitWindow)
+void InitWorldCamera(Vector2 target);
+
+// Follow a target, keeping the view inside the world (once per update)
+void UpdateWorldCamera(Vector2 target);
+
+// Get the camera to draw the world with (BeginMode2D)
+Camera2D GetWorldCamera();
+
+// Get the part of the world the camera sees, in world coordinates
+Rectangle GetWorldView();
+
+// Check if a rectangle in world coordinates overlaps the camera's view
+bool IsWorldRectVisible(Rectangle rect);
+
+// Check if a point in world coordinates is within margin of the camera's view
+bool IsWorldPointNearView(Vector2 point, float margin);
+
+#endif // WORLD_CAMERA_H
@@ -1,10 +0,0 @@
-#ifndef AI_MANAGER_H
-#define AI_MANAGER_H
-
-#include "../command/command.h"
-
-void InitAIManager();
-Command PollAI();
-void ExitInputManager();
-
-#endif // AI_MANAGER_H
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef AI_SYSTEM_H
+#define AI_SYSTEM_H
+
+#include "../command/command.h"
+#include "../gameobjects/gameobject.h"
+#include "behaviour_tree.h"
+#include "random.h"
+
+// An NPC's decision making, evaluated on the job pool
+typedef struct
+{
+    GameObject *obj;            // The object the decisions are for
+    const BehaviourTree *tree;  // The archetype's tree (NULL to act on the utility scores alone)
+    BTBlackboard blackboard;    // The agent's place in its tree
+    float interval;             // Seconds between decisions
+    float untilThink;           // Seconds until the next decision
+    float aggression;           // Aggression in [0, 1], weighs attacking against holding back
+    RandomStream random;        // Stream the agent's decisions draw from
+    Command command;            // Slot a worker writes the decision to, consumed on the simulation thread
+    bool decided;               // False if the decision was to carry on (e.g., a running action)
+    bool hasGoal;               // True if the agent picked a spot to move to, handed to the object with the decision
+    Vector2 goal;               // The spot, from the influence maps (see perception.h)
+} AIAgent;
+
+// Fewest due agents evaluated per batch on a worker
+#define AI_AGENTS_PER_BATCH 256
+
+// What an update of the AI system decided and left for later
+typedef struct
+{
+    int due;            // Agents whose decision was due
+    int thought;        // Agents that decided
+    int deferred;       // Due agents left for a later update (over budget)
+    float milliseconds; // Time spent deciding
+    float longestWait;  // Most seconds a deferred agent is past due
+} AIThinkReport;
+
+// Initialise the AI system
+void InitAISystem();
+
+// Give an object decisions from a tree every interval seconds (the first one interval seconds
+// from now), aggression is in [0, 100]
+void AddAIAgent(GameObject *obj, const BehaviourTree *tree, float interval, int aggression);
+
+// Stop an object's decisions (before it is deleted)
+void RemoveAIAgent(GameObject *obj);
+
+// Evaluate the due agents' decisions in parallel, then apply them in entity id order (once per
+// update, after PublishWorldFacts)
+void UpdateAISystem(float dt);
+
+// Set how many milliseconds deciding may take per update (0 for no limit)
+void SetAIThinkBudget(float milliseconds);
+
+// Get what the last update decided and deferred
+AIThinkReport GetAIThinkReport();
+
+// Number of objects with decisions
+int GetAIAgentCount();
+
+// Release the AI system storage
+void ExitAISystem();
+
+#endif // AI_SYSTEM_H
@@ -0,0 +1,101 @@
+#ifndef BEHAVIOUR_TREE_H
+#define BEHAVIOUR_TREE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../command/command.h"
+
+// Result of ticking a node
+typedef enum
+{
+    BT_FAILURE,
+    BT_SUCCESS,
+    BT_RUNNING
+} BTStatus;
+
+// Kinds of node
+typedef enum
+{
+    BT_SEQUENCE,  // Runs its children in order until one fails
+    BT_SELECTOR,  // Runs its children in order until one succeeds
+    BT_CONDITION, // Succeeds if a blackboard value passes a test
+    BT_ACTION,    // Emits a command, then runs for a while
+    BT_SUGGESTED  // Emits the command suggested by the caller (e.g., the utility scoring), then succeeds
+} BTNodeType;
+
+// Tests a condition can make
+typedef enum
+{
+    BT_BELOW,   // value < threshold
+    BT_AT_LEAST // value >= threshold
+} BTCompare;
+
+// Values an agent's blackboard holds, written by the caller before every tick
+typedef enum
+{
+    BT_KEY_TARGET_DISTANCE,  // Distance to the target (world units)
+    BT_KEY_HEALTH,           // Own health
+    BT_KEY_AGGRESSION,       // Own aggression
+    BT_KEY_TARGET_THREAT,    // 1 while the target is attacking
+    BT_KEY_ALLIES_ATTACKING, // Others already attacking the target up close
+    BT_KEY_COUNT
+} BTKey;
+
+// Marks no node (no parent, nothing running)
+#define BT_NODE_NONE 0xFFFF
+
+// Most nodes in a tree (node indices are 16 bits)
+#define BT_MAX_NODES 0xFFFE
+
+// A node of a tree definition, trees are written as an outline in depth first order
+typedef struct
+{
+    int depth;         // 0 for the root, children are one deeper than their parent
+    BTNodeType type;
+    int argument;      // Condition: the BTKey tested, action: the Command emitted
+    BTCompare compare; // Condition: the test
+    float value;       // Condition: the threshold, action: seconds it runs for
+} BTNodeDef;
+
+// A flattened node, a node's children follow it and its subtree ends at next
+typedef struct
+{
+    uint8_t type;     // BTNodeType
+    uint8_t argument; // BTKey or Command
+    uint8_t compare;  // BTCompare
+    uint8_t padding;
+    uint16_t parent;  // Parent node (BT_NODE_NONE for the root)
+    uint16_t next;    // One past the last node of the subtree, the next sibling if the parent has one
+    float value;
+} BTNode;
+
+// A tree, built once per archetype and shared by every agent running it
+typedef struct
+{
+    BTNode *nodes;
+    int count;
+} BehaviourTree;
+
+// Per agent state of a tree, small enough to keep next to the agent
+typedef struct
+{
+    float values[BT_KEY_COUNT]; // Written by the caller before every tick
+    float actionTime;           // Seconds the running action has left
+    uint16_t running;           // Node the last tick stopped in (BT_NODE_NONE to start at the root)
+} BTBlackboard;
+
+// Build a tree from an outline (returns a pointer to the tree)
+BehaviourTree *CreateBehaviourTree(const BTNodeDef *defs, int count);
+
+// Prepare an agent's blackboard (starts at the root with every value 0)
+void InitBTBlackboard(BTBlackboard *blackboard);
+
+// Tick a tree for an agent, returns true if a command was emitted
+bool TickBehaviourTree(const BehaviourTree *tree, BTBlackboard *blackboard, float dt,
+                       Command suggested, Command *command);
+
+// Delete a tree
+void DeleteBehaviourTree(BehaviourTree *tree);
+
+#endif // BEHAVIOUR_TREE_H
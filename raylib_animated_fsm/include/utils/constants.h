@@ -4,10 +4,20 @@
 #define SCREEN_WIDTH 800
 #define SCREEN_HEIGHT 600
 
+// Size of the world, the camera follows the player around it
+#define WORLD_WIDTH 2400
+#define WORLD_HEIGHT 1800
+
+// Size of the background tiles, the background image is used as their tileset
+#define BACKGROUND_TILE_SIZE 50
+
 // Buffer zone to avoid stuck states in collision detection
 static const float COLLISION_BUFFER = 2.0f;
 static const float COLLISION_PUSH_BACK = 2.0f;
 
+// Timer wheel ticks per second (one tick per game update at the target FPS)
+#define TIMER_TICKS_PER_SECOND 60
+
 // Firing Cooldown (0.1 seconds)
 static const double COMMAND_FIRE_COOLDOWN = 0.1f;
 
@@ -22,4 +32,97 @@ static const float MOVE_VERTICAL_THRESHOLD = 0.5f;
 static const float MOVE_HORIZONTAL_THRESHOLD = 0.5f;
 static const float MOVE_DIAGONAL_THRESHOLD = 0.5f;
 
+// How long the player's shield stays up (seconds)
+static const float SHIELD_DURATION = 3.0f;
+
+// Interval between NPC AI decisions (seconds)
+static const float AI_THINK_INTERVAL = 1.0f;
+
+// Distance to the target beyond which NPCs no longer consider it close (proximity input is 0)
+static const float AI_SENSE_RANGE = 400.0f;
+
+// Milliseconds NPC decisions may take per update, the rest wait for the next update
+static const float AI_THINK_BUDGET_MS = 2.0f;
+
+// Seconds between the log lines summing up what the AI decided and deferred
+static const float AI_REPORT_INTERVAL = 5.0f;
+
+// How much being right next to the target counts toward deciding sooner, against
+// being a whole interval past due (1)
+static const float AI_PRIORITY_PROXIMITY_WEIGHT = 1.0f;
+
+// Distance to the target within which an NPC attacks it outright
+static const float NPC_ATTACK_RANGE = 50.0f;
+
+// Most NPCs that attack the player up close at once, others hold back
+#define NPC_MAX_ATTACKERS 3
+
+// Width and height of a flow field cell (world units)
+#define FLOW_FIELD_CELL_SIZE 50
+
+// Distance within which crowd members steer apart, and how hard against following the flow field
+static const float CROWD_NEIGHBOUR_RADIUS = 48.0f;
+static const float CROWD_SEPARATION_WEIGHT = 2.0f;
+
+// Distance to a move goal within which crowd members slow down to stop on it
+static const float CROWD_ARRIVAL_RADIUS = 20.0f;
+
+// Width and height of an influence map cell (world units)
+#define INFLUENCE_CELL_SIZE 25
+
+// Blur passes spreading the ally layer (each reaches one cell further)
+#define INFLUENCE_BLUR_PASSES 2
+
+// Reach of the player's threat, fading from its position
+static const float INFLUENCE_THREAT_RANGE = 200.0f;
+
+// Reach of the player's attack arc in the danger layer, and the cosine of half its angle (120 degrees)
+static const float INFLUENCE_DANGER_RANGE = 75.0f;
+static const float INFLUENCE_DANGER_COS_HALF_ANGLE = 0.5f;
+
+// Distance to the player within which NPCs pick their own spot from the influence maps
+// instead of following the flow field
+static const float AI_TACTICS_RANGE = 150.0f;
+
+// Ring around the player NPCs flank it from (inside NPC_ATTACK_RANGE), and the widest angle
+// between the sides NPCs coming from one direction flank it from (radians)
+static const float NPC_FLANK_MIN_RANGE = 20.0f;
+static const float NPC_FLANK_MAX_RANGE = 45.0f;
+static const float NPC_FLANK_SPREAD = 3.1415927f;
+
+// Cost of each world unit between an NPC and a spot it considers, against the influence layers
+static const float INFLUENCE_TRAVEL_COST = 0.005f;
+
+// Health below which NPCs fall back, and how far they look for somewhere safer
+static const float NPC_RETREAT_HEALTH = 40.0f;
+static const float NPC_RETREAT_RANGE = 200.0f;
+
+// Angle between neighbouring squad members closing in on the player (radians), and the
+// distance of squad members from the spot they fall back to
+static const float SQUAD_ENGAGE_SPREAD = 0.7f;
+static const float SQUAD_FORMATION_SPACING = 40.0f;
+
+// Distance of pack members from the pack's spawn point
+static const float NPC_PACK_SPAWN_RADIUS = 60.0f;
+
+// Distance to the player within which idle NPCs stay awake (beyond a screen diagonal,
+// so a sleeping NPC is never on screen)
+static const float NPC_WAKE_RADIUS = 1000.0f;
+
+// Distance to the player within which an NPC counts as targeted and shows its health bar
+static const float HEALTH_BAR_TARGET_RANGE = 150.0f;
+
+// Farthest an object's sprite or health bar reaches from its position (largest frame is 192 x 192)
+static const float SPRITE_CULL_MARGIN = 128.0f;
+
+// Distance outside the camera's view within which animations still advance at a reduced rate,
+// further out they are frozen until they are seen (or their frame is read)
+static const float ANIMATION_LOD_REDUCED_MARGIN = 512.0f;
+
+// Most NPCs alive at once
+#define MAX_NPCS 64
+
+// How long a dead NPC stays on screen before it is despawned and replaced (seconds)
+static const float NPC_CORPSE_DURATION = 3.0f;
+
 #endif // CONSTANTS_H
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef CROWD_H
+#define CROWD_H
+
+#include "../gameobjects/gameobject.h"
+#include "flow_field.h"
+
+// Fewest crowd members steered per batch on a worker
+#define CROWD_AGENTS_PER_BATCH 256
+
+// Most neighbours a member steers around (the nearest are not guaranteed, any this many will do)
+#define CROWD_MAX_NEIGHBOURS 16
+
+// Initialise the crowd
+void InitCrowd();
+
+// Add an object to the crowd, its velocity is steered from then on (ignored if already in it)
+void AddCrowdAgent(GameObject *obj);
+
+// Remove an object from the crowd (ignored if it is not in it)
+void RemoveCrowdAgent(GameObject *obj);
+
+// Steer every member along a flow field around its neighbours, writing its velocity (once per update, before objects move)
+void UpdateCrowd(const FlowField *field);
+
+// Number of objects in the crowd
+int GetCrowdAgentCount();
+
+// Release the crowd storage
+void ExitCrowd();
+
+#endif // CROWD_H
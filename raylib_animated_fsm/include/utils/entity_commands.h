@@ -0,0 +1,70 @@
+#ifndef ENTITY_COMMANDS_H
+#define ENTITY_COMMANDS_H
+
+#include <stdbool.h>
+
+#include <raylib.h>
+
+#include "../fsm/fsm.h"
+
+// Structural changes that are recorded during a phase and applied at a sync point
+typedef enum
+{
+    ENTITY_COMMAND_SPAWN_NPC,    // Create an NPC
+    ENTITY_COMMAND_CHANGE_STATE, // Run ChangeState on an entity
+    ENTITY_COMMAND_DESPAWN       // Delete an entity
+} EntityCommandType;
+
+// A recorded structural change
+typedef struct
+{
+    EntityCommandType type;
+    int entityId;          // Target entity id, spawns sort after every existing entity
+    unsigned int sequence; // Recording order, breaks ties between commands for one entity
+    GameObject *target;    // Target entity (NULL for spawns)
+    State state;           // New state for ENTITY_COMMAND_CHANGE_STATE
+    State fromState;       // State the target was in when the change was recorded
+    const char *name;      // Name for ENTITY_COMMAND_SPAWN_NPC (must outlive the command)
+    Vector2 position;      // Position for ENTITY_COMMAND_SPAWN_NPC
+    int squad;             // Squad the spawned NPC joins for ENTITY_COMMAND_SPAWN_NPC (SQUAD_NONE if none)
+} EntityCommand;
+
+typedef struct EntityCommandBuffer
+{
+    EntityCommand *commands; // Recorded commands
+    int count;               // Number of recorded commands
+    int capacity;            // Allocated commands
+    unsigned int sequence;   // Next recording sequence number
+} EntityCommandBuffer;
+
+// Create an empty command buffer
+EntityCommandBuffer *CreateEntityCommandBuffer();
+
+// Record the spawn of an NPC at a position, joining a squad (SQUAD_NONE to decide alone)
+void RecordSpawnNPC(EntityCommandBuffer *buffer, const char *name, Vector2 position, int squad);
+
+// Record the removal of an entity (later commands for it are ignored)
+void RecordDespawn(EntityCommandBuffer *buffer, GameObject *obj);
+
+// Record a state change for an entity (dropped if the entity has left its current state by then)
+void RecordChangeState(EntityCommandBuffer *buffer, GameObject *obj, State newState);
+
+// Check if a recorded state change no longer applies (its target changed state since)
+bool IsEntityCommandStale(const EntityCommand *command);
+
+// Sort the commands into their deterministic apply order (entity id, then recording order)
+void SortEntityCommands(EntityCommandBuffer *buffer);
+
+// Drop the first count commands, keeping commands recorded while they were applied
+void DiscardEntityCommands(EntityCommandBuffer *buffer, int count);
+
+// Free the command buffer
+void DeleteEntityCommandBuffer(EntityCommandBuffer *buffer);
+
+// Set the buffer that DeferChangeState and other deferred requests record into
+void SetDeferredCommands(EntityCommandBuffer *buffer);
+
+// Get the buffer for deferred requests (NULL if none is set)
+EntityCommandBuffer *GetDeferredCommands();
+
+#endif // ENTITY_COMMANDS_H
@@ -0,0 +1,49 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include <stdbool.h>
+
+#include <raylib.h>
+
+// A cell waiting in a build, with the cost it was reached at
+typedef struct
+{
+    float cost;
+    int cell;
+} FlowOpenCell;
+
+// A grid of directions leading every cell toward one target, shared by everything chasing it
+typedef struct
+{
+    int columns;
+    int rows;
+    float cellSize;
+
+    unsigned char *blocked; // 1 for cells nothing can enter
+    float *cost;            // Path cost from each cell to the target cell (INFINITY if unreachable)
+    Vector2 *direction;     // Unit direction toward the next cell on the path (zero if none)
+
+    int targetCell;         // Cell the field leads to (-1 before the first build)
+    Vector2 targetPosition; // Where the target is, chasers in its cell head straight there
+    bool dirty;             // Obstacles changed since the last build
+
+    FlowOpenCell *heap; // Open cells of a build, ordered by cost
+    int heapCount;
+} FlowField;
+
+// Create a flow field over columns x rows cells of cellSize world units (returns a pointer to the field)
+FlowField *CreateFlowField(int columns, int rows, float cellSize);
+
+// Block or unblock a cell (the field is rebuilt on its next update)
+void SetFlowFieldBlocked(FlowField *field, int column, int row, bool blocked);
+
+// Lead the field to a target, rebuilt only if the target changed cell or obstacles changed (returns true if rebuilt)
+bool UpdateFlowField(FlowField *field, Vector2 target);
+
+// Get the direction toward the target from a position (zero if there is no path)
+Vector2 GetFlowDirection(const FlowField *field, Vector2 position);
+
+// Delete a flow field
+void DeleteFlowField(FlowField *field);
+
+#endif // FLOW_FIELD_H
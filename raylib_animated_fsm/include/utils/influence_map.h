@@ -0,0 +1,55 @@
+#ifndef INFLUENCE_MAP_H
+#define INFLUENCE_MAP_H
+
+#include <raylib.h>
+
+// What an influence map layer measures
+typedef enum
+{
+    INFLUENCE_THREAT, // Nearness to the player, stronger while it attacks
+    INFLUENCE_ALLIES, // Density of living NPCs
+    INFLUENCE_DANGER, // Reach of the player's attack arc, in front of it
+    INFLUENCE_LAYER_COUNT
+} InfluenceLayer;
+
+// Layered values on a coarse grid over the world, one array per layer
+typedef struct
+{
+    int columns;
+    int rows;
+    float cellSize;
+    float *layers[INFLUENCE_LAYER_COUNT];
+    float *scratch; // Blur pass output
+} InfluenceMap;
+
+// Create an influence map over columns x rows cells of cellSize world units (returns a pointer to the map)
+InfluenceMap *CreateInfluenceMap(int columns, int rows, float cellSize);
+
+// Clear every layer
+void ClearInfluenceMap(InfluenceMap *map);
+
+// Add amount to a layer at a position, split over the four nearest cells
+void StampInfluence(InfluenceMap *map, InfluenceLayer layer, Vector2 position, float amount);
+
+// Add a circle of radius around a position to a layer, amount at its centre falling to 0 at its edge
+void StampInfluenceCircle(InfluenceMap *map, InfluenceLayer layer, Vector2 position, float radius, float amount);
+
+// Add an arc of radius in front of a position, facing a unit direction, to a layer
+void StampInfluenceArc(InfluenceMap *map, InfluenceLayer layer, Vector2 position, Vector2 facing, float radius,
+                       float cosHalfAngle);
+
+// Spread a layer into the neighbouring cells (passes of a 3 x 3 tent filter)
+void BlurInfluence(InfluenceMap *map, InfluenceLayer layer, int passes);
+
+// Get a layer's value at a position (0 outside the map)
+float SampleInfluence(const InfluenceMap *map, InfluenceLayer layer, Vector2 position);
+
+// Find the cell between minRadius and maxRadius of center with the lowest weighted sum of the layers,
+// plus travel for each world unit from the asker's position
+Vector2 FindInfluencePosition(const InfluenceMap *map, Vector2 center, float minRadius, float maxRadius,
+                              const float weights[INFLUENCE_LAYER_COUNT], Vector2 from, float travel);
+
+// Delete an influence map
+void DeleteInfluenceMap(InfluenceMap *map);
+
+#endif // INFLUENCE_MAP_H
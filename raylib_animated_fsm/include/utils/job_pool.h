@@ -0,0 +1,22 @@
+#ifndef JOB_POOL_H
+#define JOB_POOL_H
+
+// Work on the items [first, last) of a parallel job, called on any thread of the pool
+typedef void (*JobFunction)(void *context, int first, int last);
+
+// Most worker threads started, on top of the thread running jobs
+#define MAX_JOB_WORKERS 15
+
+// Start the worker threads (one per core besides the caller, 0 on web builds)
+void InitJobPool();
+
+// Split count items into batches of at least minBatch and run them across the pool, returns when all are done
+void RunParallelJob(JobFunction function, void *context, int count, int minBatch);
+
+// Number of worker threads besides the caller
+int GetJobPoolWorkers();
+
+// Stop the worker threads
+void ExitJobPool();
+
+#endif // JOB_POOL_H
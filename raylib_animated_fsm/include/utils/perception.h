@@ -0,0 +1,53 @@
+#ifndef PERCEPTION_H
+#define PERCEPTION_H
+
+#include <stdbool.h>
+
+#include "../gameobjects/npc.h"
+#include "influence_map.h"
+
+// What the AI knows about the world this update, published once and only read after that
+typedef struct
+{
+    unsigned long tick; // Updates published so far
+
+    // The player
+    bool playerPresent;     // False before the player exists (every other player fact is zero)
+    Vector2 playerPosition;
+    Vector2 playerFacing;   // Unit direction the player last moved in, and attacks in
+    State playerState;
+    bool playerAttacking;
+    int playerHealth;
+
+    // The NPCs
+    int npcCount;                    // NPCs in the world
+    int npcsAlive;                   // NPCs not dead
+    int npcsInState[STATE_COUNT];    // NPCs in each state
+    const GameObject *nearestThreat; // Living NPC nearest the player (NULL if none)
+    float nearestThreatDistance;     // Its distance to the player (INFINITY if none)
+    int attackersInRange;            // NPCs attacking within NPC_ATTACK_RANGE of the player
+
+    // Where the player threatens, where the NPCs are and where the player's attack reaches
+    const InfluenceMap *influence;
+} WorldFacts;
+
+// Initialise the perception (no facts until the first PublishWorldFacts)
+void InitPerception();
+
+// Free the perception's influence maps (once at shutdown)
+void ExitPerception();
+
+// Work out this update's facts from the player and NPCs (once per update, before any AI reads them)
+void PublishWorldFacts(const GameObject *player, NPC *const *npcs, int npcCount);
+
+// Get the facts published this update
+const WorldFacts *GetWorldFacts();
+
+// Find a spot next to the player to attack it from, out of its attack arc, off the spots other NPCs hold
+// and near the side it is approached from
+Vector2 FindFlankingPosition(const WorldFacts *facts, Vector2 approach);
+
+// Find a spot within NPC_RETREAT_RANGE of a position with little threat and more NPCs around
+Vector2 FindRetreatPosition(const WorldFacts *facts, Vector2 from);
+
+#endif // PERCEPTION_H
@@ -0,0 +1,39 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+// Systems that draw random numbers, each gets its own streams
+typedef enum
+{
+    RANDOM_SYSTEM_AI,        // NPC decisions
+    RANDOM_SYSTEM_ANIMATION, // Animation choices (e.g., the idle variant)
+    RANDOM_SYSTEM_COUNT
+} RandomSystem;
+
+// An independent sequence of random numbers, owned by one entity and system
+typedef struct
+{
+    uint64_t key;     // Derived from the world seed, the system and the entity
+    uint64_t counter; // Numbers drawn so far
+} RandomStream;
+
+// Set the seed every stream is derived from (before any stream is initialised)
+void SetWorldSeed(uint64_t seed);
+
+// Get the world seed (log it to replay a run)
+uint64_t GetWorldSeed();
+
+// Initialise an entity's stream for a system, the same seed, system and entity always give the same numbers
+void InitRandomStream(RandomStream *stream, RandomSystem system, int entityId);
+
+// Draw a random 32-bit number
+uint32_t NextRandom(RandomStream *stream);
+
+// Draw a random integer in [0, bound)
+int NextRandomInt(RandomStream *stream, int bound);
+
+// Draw a random float in [0, 1)
+float NextRandomFloat(RandomStream *stream);
+
+#endif // RANDOM_H
@@ -0,0 +1,45 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdbool.h>
+
+#include "../gameobjects/gameobject.h"
+
+// Initialise the update scheduler (empty update set)
+void InitScheduler();
+
+// Add a game object to the update set
+void ScheduleGameObject(GameObject *obj);
+
+// Remove a game object from the update set (awake or asleep)
+void UnscheduleGameObject(GameObject *obj);
+
+// Set the object whose position triggers proximity wake-ups (normally the player)
+void SetSchedulerFocus(GameObject *focus);
+
+// Check if a game object is within radius of the scheduler focus
+bool IsNearSchedulerFocus(const GameObject *obj, float radius);
+
+// Put a game object to sleep until an event, a timer (wakeAfterSeconds > 0) or
+// the focus coming within wakeRadius (wakeRadius > 0) wakes it
+void SleepGameObject(GameObject *obj, float wakeAfterSeconds, float wakeRadius);
+
+// Wake a sleeping game object, catching up the work it skipped while asleep
+void WakeGameObject(GameObject *obj);
+
+// Seconds the game object has been asleep (0 if awake)
+float GetSleepDuration(const GameObject *obj);
+
+// Wake objects near the focus, then update every awake object
+void UpdateScheduledObjects();
+
+// Number of objects updated each tick
+int GetAwakeObjectCount();
+
+// Number of objects currently asleep
+int GetSleepingObjectCount();
+
+// Release the scheduler storage
+void ExitScheduler();
+
+#endif // SCHEDULER_H
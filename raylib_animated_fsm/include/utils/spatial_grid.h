@@ -0,0 +1,51 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <raylib.h>
+
+// Forward declaration of the GameObject structure
+typedef struct GameObject GameObject;
+
+// An object stored in the grid, linked into the bucket of its cell
+typedef struct
+{
+    GameObject *obj;  // The stored game object (NULL if the entry is free)
+    Vector2 position; // Position the object was inserted at
+    int cellX;        // Cell column of the position
+    int cellY;        // Cell row of the position
+    int bucket;       // Hash bucket holding the entry
+    int next;         // Next entry in the bucket (or free list)
+    int prev;         // Previous entry in the bucket
+} SpatialEntry;
+
+// Uniform grid stored as a spatial hash, so the world does not need fixed bounds
+typedef struct SpatialGrid
+{
+    float cellSize;        // Width and height of one grid cell
+    int bucketCount;       // Number of hash buckets (power of two)
+    int *buckets;          // Head entry for each bucket (-1 if empty)
+    SpatialEntry *entries; // Entry pool
+    int capacity;          // Size of the entry pool
+    int count;             // Entries currently in the grid
+    int freeEntry;         // Head of the free entry list
+} SpatialGrid;
+
+// Create a spatial grid with the given cell size and bucket count (rounded up to a power of two)
+SpatialGrid *CreateSpatialGrid(float cellSize, int bucketCount);
+
+// Insert an object at a position, returns the entry index used to remove it
+int SpatialGridInsert(SpatialGrid *grid, GameObject *obj, Vector2 position);
+
+// Remove an entry previously returned by SpatialGridInsert
+void SpatialGridRemove(SpatialGrid *grid, int entry);
+
+// Remove every entry (keeps the allocated storage)
+void SpatialGridClear(SpatialGrid *grid);
+
+// Collect the objects within radius of center, returns the number written to results
+int SpatialGridQuery(const SpatialGrid *grid, Vector2 center, float radius, GameObject **results, int maxResults);
+
+// Free the grid and its storage
+void DeleteSpatialGrid(SpatialGrid *grid);
+
+#endif // SPATIAL_GRID_H
@@ -0,0 +1,52 @@
+#ifndef SQUAD_H
+#define SQUAD_H
+
+#include <stdbool.h>
+
+#include "../gameobjects/gameobject.h"
+
+// Squad of an object that decides alone
+#define SQUAD_NONE -1
+
+// Most members in a squad
+#define MAX_SQUAD_MEMBERS 8
+
+// What a squad's members do until its next decision
+typedef enum
+{
+    SQUAD_ORDER_NONE,    // Nothing to act on together, each member decides alone
+    SQUAD_ORDER_ENGAGE,  // Close in on the player in formation and attack it
+    SQUAD_ORDER_RETREAT, // Fall back together to a safer spot
+} SquadOrder;
+
+// A squad's decision, fanned out to its members
+typedef struct
+{
+    SquadOrder order;
+    Vector2 rally;                    // Where the formation is centred (a flanking or retreat spot)
+    Vector2 slots[MAX_SQUAD_MEMBERS]; // Where each member stands in the formation, by member index
+} SquadPlan;
+
+// Initialise the squads (none until CreateSquad)
+void InitSquads();
+
+// Create an empty squad (returns its index, squads last until ExitSquads so replacements can rejoin)
+int CreateSquad();
+
+// Add an object to a squad (ignored if the squad is full or the object is already in a squad)
+void JoinSquad(GameObject *obj, int squad);
+
+// Remove an object from its squad (ignored if it is not in one)
+void LeaveSquad(GameObject *obj);
+
+// Make the decisions of the squads that are due (once per update, after the world facts are published)
+void UpdateSquads(float dt);
+
+// Get the order of an object's squad and the object's slot in the formation (returns false if it
+// decides alone, safe to call from any thread while the AI runs)
+bool GetSquadOrder(const GameObject *obj, SquadOrder *order, Vector2 *slot);
+
+// Release the squads
+void ExitSquads();
+
+#endif // SQUAD_H
@@ -0,0 +1,47 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdbool.h>
+
+#include "../fsm/fsm.h"
+
+// Handle to a scheduled timer, the generation guards against reusing stale handles
+typedef struct
+{
+    int index;               // Slot in the timer pool (-1 if no timer)
+    unsigned int generation; // Generation of the pool slot when the timer was scheduled
+} TimerHandle;
+
+// Handle value used for "no timer scheduled"
+#define TIMER_HANDLE_NONE ((TimerHandle){-1, 0})
+
+// Initialise the timer wheel service (empty wheel, tick 0)
+void InitTimerWheel();
+
+// Schedule an event to be delivered to a game object after a number of ticks.
+// If callback is NULL the event is delivered through HandleEvent, if obj is also
+// NULL the timer is a bare timer that only reports through IsTimerPending.
+TimerHandle ScheduleTimer(GameObject *obj, Event event, unsigned int delayTicks, EventFunction callback);
+
+// Schedule a timer using a delay in seconds (converted using TIMER_TICKS_PER_SECOND)
+TimerHandle ScheduleTimerSeconds(GameObject *obj, Event event, float seconds, EventFunction callback);
+
+// Cancel a pending timer and reset the handle, returns true if a timer was cancelled
+bool CancelTimer(TimerHandle *handle);
+
+// Check if a timer is still waiting to fire
+bool IsTimerPending(TimerHandle handle);
+
+// Cancel every pending timer targeting the given game object
+void CancelTimersForGameObject(GameObject *obj);
+
+// Advance the wheel by the whole ticks in dt seconds (the rest carries over), firing any timers that expire
+void AdvanceTimerWheel(float dt);
+
+// Current tick of the timer wheel
+unsigned int GetTimerTick();
+
+// Release the timer pool
+void ExitTimerWheel();
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,57 @@
+#ifndef UTILITY_AI_H
+#define UTILITY_AI_H
+
+#include "../command/command.h"
+
+// What a decision considers, each normalised to [0, 1]
+typedef enum
+{
+    AI_INPUT_PROXIMITY,     // 1 next to the target, 0 at AI_SENSE_RANGE or further
+    AI_INPUT_HEALTH,        // Own health
+    AI_INPUT_AGGRESSION,    // Own aggression
+    AI_INPUT_TARGET_THREAT, // 1 while the target is attacking
+    AI_INPUT_COUNT
+} AIInput;
+
+// What a decision can pick
+typedef enum
+{
+    AI_ACTION_NONE,
+    AI_ACTION_ATTACK,
+    AI_ACTION_SHIELD,
+    AI_ACTION_COUNT
+} AIAction;
+
+// Quadratic response curve a * x * x + b * x + c, clamped to [0, 1]
+typedef struct
+{
+    float a;
+    float b;
+    float c;
+} AICurve;
+
+// Agents scored together in one pass (keeps a chunk's scores in registers and L1)
+#define UTILITY_AI_CHUNK 64
+
+// Decisions of many agents, one array per input so each curve runs over them in one loop
+typedef struct
+{
+    float *inputs[AI_INPUT_COUNT];
+    float *noise[AI_ACTION_COUNT]; // Tie breaking jitter in [0, 1), scaled by UTILITY_AI_NOISE
+    Command *commands;             // Best action of each agent
+    int capacity;
+} UtilityBatch;
+
+// Most a score is jittered by, so agents with the same inputs do not act in lockstep
+#define UTILITY_AI_NOISE 0.05f
+
+// Make room for count agents in a batch
+void ReserveUtilityBatch(UtilityBatch *batch, int count);
+
+// Score the actions of the agents in [first, last) and write each one's best as a command
+void ScoreUtilityBatch(UtilityBatch *batch, int first, int last);
+
+// Release a batch's storage
+void ReleaseUtilityBatch(UtilityBatch *batch);
+
+#endif // UTILITY_AI_H
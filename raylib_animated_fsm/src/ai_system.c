@@ -0,0 +1,448 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <raylib.h>
+
+#include "../include/utils/ai_system.h"
+#include "../include/utils/constants.h"
+#include "../include/utils/job_pool.h"
+#include "../include/utils/perception.h"
+#include "../include/utils/squad.h"
+#include "../include/utils/utility_ai.h"
+
+// Agents sorted by entity id, so decisions are applied in the same order whichever thread made them
+static AIAgent *agents = NULL;
+static int agentCount = 0;
+static int agentCapacity = 0;
+
+// Agents whose decision is due this update, most pressing first
+static int *due = NULL;
+static int dueCount = 0;
+static float *duePriority = NULL;
+
+// Due agents following an order of their squad, decided without being scored
+static int *following = NULL;
+static int followingCount = 0;
+
+// Milliseconds of deciding per update (0 for no limit) and what the last update did
+static float thinkBudget = AI_THINK_BUDGET_MS;
+static AIThinkReport report = {0};
+
+// Inputs and decisions of the due agents, indexed like due
+static UtilityBatch batch = {0};
+
+// Event each command is handled as, EVENT_COUNT for commands the NPCs ignore
+static const Event commandEvents[] = {
+    [COMMAND_MOVE_UP] = EVENT_MOVE_UP,
+    [COMMAND_MOVE_UP_RIGHT] = EVENT_COUNT,
+    [COMMAND_MOVE_UP_LEFT] = EVENT_COUNT,
+    [COMMAND_MOVE_DOWN] = EVENT_MOVE_DOWN,
+    [COMMAND_MOVE_DOWN_LEFT] = EVENT_COUNT,
+    [COMMAND_MOVE_DOWN_RIGHT] = EVENT_COUNT,
+    [COMMAND_MOVE_LEFT] = EVENT_MOVE_LEFT,
+    [COMMAND_MOVE_RIGHT] = EVENT_MOVE_RIGHT,
+    [COMMAND_ATTACK] = EVENT_ATTACK,
+    [COMMAND_COLLISION_START] = EVENT_DIE,
+    [COMMAND_COLLISION_END] = EVENT_RESPAWN,
+    [COMMAND_NONE] = EVENT_NONE,
+    [COMMAND_SHIELD] = EVENT_DEFEND,
+    [COMMAND_CHASE] = EVENT_MOVE,
+};
+
+/**
+ * InitAISystem - Initialises the AI system.
+ *
+ * Every NPC is an agent with its own decision interval. Each update the due
+ * agents' decisions are made in parallel on the job pool, each written to the
+ * agent's own command slot, then handled on the simulation thread in entity id
+ * order, so AI cost spreads over the cores and the outcome does not depend on
+ * how the work was split. A decision scores every action with the utility
+ * curves (see utility_ai.h), then ticks the agent's behaviour tree, whose
+ * BT_SUGGESTED leaves fall back on the best scoring action.
+ */
+void InitAISystem()
+{
+    agentCount = 0;
+    dueCount = 0;
+    report = (AIThinkReport){0};
+}
+
+// Distance from a position to the player, INFINITY without a player
+static float GetPlayerDistance(const WorldFacts *facts, Vector2 position)
+{
+    return facts->playerPresent ? Vector2Distance(position, facts->playerPosition) : INFINITY;
+}
+
+// Finds the position of the first agent with an id not below id
+static int FindAgentPosition(int id)
+{
+    int low = 0;
+    int high = agentCount;
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+        if (agents[middle].obj->id < id)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+/**
+ * AddAIAgent - Gives an object decisions.
+ *
+ * @obj:        The object (an NPC).
+ * @tree:       The tree of the object's archetype (NULL to act on the utility scores alone).
+ * @interval:   Seconds between decisions, the first one is interval seconds from now.
+ * @aggression: How aggressive the object is, in [0, 100].
+ */
+void AddAIAgent(GameObject *obj, const BehaviourTree *tree, float interval, int aggression)
+{
+    if (agentCount == agentCapacity)
+    {
+        int newCapacity = agentCapacity ? agentCapacity * 2 : 64;
+        AIAgent *grown = (AIAgent *)realloc(agents, sizeof(AIAgent) * newCapacity);
+        int *grownDue = (int *)realloc(due, sizeof(int) * newCapacity);
+        float *grownPriority = (float *)realloc(duePriority, sizeof(float) * newCapacity);
+        int *grownFollowing = (int *)realloc(following, sizeof(int) * newCapacity);
+        if (!grown || !grownDue || !grownPriority || !grownFollowing)
+        {
+            fprintf(stderr, "Failed to allocate AI agents\n");
+            exit(1);
+        }
+        agents = grown;
+        due = grownDue;
+        duePriority = grownPriority;
+        following = grownFollowing;
+        agentCapacity = newCapacity;
+    }
+
+    // New objects have the highest id, so this is almost always the end
+    int position = FindAgentPosition(obj->id);
+    for (int i = agentCount; i > position; i--)
+    {
+        agents[i] = agents[i - 1];
+    }
+
+    float weight = Clamp(aggression / 100.0f, 0.0f, 1.0f);
+    agents[position] = (AIAgent){.obj = obj,
+                                 .tree = tree,
+                                 .interval = interval,
+                                 .untilThink = interval,
+                                 .aggression = weight,
+                                 .command = COMMAND_NONE};
+    InitBTBlackboard(&agents[position].blackboard);
+    InitRandomStream(&agents[position].random, RANDOM_SYSTEM_AI, obj->id);
+    agentCount++;
+}
+
+/**
+ * RemoveAIAgent - Stops an object's decisions.
+ *
+ * @obj: The object, called before it is deleted (ignored if it has no agent).
+ */
+void RemoveAIAgent(GameObject *obj)
+{
+    int position = FindAgentPosition(obj->id);
+    if (position == agentCount || agents[position].obj != obj)
+    {
+        return;
+    }
+
+    agentCount--;
+    for (int i = position; i < agentCount; i++)
+    {
+        agents[i] = agents[i + 1];
+    }
+}
+
+// Counts the NPCs attacking the player besides the given one
+static int CountOtherAttackers(const WorldFacts *facts, const GameObject *obj, float distance)
+{
+    bool attacking = obj->currentState == STATE_ATTACKING && distance <= NPC_ATTACK_RANGE;
+    return facts->attackersInRange - (attacking ? 1 : 0);
+}
+
+// Picks the spot an agent near the player moves to from the influence maps, a
+// flanking spot next to the player or, when hurt, somewhere safer nearby
+static void PickTacticalGoal(AIAgent *agent, const WorldFacts *facts, float distance)
+{
+    const GameObject *obj = agent->obj;
+
+    agent->hasGoal = facts->influence && distance < AI_TACTICS_RANGE;
+    if (!agent->hasGoal)
+    {
+        return;
+    }
+
+    if (obj->health < NPC_RETREAT_HEALTH)
+    {
+        agent->goal = FindRetreatPosition(facts, obj->position);
+    }
+    else
+    {
+        // Each agent approaches from its own side, turned from its bearing to the player by an
+        // angle spread over the agents by id, so agents deciding together pick different spots
+        float turn = (fmodf(obj->id * 0.618034f, 1.0f) - 0.5f) * NPC_FLANK_SPREAD;
+        Vector2 approach = Vector2Add(facts->playerPosition,
+                                      Vector2Rotate(Vector2Subtract(obj->position, facts->playerPosition), turn));
+        agent->goal = FindFlankingPosition(facts, approach);
+    }
+}
+
+// Refines the order of the agent's squad into the agent's own decision: attack once
+// in reach (unless enough others already are), otherwise head for its formation
+// slot, along the flow field while the player is still far. A few comparisons in
+// place of the inputs, scores and tree a lone agent goes through.
+static void FollowSquadOrder(AIAgent *agent, const WorldFacts *facts, SquadOrder order, Vector2 slot)
+{
+    float distance = GetPlayerDistance(facts, agent->obj->position);
+    bool attack = order == SQUAD_ORDER_ENGAGE && distance < NPC_ATTACK_RANGE &&
+                  CountOtherAttackers(facts, agent->obj, distance) < NPC_MAX_ATTACKERS;
+
+    agent->command = attack ? COMMAND_ATTACK : COMMAND_CHASE;
+    agent->hasGoal = order == SQUAD_ORDER_RETREAT || distance < AI_TACTICS_RANGE;
+    agent->goal = slot;
+    agent->decided = true;
+
+    // The squad overrides the tree, it starts afresh once the agent decides alone again
+    agent->blackboard.running = BT_NODE_NONE;
+}
+
+// Makes the decisions of a range of due agents (on any thread, only writes their
+// batch slots, blackboards, random streams, command slots and goals), the range is
+// relative to the slice starting at the due position in context
+static void EvaluateAgents(void *context, int first, int last)
+{
+    const int slice = *(const int *)context;
+    first += slice;
+    last += slice;
+
+    // The player is the target of every decision
+    const WorldFacts *facts = GetWorldFacts();
+    const float threat = facts->playerAttacking ? 1.0f : 0.0f;
+
+    // Gather each input into its own array, normalised to [0, 1]
+    for (int i = first; i < last; i++)
+    {
+        AIAgent *agent = &agents[due[i]];
+        const GameObject *obj = agent->obj;
+
+        float distance = GetPlayerDistance(facts, obj->position);
+        batch.inputs[AI_INPUT_PROXIMITY][i] = 1.0f - fminf(distance / AI_SENSE_RANGE, 1.0f);
+        batch.inputs[AI_INPUT_HEALTH][i] = Clamp(obj->health / 100.0f, 0.0f, 1.0f);
+        batch.inputs[AI_INPUT_AGGRESSION][i] = agent->aggression;
+        batch.inputs[AI_INPUT_TARGET_THREAT][i] = threat;
+
+        for (int action = 0; action < AI_ACTION_COUNT; action++)
+        {
+            batch.noise[action][i] = NextRandomFloat(&agent->random);
+        }
+
+        float *values = agent->blackboard.values;
+        values[BT_KEY_TARGET_DISTANCE] = distance;
+        values[BT_KEY_HEALTH] = (float)obj->health;
+        values[BT_KEY_AGGRESSION] = agent->aggression * 100.0f;
+        values[BT_KEY_TARGET_THREAT] = threat;
+
+        values[BT_KEY_ALLIES_ATTACKING] = (float)CountOtherAttackers(facts, obj, distance);
+    }
+
+    ScoreUtilityBatch(&batch, first, last);
+
+    // The tree has the final say, the utility scores are its suggestion
+    for (int i = first; i < last; i++)
+    {
+        AIAgent *agent = &agents[due[i]];
+        PickTacticalGoal(agent, facts, agent->blackboard.values[BT_KEY_TARGET_DISTANCE]);
+        if (agent->tree)
+        {
+            // A deferred agent's running action has been running for longer than its interval
+            float elapsed = agent->interval - agent->untilThink;
+            agent->decided = TickBehaviourTree(agent->tree, &agent->blackboard, elapsed,
+                                               batch.commands[i], &agent->command);
+        }
+        else
+        {
+            agent->command = batch.commands[i];
+            agent->decided = true;
+        }
+    }
+}
+
+// Handles an agent's decision (simulation thread)
+static void ApplyDecision(const AIAgent *agent)
+{
+    GameObject *obj = agent->obj;
+
+    if (!agent->decided)
+    {
+        return;
+    }
+
+    // The crowd steers the object to its spot, if it picked one, while it walks
+    obj->hasMoveGoal = agent->hasGoal;
+    obj->moveGoal = agent->goal;
+
+#ifdef DEBUG
+    printf("\n#######################################\n");
+    printf("\t%s Handle AI Events", obj->name);
+    printf("\n#######################################\n");
+#endif
+
+    Event event = commandEvents[agent->command];
+    if (event != EVENT_COUNT)
+    {
+        HandleEvent(obj, event);
+    }
+}
+
+// Orders due agents by priority, most pressing first (entity id order on ties)
+static int CompareDueAgents(const void *lhs, const void *rhs)
+{
+    int a = *(const int *)lhs;
+    int b = *(const int *)rhs;
+    if (duePriority[a] != duePriority[b])
+        return duePriority[a] > duePriority[b] ? -1 : 1;
+    return a - b;
+}
+
+// Orders agents by entity id
+static int CompareAgentIndices(const void *lhs, const void *rhs)
+{
+    return *(const int *)lhs - *(const int *)rhs;
+}
+
+/**
+ * UpdateAISystem - Makes and applies the decisions due this update.
+ *
+ * @dt: Seconds since the last update.
+ *
+ * Due agents decide most pressing first: the longer past due (in intervals)
+ * and the closer to the target, the sooner. They decide a slice at a time on
+ * the job pool until the think budget is spent, the rest stay due and are
+ * more pressing next update, so agents far from the target still get their
+ * turn and a burst of due agents is spread over several updates instead of
+ * spiking one. At least one slice decides every update. Members of a squad
+ * with an order only refine it, on this thread, outside the slices. Handling a decision
+ * changes the game (state changes, events, deferred commands) and stays on
+ * this thread, in entity id order.
+ */
+void UpdateAISystem(float dt)
+{
+    const WorldFacts *facts = GetWorldFacts();
+
+    dueCount = 0;
+    followingCount = 0;
+    for (int i = 0; i < agentCount; i++)
+    {
+        AIAgent *agent = &agents[i];
+        agent->untilThink -= dt;
+        if (agent->untilThink <= 0.0f)
+        {
+            // Squad members with an order only refine it, cheaply enough to skip the batch and the budget
+            SquadOrder order;
+            Vector2 slot;
+            if (GetSquadOrder(agent->obj, &order, &slot))
+            {
+                FollowSquadOrder(agent, facts, order, slot);
+                following[followingCount++] = i;
+                continue;
+            }
+
+            float overdue = -agent->untilThink / agent->interval;
+            float proximity = 1.0f - fminf(GetPlayerDistance(facts, agent->obj->position) / AI_SENSE_RANGE, 1.0f);
+            duePriority[i] = overdue + proximity * AI_PRIORITY_PROXIMITY_WEIGHT;
+            due[dueCount++] = i;
+        }
+    }
+    qsort(due, dueCount, sizeof(int), CompareDueAgents);
+    ReserveUtilityBatch(&batch, dueCount);
+
+    // Decide a slice at a time until the budget is spent
+    const int sliceSize = AI_AGENTS_PER_BATCH * (GetJobPoolWorkers() + 1);
+    const double start = GetTime();
+    int thought = 0;
+    while (thought < dueCount)
+    {
+        int count = (dueCount - thought < sliceSize) ? dueCount - thought : sliceSize;
+        RunParallelJob(EvaluateAgents, &thought, count, AI_AGENTS_PER_BATCH);
+        thought += count;
+
+        if (thinkBudget > 0.0f && (GetTime() - start) * 1000.0 >= thinkBudget)
+            break;
+    }
+
+    report.due = dueCount + followingCount;
+    report.thought = thought + followingCount;
+    report.deferred = dueCount - thought;
+    report.milliseconds = (float)((GetTime() - start) * 1000.0);
+    report.longestWait = 0.0f;
+    for (int i = thought; i < dueCount; i++)
+    {
+        report.longestWait = fmaxf(report.longestWait, -agents[due[i]].untilThink);
+    }
+
+    // The squad followers join the agents that decided, all applied in entity id order
+    // (due has room, no agent is in both)
+    memcpy(&due[thought], following, sizeof(int) * followingCount);
+    thought += followingCount;
+
+    qsort(due, thought, sizeof(int), CompareAgentIndices);
+    for (int i = 0; i < thought; i++)
+    {
+        AIAgent *agent = &agents[due[i]];
+
+        // One decision per update, however long the agent waited
+        agent->untilThink += agent->interval;
+        if (agent->untilThink <= 0.0f)
+            agent->untilThink = agent->interval;
+
+        ApplyDecision(agent);
+    }
+}
+
+/**
+ * SetAIThinkBudget - Sets how long deciding may take per update.
+ *
+ * @milliseconds: The budget, 0 for no limit (every due agent decides every
+ *                update, so runs with a fixed world seed replay exactly).
+ */
+void SetAIThinkBudget(float milliseconds)
+{
+    thinkBudget = milliseconds;
+}
+
+// What the last update decided and deferred
+AIThinkReport GetAIThinkReport()
+{
+    return report;
+}
+
+// Number of objects with decisions
+int GetAIAgentCount()
+{
+    return agentCount;
+}
+
+/**
+ * ExitAISystem - Releases the AI system storage.
+ */
+void ExitAISystem()
+{
+    free(agents);
+    free(due);
+    free(duePriority);
+    free(following);
+    ReleaseUtilityBatch(&batch);
+    agents = NULL;
+    due = NULL;
+    duePriority = NULL;
+    following = NULL;
+    agentCount = 0;
+    agentCapacity = 0;
+    dueCount = 0;
+    followingCount = 0;
+}
@@ -1,5 +1,6 @@
 #include <stdlib.h>
 #include "../include/animation/animation.h"
+#include "../include/render/sprite_batch.h"
 
 /**
  * InitAnimation - Initialises an animation with the given parameters.
@@ -9,89 +10,71 @@
  * @texture:       The Texture2D object containing the sprite sheet or animation
  *                 frames to be used for rendering.
  * @frames:        An array of Rectangle objects representing each animation frame
- *                 on the texture.
+ *                 on the texture (the clip's table, which must outlive the animation).
  * @frameCount:    The total number of frames in the animation.
  * @frameDuration: The duration each frame should be displayed, in seconds.
  * @loop:          A boolean indicating whether the animation should loop
  *                 back to the first frame after the last frame.
  *
- * This function allocates memory for the frames array in animationData and copies
- * each frame from the provided frames array. It also sets initial values for other
- * animation properties, such as frame count, duration, loop setting, and starting
- * with the animation active and set to the first frame.
+ * The animation keeps its clip (texture and frames) while the playback state lives
+ * in a cursor in the animation system, which UpdateAnimationSystem advances once
+ * per tick. The animation's cursor is reused if it already has one (cursor must be
+ * ANIMATION_CURSOR_NONE for a new animation), so switching clips allocates nothing.
  */
 void InitAnimation(AnimationData *animationData,
                    Texture2D texture,
-                   Rectangle *frames,
+                   const Rectangle *frames,
                    int frameCount,
                    float frameDuration,
                    bool loop)
 {
-    // Store texture and allocate memory for frame data in animationData
+    // Store texture and the clip's frames
     animationData->texture = texture;
-    animationData->frames = (Rectangle *)malloc(frameCount * sizeof(Rectangle));
-
-    // Copy each frame from frames array to animationData's frames
-    if (animationData->frames != NULL)
-    {
-        for (int i = 0; i < frameCount; i++)
-        {
-            animationData->frames[i] = frames[i];
-        }
-    }
+    animationData->frames = frames;
 
     // Initialise animation properties
     animationData->frameCount = frameCount;
     animationData->frameDuration = frameDuration;
-    animationData->loop = loop;
-    animationData->currentFrame = 0;  // Start at the first frame
-    animationData->frameTimer = 0.0f; // Reset frame timer to zero
-    animationData->active = true;     // Set animation as active by default
+    animationData->active = true; // Set animation as active by default
+
+    // Start at the first frame
+    if (animationData->cursor == ANIMATION_CURSOR_NONE)
+    {
+        animationData->cursor = AcquireAnimationCursor();
+    }
+    StartAnimationCursor(animationData->cursor, frameCount, frameDuration, loop);
 }
 
 /**
- * UpdateAnimation - Updates the animation's current frame based on time elapsed.
+ * ReleaseAnimation - Returns the animation's playback cursor to the animation system.
  *
- * @animationData: A pointer to the AnimationData structure containing the
- *                 animation's current state and properties.
- *
- * This function increments the frame timer by the time elapsed since the last frame.
- * If the frame timer exceeds the specified frame duration, it advances to the next frame.
- * If the animation has reached the last frame, it either loops back to the start
- * (if looping is enabled) or holds on the last frame (if looping is disabled).
+ * @animationData: A pointer to the AnimationData structure to release.
  */
-void UpdateAnimation(AnimationData *animationData)
+void ReleaseAnimation(AnimationData *animationData)
 {
-    // If the animation is inactive, return immediately
-    if (!animationData->active)
-    {
-        return;
-    }
-
-    // Update frame timer with delta time (time elapsed since last frame)
-    animationData->frameTimer += GetFrameTime();
-
-    // Check if it's time to advance to the next frame
-    if (animationData->frameTimer >= animationData->frameDuration)
-    {
-        animationData->currentFrame++; // Move to the next frame
+    ReleaseAnimationCursor(animationData->cursor);
+    animationData->cursor = ANIMATION_CURSOR_NONE;
+    animationData->active = false;
+}
 
-        // Check if the end of the animation frames is reached
-        if (animationData->currentFrame >= animationData->frameCount)
-        {
-            if (animationData->loop)
-            {
-                animationData->currentFrame = 0; // Restart at first frame if looping
-            }
-            else
-            {
-                animationData->currentFrame = animationData->frameCount - 1; // Stay on last frame if not looping
-            }
-        }
+// Current frame index (advanced by UpdateAnimationSystem)
+int GetAnimationFrame(const AnimationData *animationData)
+{
+    int frame = GetAnimationCursorFrame(animationData->cursor);
+    return (frame < animationData->frameCount) ? frame : animationData->frameCount - 1;
+}
 
-        // Reset the frame timer after advancing frames
-        animationData->frameTimer = 0.0f;
-    }
+/**
+ * GetAnimationDuration - Returns how long one pass through the animation takes.
+ *
+ * @animationData: A constant pointer to the AnimationData structure.
+ *
+ * Used to schedule timers for the end of an animation (e.g., death), instead of
+ * polling the current frame every update.
+ */
+float GetAnimationDuration(const AnimationData *animationData)
+{
+    return animationData->frameCount * animationData->frameDuration;
 }
 
 /**
@@ -99,24 +82,23 @@ void UpdateAnimation(AnimationData *animationData)
  *
  * @animationData: A constant pointer to the AnimationData structure, which holds
  *                 all the information needed to display the animation.
- * @position:      A Vector2 specifying the x and y screen coordinates where the
+ * @position:      A Vector2 specifying the x and y world coordinates where the
  *                 animation should be drawn.
  * @tint:          A Color value to apply as a tint over the animation's texture.
  *
- * This function retrieves the current frame based on the currentFrame index in
- * animationData, adjusts the drawing position to center the texture, and renders
- * the frame at the specified position with the given tint.
+ * This function retrieves the current frame from the animation's playback cursor, adjusts the drawing position to center the texture, and submits
+ * the frame to the sprite batch (drawn immediately if no batch is recording).
  */
 void RenderAnimation(const AnimationData *animationData, Vector2 position, Color tint)
 {
     // If the animation is inactive, don't render it
-    if (!animationData->active)
+    if (!animationData->active || animationData->frameCount <= 0)
     {
         return;
     }
 
     // Retrieve the rectangle for the current frame
-    Rectangle frame = animationData->frames[animationData->currentFrame];
+    Rectangle frame = animationData->frames[GetAnimationFrame(animationData)];
 
     // Adjust the drawing position so the animation is centered at the specified point
     Vector2 adjustedPosition = {
@@ -125,9 +107,11 @@ void RenderAnimation(const AnimationData *animationData, Vector2 position, Color
     };
 
     // Render the current frame with the given tint color
-    DrawTextureRec(
+    SubmitSprite(
         animationData->texture,
         frame,
         adjustedPosition,
-        tint);
+        tint,
+        SPRITE_LAYER_ACTORS,
+        position.y); // Sorted by the y the object stands on, so lower objects overlap higher ones
 }
@@ -0,0 +1,262 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../include/animation/animation_system.h"
+
+// Playback cursors of every animation
+static AnimationCursors cursors = {0};
+
+// Released cursors, reused before the arrays grow
+static int *freeCursors = NULL;
+static int freeCount = 0;
+
+// Ticks since InitAnimationSystem, spreads reduced cursors over the interval
+static unsigned int tick = 0;
+
+// Grows one of the cursor arrays
+static float *GrowCursorArray(float *array, int capacity)
+{
+    float *grown = (float *)realloc(array, sizeof(float) * capacity);
+    if (!grown)
+    {
+        fprintf(stderr, "Failed to allocate animation cursors\n");
+        exit(1);
+    }
+    return grown;
+}
+
+/**
+ * InitAnimationSystem - Initialises the animation system.
+ *
+ * The playback state of every animation (frame timer, frame, clip length and
+ * duration) lives here in contiguous arrays rather than in each object, so all
+ * of it advances in one pass per tick instead of from each state's Update.
+ */
+void InitAnimationSystem()
+{
+    cursors.count = 0;
+    freeCount = 0;
+    tick = 0;
+}
+
+/**
+ * AcquireAnimationCursor - Gets a playback cursor.
+ *
+ * Return: The cursor, stopped on frame 0 until StartAnimationCursor is called.
+ */
+int AcquireAnimationCursor()
+{
+    int cursor;
+
+    if (freeCount > 0)
+    {
+        cursor = freeCursors[--freeCount];
+    }
+    else
+    {
+        if (cursors.count == cursors.capacity)
+        {
+            int newCapacity = cursors.capacity ? cursors.capacity * 2 : 64;
+            cursors.frameTimer = GrowCursorArray(cursors.frameTimer, newCapacity);
+            cursors.frameDuration = GrowCursorArray(cursors.frameDuration, newCapacity);
+            cursors.frame = GrowCursorArray(cursors.frame, newCapacity);
+            cursors.frameCount = GrowCursorArray(cursors.frameCount, newCapacity);
+            cursors.loop = GrowCursorArray(cursors.loop, newCapacity);
+            cursors.rate = GrowCursorArray(cursors.rate, newCapacity);
+            cursors.pending = GrowCursorArray(cursors.pending, newCapacity);
+
+            // A free cursor is never more than its own length
+            int *grownFree = (int *)realloc(freeCursors, sizeof(int) * newCapacity);
+            unsigned char *grownLod = (unsigned char *)realloc(cursors.lod, newCapacity);
+            if (!grownFree || !grownLod)
+            {
+                fprintf(stderr, "Failed to allocate animation cursors\n");
+                exit(1);
+            }
+            freeCursors = grownFree;
+            cursors.lod = grownLod;
+            cursors.capacity = newCapacity;
+        }
+        cursor = cursors.count++;
+    }
+
+    // Stopped on a one frame clip, safe to update before it is started
+    cursors.frameTimer[cursor] = 0.0f;
+    cursors.frameDuration[cursor] = 1.0f;
+    cursors.frame[cursor] = 0.0f;
+    cursors.frameCount[cursor] = 1.0f;
+    cursors.loop[cursor] = 1.0f;
+    cursors.rate[cursor] = 0.0f;
+    cursors.pending[cursor] = 0.0f;
+    cursors.lod[cursor] = ANIMATION_LOD_FULL;
+
+    return cursor;
+}
+
+/**
+ * ReleaseAnimationCursor - Returns a playback cursor to the system.
+ *
+ * @cursor: The cursor to release (ignored if ANIMATION_CURSOR_NONE).
+ */
+void ReleaseAnimationCursor(int cursor)
+{
+    if (cursor < 0 || cursor >= cursors.count)
+    {
+        return;
+    }
+
+    cursors.rate[cursor] = 0.0f;
+    freeCursors[freeCount++] = cursor;
+}
+
+// Turns a cursor's pending time into frames, a cursor advanced late or rarely
+// lands on the same frame as one advanced every tick
+static void AdvanceCursor(int i)
+{
+    // Whole frames elapsed, the remainder stays in the timer
+    float timer = cursors.frameTimer[i] + cursors.pending[i];
+    float steps = floorf(timer / cursors.frameDuration[i]);
+    cursors.frameTimer[i] = timer - steps * cursors.frameDuration[i];
+    cursors.pending[i] = 0.0f;
+
+    // Looping clips wrap around, the others hold on their last frame
+    float next = cursors.frame[i] + steps;
+    float wrapped = next - floorf(next / cursors.frameCount[i]) * cursors.frameCount[i];
+    float held = fminf(next, cursors.frameCount[i] - 1.0f);
+    cursors.frame[i] = cursors.loop[i] * wrapped + (1.0f - cursors.loop[i]) * held;
+}
+
+/**
+ * StartAnimationCursor - Restarts a cursor at the first frame of a clip.
+ *
+ * @cursor:        The cursor to start.
+ * @frameCount:    The number of frames in the clip.
+ * @frameDuration: The duration of each frame, in seconds.
+ * @loop:          Whether the clip loops or holds on its last frame.
+ */
+void StartAnimationCursor(int cursor, int frameCount, float frameDuration, bool loop)
+{
+    if (cursor < 0 || cursor >= cursors.count)
+    {
+        return;
+    }
+
+    // A clip without frames or duration never advances
+    bool playable = frameCount > 0 && frameDuration > 0.0f;
+
+    cursors.frameTimer[cursor] = 0.0f;
+    cursors.frameDuration[cursor] = playable ? frameDuration : 1.0f;
+    cursors.frame[cursor] = 0.0f;
+    cursors.frameCount[cursor] = playable ? (float)frameCount : 1.0f;
+    cursors.loop[cursor] = loop ? 1.0f : 0.0f;
+    cursors.rate[cursor] = playable ? 1.0f : 0.0f;
+    cursors.pending[cursor] = 0.0f;
+}
+
+// Stop or resume a cursor, a stopped cursor keeps its frame
+void SetAnimationCursorPlaying(int cursor, bool playing)
+{
+    if (cursor < 0 || cursor >= cursors.count)
+    {
+        return;
+    }
+
+    // Time elapsed while playing counts before the cursor stops
+    AdvanceCursor(cursor);
+    cursors.rate[cursor] = playing ? 1.0f : 0.0f;
+}
+
+/**
+ * SetAnimationCursorLod - Sets how often a cursor is advanced.
+ *
+ * @cursor: The cursor.
+ * @lod:    ANIMATION_LOD_FULL for objects on screen, ANIMATION_LOD_REDUCED or
+ *          ANIMATION_LOD_FROZEN for objects off screen.
+ *
+ * The LOD only changes when elapsed time is turned into frames, never how much
+ * time elapses: reading the frame of a reduced or frozen cursor catches it up
+ * first, so gameplay that depends on the frame sees the same frame at any LOD.
+ */
+void SetAnimationCursorLod(int cursor, AnimationLod lod)
+{
+    if (cursor < 0 || cursor >= cursors.count)
+    {
+        return;
+    }
+
+    cursors.lod[cursor] = (unsigned char)lod;
+}
+
+/**
+ * UpdateAnimationSystem - Advances every playing cursor.
+ *
+ * @dt: Seconds since the last update.
+ *
+ * Time reaches every playing cursor in one branch free pass (free and stopped
+ * cursors have a rate of 0), which the compiler can vectorise. Only the cursors
+ * due this tick turn it into frames: full rate cursors every tick, reduced ones
+ * every ANIMATION_LOD_REDUCED_INTERVAL ticks (spread over the interval by index),
+ * frozen ones not at all until their frame is read. With a large world most
+ * cursors are off screen, so most of the frame math is skipped.
+ */
+void UpdateAnimationSystem(float dt)
+{
+    float *restrict pending = cursors.pending;
+    const float *restrict rate = cursors.rate;
+    const unsigned char *restrict lod = cursors.lod;
+    const int count = cursors.count;
+
+    for (int i = 0; i < count; i++)
+    {
+        pending[i] += dt * rate[i];
+    }
+
+    tick++;
+    for (int i = 0; i < count; i++)
+    {
+        bool due = lod[i] == ANIMATION_LOD_FULL ||
+                   (lod[i] == ANIMATION_LOD_REDUCED &&
+                    ((tick + (unsigned int)i) & (ANIMATION_LOD_REDUCED_INTERVAL - 1)) == 0);
+        if (due && pending[i] > 0.0f)
+        {
+            AdvanceCursor(i);
+        }
+    }
+}
+
+// Get a cursor's current frame index (catching up the time it has not been advanced)
+int GetAnimationCursorFrame(int cursor)
+{
+    if (cursor < 0 || cursor >= cursors.count)
+    {
+        return 0;
+    }
+
+    if (cursors.pending[cursor] > 0.0f)
+    {
+        AdvanceCursor(cursor);
+    }
+
+    return (int)cursors.frame[cursor];
+}
+
+/**
+ * ExitAnimationSystem - Releases the animation system storage.
+ */
+void ExitAnimationSystem()
+{
+    free(cursors.frameTimer);
+    free(cursors.frameDuration);
+    free(cursors.frame);
+    free(cursors.frameCount);
+    free(cursors.loop);
+    free(cursors.rate);
+    free(cursors.pending);
+    free(cursors.lod);
+    free(freeCursors);
+
+    cursors = (AnimationCursors){0};
+    freeCursors = NULL;
+    freeCount = 0;
+}
@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../include/utils/behaviour_tree.h"
+
+// True for nodes that have children
+static bool IsComposite(BTNodeType type)
+{
+    return type == BT_SEQUENCE || type == BT_SELECTOR;
+}
+
+/**
+ * CreateBehaviourTree - Builds a tree from an outline.
+ *
+ * @defs:  The nodes in depth first order, each with its depth in the tree.
+ * @count: The number of nodes.
+ *
+ * The nodes are flattened into one array in the same order, so a node's first
+ * child is the node after it and its subtree is a contiguous range. Each node
+ * stores its parent and where its subtree ends, which is all a tick needs to
+ * move to a sibling or back up without recursion or pointers. An outline that
+ * is not a single tree of composites with leaves is a programming error.
+ *
+ * Return: A pointer to the tree.
+ */
+BehaviourTree *CreateBehaviourTree(const BTNodeDef *defs, int count)
+{
+    if (count < 1 || count > BT_MAX_NODES || defs[0].depth != 0)
+    {
+        fprintf(stderr, "Invalid behaviour tree: needs a root and at most %d nodes\n", BT_MAX_NODES);
+        exit(1);
+    }
+
+    BehaviourTree *tree = (BehaviourTree *)malloc(sizeof(BehaviourTree));
+    BTNode *nodes = (BTNode *)calloc(count, sizeof(BTNode));
+    int *ancestors = (int *)malloc(sizeof(int) * count); // Last node seen at each depth
+    if (!tree || !nodes || !ancestors)
+    {
+        fprintf(stderr, "Failed to allocate behaviour tree\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        const BTNodeDef *def = &defs[i];
+        int depth = def->depth;
+
+        bool validDepth = (i == 0) ? depth == 0 : depth >= 1 && depth <= defs[i - 1].depth + 1;
+        bool validParent = (i == 0) || depth <= defs[i - 1].depth || IsComposite(defs[i - 1].type);
+        if (!validDepth || !validParent)
+        {
+            fprintf(stderr, "Invalid behaviour tree: node %d is not the child of a sequence or selector\n", i);
+            exit(1);
+        }
+
+        ancestors[depth] = i;
+        nodes[i].type = (uint8_t)def->type;
+        nodes[i].argument = (uint8_t)def->argument;
+        nodes[i].compare = (uint8_t)def->compare;
+        nodes[i].parent = (depth == 0) ? BT_NODE_NONE : (uint16_t)ancestors[depth - 1];
+        nodes[i].value = def->value;
+
+        // The subtree ends at the next node that is not deeper
+        int next = i + 1;
+        while (next < count && defs[next].depth > depth)
+        {
+            next++;
+        }
+        nodes[i].next = (uint16_t)next;
+
+        if (IsComposite(def->type) && next == i + 1)
+        {
+            fprintf(stderr, "Invalid behaviour tree: node %d has no children\n", i);
+            exit(1);
+        }
+    }
+
+    free(ancestors);
+    tree->nodes = nodes;
+    tree->count = count;
+    return tree;
+}
+
+/**
+ * InitBTBlackboard - Prepares an agent's blackboard.
+ *
+ * @blackboard: The blackboard, the first tick starts at the root.
+ */
+void InitBTBlackboard(BTBlackboard *blackboard)
+{
+    *blackboard = (BTBlackboard){0};
+    blackboard->running = BT_NODE_NONE;
+}
+
+// Descends from a node to its first leaf and runs the leaf, leaving node on it
+static BTStatus EnterNode(const BehaviourTree *tree, int *node, BTBlackboard *blackboard,
+                          Command suggested, Command *command, bool *emitted)
+{
+    while (IsComposite((BTNodeType)tree->nodes[*node].type))
+    {
+        (*node)++;
+    }
+
+    const BTNode *leaf = &tree->nodes[*node];
+    switch ((BTNodeType)leaf->type)
+    {
+    case BT_CONDITION:
+    {
+        float value = blackboard->values[leaf->argument];
+        bool passed = (leaf->compare == BT_BELOW) ? value < leaf->value : value >= leaf->value;
+        return passed ? BT_SUCCESS : BT_FAILURE;
+    }
+    case BT_ACTION:
+        *command = (Command)leaf->argument;
+        *emitted = true;
+        blackboard->actionTime = leaf->value;
+        return leaf->value > 0.0f ? BT_RUNNING : BT_SUCCESS;
+    case BT_SUGGESTED:
+        *command = suggested;
+        *emitted = true;
+        return BT_SUCCESS;
+    case BT_SEQUENCE:
+    case BT_SELECTOR:
+        break;
+    }
+    return BT_FAILURE;
+}
+
+/**
+ * TickBehaviourTree - Ticks a tree for an agent.
+ *
+ * @tree:       The agent's tree.
+ * @blackboard: The agent's blackboard, with its values written for this tick.
+ * @dt:         Seconds since the agent's last tick.
+ * @suggested:  The command BT_SUGGESTED leaves emit.
+ * @command:    Receives the command emitted (the last one if several are).
+ *
+ * A tick that ends in a running action stops there and the next tick resumes
+ * at that node, instead of walking down from the root again. Once the action
+ * has run its time it succeeds and its status is handed up the parents: a
+ * sequence moves to its next child on success, a selector on failure, and any
+ * other status finishes the parent. Conditions above a running action are not
+ * checked again until it ends, so actions are kept short. A tick touches only
+ * the nodes it visits and the blackboard, so thousands of agents can share a
+ * tree and tick on different threads.
+ *
+ * Return: true if a command was emitted.
+ */
+bool TickBehaviourTree(const BehaviourTree *tree, BTBlackboard *blackboard, float dt,
+                       Command suggested, Command *command)
+{
+    const BTNode *nodes = tree->nodes;
+    bool emitted = false;
+    BTStatus status;
+
+    int node = blackboard->running;
+    if (node != BT_NODE_NONE)
+    {
+        // Resume the running action
+        blackboard->actionTime -= dt;
+        status = blackboard->actionTime > 0.0f ? BT_RUNNING : BT_SUCCESS;
+    }
+    else
+    {
+        node = 0;
+        status = EnterNode(tree, &node, blackboard, suggested, command, &emitted);
+    }
+
+    while (status != BT_RUNNING)
+    {
+        int parent = nodes[node].parent;
+        if (parent == BT_NODE_NONE)
+        {
+            // The root finished, the next tick starts from it again
+            blackboard->running = BT_NODE_NONE;
+            return emitted;
+        }
+
+        bool continues = (nodes[parent].type == BT_SEQUENCE) == (status == BT_SUCCESS);
+        if (continues && nodes[node].next < nodes[parent].next)
+        {
+            node = nodes[node].next;
+            status = EnterNode(tree, &node, blackboard, suggested, command, &emitted);
+        }
+        else
+        {
+            node = parent;
+        }
+    }
+
+    blackboard->running = (uint16_t)node;
+    return emitted;
+}
+
+/**
+ * DeleteBehaviourTree - Deletes a tree.
+ *
+ * @tree: The tree, no agent may run it any more.
+ */
+void DeleteBehaviourTree(BehaviourTree *tree)
+{
+    if (!tree)
+    {
+        return;
+    }
+    free(tree->nodes);
+    free(tree);
+}
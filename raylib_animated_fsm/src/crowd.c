@@ -0,0 +1,186 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../include/utils/crowd.h"
+#include "../include/utils/constants.h"
+#include "../include/utils/job_pool.h"
+#include "../include/utils/spatial_grid.h"
+
+// Cell size of the neighbour grid, one cell spans the neighbour radius
+#define CROWD_GRID_CELL_SIZE CROWD_NEIGHBOUR_RADIUS
+#define CROWD_GRID_BUCKETS 1024
+
+// Members of the crowd, each knows its slot (GameObject.crowdSlot)
+static GameObject **members = NULL;
+static int memberCount = 0;
+static int memberCapacity = 0;
+
+// Members by position, rebuilt every update before steering
+static SpatialGrid *neighbours = NULL;
+
+/**
+ * InitCrowd - Initialises the crowd.
+ *
+ * Members are the objects moving through the world together (walking NPCs).
+ * Each update every member's velocity is worked out from where the flow field
+ * wants it to go, bent away from the members around it (boids separation), so
+ * a dense crowd spreads out and flows instead of piling up and being pushed
+ * apart after the fact.
+ */
+void InitCrowd()
+{
+    memberCount = 0;
+    if (!neighbours)
+    {
+        neighbours = CreateSpatialGrid(CROWD_GRID_CELL_SIZE, CROWD_GRID_BUCKETS);
+    }
+}
+
+/**
+ * AddCrowdAgent - Adds an object to the crowd.
+ *
+ * @obj: The object, its velocity is steered from the next update on.
+ */
+void AddCrowdAgent(GameObject *obj)
+{
+    if (obj->crowdSlot != -1)
+    {
+        return;
+    }
+
+    if (memberCount == memberCapacity)
+    {
+        int newCapacity = memberCapacity ? memberCapacity * 2 : 64;
+        GameObject **grown = (GameObject **)realloc(members, sizeof(GameObject *) * newCapacity);
+        if (!grown)
+        {
+            fprintf(stderr, "Failed to allocate crowd\n");
+            exit(1);
+        }
+        members = grown;
+        memberCapacity = newCapacity;
+    }
+
+    obj->crowdSlot = memberCount;
+    members[memberCount++] = obj;
+}
+
+/**
+ * RemoveCrowdAgent - Removes an object from the crowd.
+ *
+ * @obj: The object (ignored if it is not in the crowd).
+ *
+ * The last member takes the freed slot, steering does not depend on the order.
+ */
+void RemoveCrowdAgent(GameObject *obj)
+{
+    int slot = obj->crowdSlot;
+    if (slot == -1)
+    {
+        return;
+    }
+
+    members[slot] = members[--memberCount];
+    members[slot]->crowdSlot = slot;
+    obj->crowdSlot = -1;
+}
+
+// Works out the velocity of a range of members (on any thread, only writes their velocities)
+static void SteerCrowdAgents(void *context, int first, int last)
+{
+    const FlowField *field = (const FlowField *)context;
+    GameObject *nearby[CROWD_MAX_NEIGHBOURS];
+
+    for (int i = first; i < last; i++)
+    {
+        GameObject *obj = members[i];
+
+        // Where the member wants to go: its own spot if its AI picked one (slowing
+        // down to stop on it), otherwise along the flow field
+        Vector2 preferred = field ? GetFlowDirection(field, obj->position) : (Vector2){0, 0};
+        if (obj->hasMoveGoal)
+        {
+            Vector2 toGoal = Vector2Subtract(obj->moveGoal, obj->position);
+            preferred = Vector2Scale(toGoal, 1.0f / fmaxf(Vector2Length(toGoal), CROWD_ARRIVAL_RADIUS));
+        }
+
+        // Away from each neighbour, harder the closer it is
+        Vector2 separation = {0, 0};
+        int found = SpatialGridQuery(neighbours, obj->position, CROWD_NEIGHBOUR_RADIUS, nearby, CROWD_MAX_NEIGHBOURS);
+        for (int j = 0; j < found; j++)
+        {
+            const GameObject *other = nearby[j];
+            if (other == obj)
+                continue;
+
+            Vector2 away = Vector2Subtract(obj->position, other->position);
+            float distance = Vector2Length(away);
+            if (distance >= CROWD_NEIGHBOUR_RADIUS)
+                continue;
+
+            // Members on the same spot split along a direction picked from the pair's ids,
+            // opposite for each of the two
+            if (distance < 0.001f)
+            {
+                int low = obj->id < other->id ? obj->id : other->id;
+                int high = obj->id < other->id ? other->id : obj->id;
+                float angle = (float)((unsigned)(low * 73856093u ^ high * 19349663u) % 628u) / 100.0f;
+                float side = obj->id < other->id ? -1.0f : 1.0f;
+                away = (Vector2){side * cosf(angle), side * sinf(angle)};
+                distance = 1.0f;
+            }
+
+            float strength = 1.0f - distance / CROWD_NEIGHBOUR_RADIUS;
+            separation = Vector2Add(separation, Vector2Scale(away, strength / distance));
+        }
+
+        Vector2 desired = Vector2Add(preferred, Vector2Scale(separation, CROWD_SEPARATION_WEIGHT));
+        obj->velocity = Vector2Scale(Vector2ClampValue(desired, 0.0f, 1.0f), obj->speed);
+    }
+}
+
+/**
+ * UpdateCrowd - Steers every member of the crowd.
+ *
+ * @field: The flow field the members follow (NULL to only keep them apart).
+ *
+ * The members are put in a spatial grid first, then steered in parallel on the
+ * job pool. Steering only reads positions and writes each member's own
+ * velocity, so it does not depend on how the work was split. The members then
+ * move by their velocity in their own state update.
+ */
+void UpdateCrowd(const FlowField *field)
+{
+    SpatialGridClear(neighbours);
+    for (int i = 0; i < memberCount; i++)
+    {
+        SpatialGridInsert(neighbours, members[i], members[i]->position);
+    }
+
+    RunParallelJob(SteerCrowdAgents, (void *)field, memberCount, CROWD_AGENTS_PER_BATCH);
+}
+
+// Number of objects in the crowd
+int GetCrowdAgentCount()
+{
+    return memberCount;
+}
+
+/**
+ * ExitCrowd - Releases the crowd storage.
+ */
+void ExitCrowd()
+{
+    for (int i = 0; i < memberCount; i++)
+    {
+        members[i]->crowdSlot = -1;
+    }
+    free(members);
+    members = NULL;
+    memberCount = 0;
+    memberCapacity = 0;
+
+    DeleteSpatialGrid(neighbours);
+    neighbours = NULL;
+}
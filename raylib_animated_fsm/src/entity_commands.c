@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include "../include/utils/entity_commands.h"
+#include "../include/gameobjects/gameobject.h"
+
+// Buffer receiving deferred requests made from inside update phases
+static EntityCommandBuffer *deferredCommands = NULL;
+
+// Appends a command, stamping its recording sequence
+static void PushEntityCommand(EntityCommandBuffer *buffer, EntityCommand command)
+{
+    if (buffer->count == buffer->capacity)
+    {
+        int newCapacity = buffer->capacity ? buffer->capacity * 2 : 32;
+        EntityCommand *grown = (EntityCommand *)realloc(buffer->commands, sizeof(EntityCommand) * newCapacity);
+        if (!grown)
+        {
+            fprintf(stderr, "Failed to allocate entity commands\n");
+            exit(1);
+        }
+        buffer->commands = grown;
+        buffer->capacity = newCapacity;
+    }
+
+    command.sequence = buffer->sequence++;
+    buffer->commands[buffer->count++] = command;
+}
+
+/**
+ * CreateEntityCommandBuffer - Creates an empty command buffer.
+ *
+ * Systems record spawns, despawns and state changes into a buffer while they run,
+ * nothing is modified until the buffer is applied at a sync point. Iterations over
+ * the entities therefore never see entities appear, disappear or change state.
+ *
+ * Return: A pointer to the new buffer. Exits if memory allocation fails.
+ */
+EntityCommandBuffer *CreateEntityCommandBuffer()
+{
+    EntityCommandBuffer *buffer = (EntityCommandBuffer *)malloc(sizeof(EntityCommandBuffer));
+    if (!buffer)
+    {
+        fprintf(stderr, "Failed to allocate entity command buffer\n");
+        exit(1);
+    }
+
+    buffer->commands = NULL;
+    buffer->count = 0;
+    buffer->capacity = 0;
+    buffer->sequence = 0;
+    return buffer;
+}
+
+/**
+ * RecordSpawnNPC - Records the spawn of an NPC.
+ *
+ * @buffer:   The buffer to record into.
+ * @name:     The NPC's name (a string that outlives the buffer, e.g., a literal).
+ * @position: Where the NPC spawns.
+ * @squad:    The squad the NPC joins (SQUAD_NONE if it decides alone).
+ *
+ * Spawns are applied after the commands for existing entities, in recording order,
+ * so new entities receive their ids deterministically.
+ */
+void RecordSpawnNPC(EntityCommandBuffer *buffer, const char *name, Vector2 position, int squad)
+{
+    PushEntityCommand(buffer, (EntityCommand){
+        .type = ENTITY_COMMAND_SPAWN_NPC,
+        .entityId = INT_MAX,
+        .name = name,
+        .position = position,
+        .squad = squad});
+}
+
+/**
+ * RecordDespawn - Records the removal of an entity.
+ *
+ * @buffer: The buffer to record into.
+ * @obj:    The GameObject to delete when the buffer is applied.
+ */
+void RecordDespawn(EntityCommandBuffer *buffer, GameObject *obj)
+{
+    PushEntityCommand(buffer, (EntityCommand){
+        .type = ENTITY_COMMAND_DESPAWN,
+        .entityId = obj->id,
+        .target = obj});
+}
+
+/**
+ * RecordChangeState - Records a state change.
+ *
+ * @buffer:   The buffer to record into.
+ * @obj:      The GameObject changing state.
+ * @newState: The state passed to ChangeState when the buffer is applied.
+ *
+ * The state the object is in is recorded too. If something else changed the state
+ * before the buffer is applied, the request is stale and is dropped (see
+ * IsEntityCommandStale), so only the first recorded change from a state wins.
+ */
+void RecordChangeState(EntityCommandBuffer *buffer, GameObject *obj, State newState)
+{
+    PushEntityCommand(buffer, (EntityCommand){
+        .type = ENTITY_COMMAND_CHANGE_STATE,
+        .entityId = obj->id,
+        .target = obj,
+        .state = newState,
+        .fromState = obj->currentState});
+}
+
+/**
+ * IsEntityCommandStale - Checks if a state change was recorded for a state that has been left.
+ *
+ * @command: The command about to be applied.
+ *
+ * Return: true if the command is a state change whose target is no longer in the
+ *         state it was recorded in.
+ */
+bool IsEntityCommandStale(const EntityCommand *command)
+{
+    return command->type == ENTITY_COMMAND_CHANGE_STATE &&
+           command->target->currentState != command->fromState;
+}
+
+// Orders commands by entity id, then by recording sequence
+static int CompareEntityCommands(const void *lhs, const void *rhs)
+{
+    const EntityCommand *a = (const EntityCommand *)lhs;
+    const EntityCommand *b = (const EntityCommand *)rhs;
+
+    if (a->entityId != b->entityId)
+        return (a->entityId < b->entityId) ? -1 : 1;
+    if (a->sequence != b->sequence)
+        return (a->sequence < b->sequence) ? -1 : 1;
+    return 0;
+}
+
+/**
+ * SortEntityCommands - Sorts the commands into their apply order.
+ *
+ * The order only depends on entity ids and recording order, never on which system
+ * or thread recorded first, so applying the buffer is deterministic.
+ */
+void SortEntityCommands(EntityCommandBuffer *buffer)
+{
+    if (buffer->count > 1)
+    {
+        qsort(buffer->commands, buffer->count, sizeof(EntityCommand), CompareEntityCommands);
+    }
+}
+
+/**
+ * DiscardEntityCommands - Removes the first count commands from the buffer.
+ *
+ * @buffer: The buffer that was applied.
+ * @count:  The number of commands that were applied.
+ *
+ * Commands recorded while the buffer was being applied (e.g., by an Entry function)
+ * are kept for the next sync point.
+ */
+void DiscardEntityCommands(EntityCommandBuffer *buffer, int count)
+{
+    if (count >= buffer->count)
+    {
+        buffer->count = 0;
+        return;
+    }
+
+    memmove(buffer->commands, buffer->commands + count, sizeof(EntityCommand) * (buffer->count - count));
+    buffer->count -= count;
+}
+
+/**
+ * DeleteEntityCommandBuffer - Frees the command buffer, dropping unapplied commands.
+ */
+void DeleteEntityCommandBuffer(EntityCommandBuffer *buffer)
+{
+    if (buffer)
+    {
+        if (deferredCommands == buffer)
+            deferredCommands = NULL;
+
+        free(buffer->commands);
+        free(buffer);
+    }
+}
+
+// Set the buffer used for deferred requests
+void SetDeferredCommands(EntityCommandBuffer *buffer)
+{
+    deferredCommands = buffer;
+}
+
+// Get the buffer used for deferred requests
+EntityCommandBuffer *GetDeferredCommands()
+{
+    return deferredCommands;
+}
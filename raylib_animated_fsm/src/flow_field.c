@@ -0,0 +1,295 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <raymath.h>
+
+#include "../include/utils/flow_field.h"
+
+// Neighbour offsets, straight ones first
+static const int neighbourColumns[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+static const int neighbourRows[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+static const float neighbourCosts[8] = {1.0f, 1.0f, 1.0f, 1.0f, 1.41421356f, 1.41421356f, 1.41421356f, 1.41421356f};
+
+/**
+ * CreateFlowField - Creates a flow field over a grid.
+ *
+ * @columns:  Number of cells across.
+ * @rows:     Number of cells down.
+ * @cellSize: Width and height of a cell (world units).
+ *
+ * Every cell starts open and the field leads nowhere until its first update.
+ *
+ * Return: A pointer to the flow field.
+ */
+FlowField *CreateFlowField(int columns, int rows, float cellSize)
+{
+    FlowField *field = (FlowField *)malloc(sizeof(FlowField));
+    int cellCount = columns * rows;
+    if (field)
+    {
+        field->blocked = (unsigned char *)calloc(cellCount, sizeof(unsigned char));
+        field->cost = (float *)malloc(sizeof(float) * cellCount);
+        field->direction = (Vector2 *)calloc(cellCount, sizeof(Vector2));
+
+        // A cell is pushed at most once per neighbour (each lowers its cost once) plus the target
+        field->heap = (FlowOpenCell *)malloc(sizeof(FlowOpenCell) * (cellCount * 8 + 1));
+    }
+    if (!field || !field->blocked || !field->cost || !field->direction || !field->heap)
+    {
+        fprintf(stderr, "Failed to allocate flow field\n");
+        exit(1);
+    }
+
+    field->columns = columns;
+    field->rows = rows;
+    field->cellSize = cellSize;
+    field->targetCell = -1;
+    field->targetPosition = (Vector2){0};
+    field->dirty = true;
+    field->heapCount = 0;
+
+    for (int i = 0; i < cellCount; i++)
+    {
+        field->cost[i] = INFINITY;
+    }
+
+    return field;
+}
+
+// Finds the cell a position is in, clamped to the grid
+static int GetFlowCell(const FlowField *field, Vector2 position)
+{
+    int column = (int)(position.x / field->cellSize);
+    int row = (int)(position.y / field->cellSize);
+    column = column < 0 ? 0 : (column >= field->columns ? field->columns - 1 : column);
+    row = row < 0 ? 0 : (row >= field->rows ? field->rows - 1 : row);
+    return row * field->columns + column;
+}
+
+/**
+ * SetFlowFieldBlocked - Blocks or unblocks a cell.
+ *
+ * @field:   The flow field.
+ * @column:  The cell's column.
+ * @row:     The cell's row.
+ * @blocked: True if nothing can enter the cell.
+ */
+void SetFlowFieldBlocked(FlowField *field, int column, int row, bool blocked)
+{
+    if (column < 0 || column >= field->columns || row < 0 || row >= field->rows)
+    {
+        return;
+    }
+
+    unsigned char *cell = &field->blocked[row * field->columns + column];
+    if (*cell != blocked)
+    {
+        *cell = blocked;
+        field->dirty = true;
+    }
+}
+
+// Pushes a cell on the build heap (sifts it up by cost)
+static void PushOpenCell(FlowField *field, int cell, float cost)
+{
+    FlowOpenCell *heap = field->heap;
+    int i = field->heapCount++;
+    while (i > 0)
+    {
+        int parent = (i - 1) / 2;
+        if (heap[parent].cost <= cost)
+            break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = (FlowOpenCell){cost, cell};
+}
+
+// Pops the cheapest cell off the build heap
+static FlowOpenCell PopOpenCell(FlowField *field)
+{
+    FlowOpenCell *heap = field->heap;
+    FlowOpenCell top = heap[0];
+    FlowOpenCell last = heap[--field->heapCount];
+    int count = field->heapCount;
+
+    int i = 0;
+    for (;;)
+    {
+        int child = 2 * i + 1;
+        if (child >= count)
+            break;
+        if (child + 1 < count && heap[child + 1].cost < heap[child].cost)
+            child++;
+        if (last.cost <= heap[child].cost)
+            break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    if (count > 0)
+        heap[i] = last;
+
+    return top;
+}
+
+// True if a diagonal step does not cut the corner of a blocked cell
+static bool CanStep(const FlowField *field, int column, int row, int k)
+{
+    if (k < 4)
+    {
+        return true;
+    }
+    int columns = field->columns;
+    return !field->blocked[row * columns + column + neighbourColumns[k]] &&
+           !field->blocked[(row + neighbourRows[k]) * columns + column];
+}
+
+// Builds the path costs from every cell to the target cell (Dijkstra over the 8 neighbours)
+static void BuildFlowCosts(FlowField *field)
+{
+    int cellCount = field->columns * field->rows;
+    for (int i = 0; i < cellCount; i++)
+    {
+        field->cost[i] = INFINITY;
+    }
+
+    field->heapCount = 0;
+    field->cost[field->targetCell] = 0.0f;
+    PushOpenCell(field, field->targetCell, 0.0f);
+
+    while (field->heapCount > 0)
+    {
+        FlowOpenCell open = PopOpenCell(field);
+        int cell = open.cell;
+
+        // Reached more cheaply since it was pushed, that entry has been expanded already
+        if (open.cost > field->cost[cell])
+            continue;
+
+        int column = cell % field->columns;
+        int row = cell / field->columns;
+
+        for (int k = 0; k < 8; k++)
+        {
+            int nextColumn = column + neighbourColumns[k];
+            int nextRow = row + neighbourRows[k];
+            if (nextColumn < 0 || nextColumn >= field->columns || nextRow < 0 || nextRow >= field->rows)
+                continue;
+
+            int next = nextRow * field->columns + nextColumn;
+            float cost = field->cost[cell] + neighbourCosts[k];
+            if (field->blocked[next] || cost >= field->cost[next] || !CanStep(field, column, row, k))
+                continue;
+
+            field->cost[next] = cost;
+            PushOpenCell(field, next, cost);
+        }
+    }
+}
+
+// Points every cell at its cheapest neighbour
+static void BuildFlowDirections(FlowField *field)
+{
+    for (int row = 0; row < field->rows; row++)
+    {
+        for (int column = 0; column < field->columns; column++)
+        {
+            int cell = row * field->columns + column;
+            float best = field->cost[cell];
+            Vector2 direction = {0};
+
+            for (int k = 0; k < 8; k++)
+            {
+                int nextColumn = column + neighbourColumns[k];
+                int nextRow = row + neighbourRows[k];
+                if (nextColumn < 0 || nextColumn >= field->columns || nextRow < 0 || nextRow >= field->rows)
+                    continue;
+
+                int next = nextRow * field->columns + nextColumn;
+                if (field->cost[next] < best && CanStep(field, column, row, k))
+                {
+                    best = field->cost[next];
+                    direction = Vector2Normalize((Vector2){(float)neighbourColumns[k], (float)neighbourRows[k]});
+                }
+            }
+
+            field->direction[cell] = direction;
+        }
+    }
+}
+
+/**
+ * UpdateFlowField - Leads the field to a target.
+ *
+ * @field:  The flow field.
+ * @target: Where the target is (world units).
+ *
+ * Called once per update by the owner of the target. The field is only rebuilt
+ * when the target moved to another cell or obstacles changed, otherwise the
+ * update just records the exact target position. A rebuild is one Dijkstra pass
+ * from the target cell plus one pass picking each cell's direction, after which
+ * every chaser's lookup is O(1), however many there are.
+ *
+ * Return: true if the field was rebuilt.
+ */
+bool UpdateFlowField(FlowField *field, Vector2 target)
+{
+    int targetCell = GetFlowCell(field, target);
+    field->targetPosition = target;
+
+    if (targetCell == field->targetCell && !field->dirty)
+    {
+        return false;
+    }
+
+    field->targetCell = targetCell;
+    field->dirty = false;
+
+    BuildFlowCosts(field);
+    BuildFlowDirections(field);
+    return true;
+}
+
+/**
+ * GetFlowDirection - Gets the direction toward the target from a position.
+ *
+ * @field:    The flow field.
+ * @position: Where the chaser is (world units).
+ *
+ * Chasers in the target's cell head straight for the target.
+ *
+ * Return: A unit direction, or zero if there is no path (or the chaser is on the target).
+ */
+Vector2 GetFlowDirection(const FlowField *field, Vector2 position)
+{
+    if (field->targetCell < 0)
+    {
+        return (Vector2){0};
+    }
+
+    int cell = GetFlowCell(field, position);
+    if (cell == field->targetCell)
+    {
+        return Vector2Normalize(Vector2Subtract(field->targetPosition, position));
+    }
+    return field->direction[cell];
+}
+
+/**
+ * DeleteFlowField - Deletes a flow field.
+ *
+ * @field: The flow field, no chaser may look it up any more.
+ */
+void DeleteFlowField(FlowField *field)
+{
+    if (!field)
+    {
+        return;
+    }
+    free(field->blocked);
+    free(field->cost);
+    free(field->direction);
+    free(field->heap);
+    free(field);
+}
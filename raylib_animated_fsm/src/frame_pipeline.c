@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <stdbool.h>
+
+#include <raylib.h>
+
+#if !defined(WEB_BUILD)
+#include <pthread.h>
+#endif
+
+#include "../include/game/frame_pipeline.h"
+#include "../include/render/sprite_instancing.h"
+
+// Snapshots being drawn (front) and being built (the other one)
+static RenderSnapshot snapshots[2] = {0};
+static int front = 0;
+
+// True if the simulation runs on its own thread
+static bool threaded = false;
+
+#if !defined(WEB_BUILD)
+// An update and the snapshot it publishes, handed to the simulation thread
+typedef struct
+{
+    GameData *gameData;
+    Command command;
+    float dt;
+    RenderSnapshot *snapshot;
+} FrameJob;
+
+static pthread_t simulationThread;
+static pthread_mutex_t jobLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t jobReady = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t jobDone = PTHREAD_COND_INITIALIZER;
+static FrameJob job = {0};
+static bool jobPending = false;
+static bool stopping = false;
+
+// Simulation thread: runs each frame's update and builds its snapshot
+static void *RunSimulation(void *arg)
+{
+    (void)arg; // Jobs carry everything
+
+    pthread_mutex_lock(&jobLock);
+    while (true)
+    {
+        while (!jobPending && !stopping)
+        {
+            pthread_cond_wait(&jobReady, &jobLock);
+        }
+        if (stopping)
+        {
+            break;
+        }
+
+        FrameJob current = job;
+        pthread_mutex_unlock(&jobLock);
+
+        UpdateGame(current.gameData, current.command, current.dt);
+        BuildRenderSnapshot(current.gameData, current.snapshot);
+
+        pthread_mutex_lock(&jobLock);
+        jobPending = false;
+        pthread_cond_signal(&jobDone);
+    }
+    pthread_mutex_unlock(&jobLock);
+
+    return NULL;
+}
+#endif
+
+/**
+ * StartFramePipeline - Starts the frame pipeline.
+ *
+ * @gameData: A pointer to the GameData structure containing the game state.
+ *
+ * The window, input and every GL call stay on the calling (main) thread, as raylib
+ * requires, and the simulation moves to a worker thread. The first snapshot is
+ * built here from the initial game state, so the first frame has something to draw.
+ * Web builds (and platforms where the thread cannot be created) keep running the
+ * update and the draw one after the other on the main thread.
+ */
+void StartFramePipeline(GameData *gameData)
+{
+    front = 0;
+    threaded = false;
+
+    BuildRenderSnapshot(gameData, &snapshots[front]);
+
+#if !defined(WEB_BUILD)
+    stopping = false;
+    jobPending = false;
+
+    if (pthread_create(&simulationThread, NULL, RunSimulation, NULL) == 0)
+    {
+        threaded = true;
+    }
+    else
+    {
+        fprintf(stderr, "Failed to start the simulation thread, updating and drawing on one thread\n");
+    }
+#endif
+}
+
+/**
+ * RunFramePipeline - Runs one frame.
+ *
+ * @gameData: A pointer to the GameData structure containing the game state.
+ *
+ * Threaded, the simulation updates the game and builds the next snapshot while
+ * this thread draws the one published last frame, so a frame takes as long as
+ * the slower of the two rather than both added up. Neither touches the other's
+ * snapshot, the only shared step is the hand over: once both are done the
+ * instanced sprites are synced and the snapshots swap. Input reaches the screen
+ * one frame later than when the two ran in turn.
+ */
+void RunFramePipeline(GameData *gameData)
+{
+    // Input and frame time come from the window, polled on this thread
+    Command command = PollInput();
+    float dt = GetFrameTime();
+
+    if (!threaded)
+    {
+        UpdateGame(gameData, command, dt);
+        BuildRenderSnapshot(gameData, &snapshots[front]);
+        SyncSpriteInstances();
+        DrawRenderSnapshot(&snapshots[front]);
+        return;
+    }
+
+#if !defined(WEB_BUILD)
+    // The simulation is idle, bring the instanced sprites up to the front snapshot
+    SyncSpriteInstances();
+
+    pthread_mutex_lock(&jobLock);
+    job = (FrameJob){gameData, command, dt, &snapshots[1 - front]};
+    jobPending = true;
+    pthread_cond_signal(&jobReady);
+    pthread_mutex_unlock(&jobLock);
+
+    DrawRenderSnapshot(&snapshots[front]);
+
+    pthread_mutex_lock(&jobLock);
+    while (jobPending)
+    {
+        pthread_cond_wait(&jobDone, &jobLock);
+    }
+    pthread_mutex_unlock(&jobLock);
+
+    // Publish the snapshot the simulation just built
+    front = 1 - front;
+#endif
+}
+
+/**
+ * StopFramePipeline - Stops the simulation thread and releases the snapshots.
+ *
+ * Called between frames, when the simulation is idle, and before CloseGame deletes
+ * the objects it updates.
+ */
+void StopFramePipeline()
+{
+#if !defined(WEB_BUILD)
+    if (threaded)
+    {
+        pthread_mutex_lock(&jobLock);
+        stopping = true;
+        pthread_cond_signal(&jobReady);
+        pthread_mutex_unlock(&jobLock);
+
+        pthread_join(simulationThread, NULL);
+    }
+#endif
+    threaded = false;
+
+    ReleaseRenderSnapshot(&snapshots[0]);
+    ReleaseRenderSnapshot(&snapshots[1]);
+}
@@ -1,5 +1,22 @@
 #include "../include/fsm/fsm.h"
 #include "../include/gameobjects/gameobject.h"
+#include "../include/utils/scheduler.h"
+#include "../include/utils/entity_commands.h"
+
+#ifdef FSM_GENERATED_DISPATCH
+// Switch dispatch generated from assets/fsm/*.fsm by tools/fsm_compiler --dispatch (make fsm)
+#include "player_dispatch.h"
+#include "npc_dispatch.h"
+#endif
+
+// Any real event wakes a sleeping object before it is handled
+static inline void WakeForEvent(GameObject *obj, Event event)
+{
+    if (obj->asleep && event != EVENT_NONE)
+    {
+        WakeGameObject(obj);
+    }
+}
 
 /**
  * HandleEvent - Handles an event for a given game object based on its current state.
@@ -7,14 +24,50 @@
  * This function checks the current state of the game object and, if an event handler
  * (HandleEvent) is defined for the current state, it calls that function to handle the event.
  *
+ * Builds with FSM_GENERATED_DISPATCH call the Player and NPC handlers directly from
+ * switches generated from their .fsm definitions, the same applies to UpdateState,
+ * ResumeState, CanEnterState and ChangeState. Other objects use the function pointers.
+ *
  * @obj:   A pointer to the GameObject that is receiving the event.
  * @event: The event to be handled (such as a user input, time-based event, etc.).
  */
 void HandleEvent(GameObject *obj, Event event)
 {
+#ifdef FSM_GENERATED_DISPATCH
+    // Direct calls for archetypes with generated dispatch, no function pointers
+    switch (obj->archetype)
+    {
+        case FSM_ARCHETYPE_PLAYER:
+            if (PlayerAcceptsEvent(obj->currentState, event))
+            {
+                WakeForEvent(obj, event);
+                PlayerDispatchEvent(obj, event);
+            }
+            return;
+        case FSM_ARCHETYPE_NPC:
+            if (NPCAcceptsEvent(obj->currentState, event))
+            {
+                WakeForEvent(obj, event);
+                NPCDispatchEvent(obj, event);
+            }
+            return;
+        case FSM_ARCHETYPE_DYNAMIC:
+            break;
+    }
+#endif
+
     // Get the state configuration for the current state of the object
     StateConfig *config = &obj->stateConfigs[obj->currentState];
 
+    // Events the state does not react to are dropped without waking the object
+    if (config->eventMask && !(config->eventMask & (1u << event)))
+    {
+        return;
+    }
+
+    // Any real event wakes a sleeping object before it is handled
+    WakeForEvent(obj, event);
+
     // If a HandleEvent function is defined for this state, call it
     if (config->HandleEvent)
     {
@@ -32,6 +85,20 @@ void HandleEvent(GameObject *obj, Event event)
  */
 void UpdateState(GameObject *obj)
 {
+#ifdef FSM_GENERATED_DISPATCH
+    switch (obj->archetype)
+    {
+        case FSM_ARCHETYPE_PLAYER:
+            PlayerDispatchUpdate(obj);
+            return;
+        case FSM_ARCHETYPE_NPC:
+            NPCDispatchUpdate(obj);
+            return;
+        case FSM_ARCHETYPE_DYNAMIC:
+            break;
+    }
+#endif
+
     // Get the configuration for the current state
     StateConfig *config = &obj->stateConfigs[obj->currentState];
 
@@ -42,11 +109,44 @@ void UpdateState(GameObject *obj)
     }
 }
 
+/**
+ * ResumeState - Catches up the game object's current state after it was asleep.
+ *
+ * Called by the scheduler when a sleeping object wakes. States that accumulate
+ * something every tick (e.g., regeneration) reconstruct it from the elapsed time.
+ *
+ * @obj:     A pointer to the GameObject that woke up.
+ * @elapsed: The number of seconds the object was asleep.
+ */
+void ResumeState(GameObject *obj, float elapsed)
+{
+#ifdef FSM_GENERATED_DISPATCH
+    switch (obj->archetype)
+    {
+        case FSM_ARCHETYPE_PLAYER:
+            PlayerDispatchResume(obj, elapsed);
+            return;
+        case FSM_ARCHETYPE_NPC:
+            NPCDispatchResume(obj, elapsed);
+            return;
+        case FSM_ARCHETYPE_DYNAMIC:
+            break;
+    }
+#endif
+
+    StateConfig *config = &obj->stateConfigs[obj->currentState];
+
+    if (config->Resume)
+    {
+        config->Resume(obj, elapsed);
+    }
+}
+
 /**
  * CanEnterState - Checks if the game object can transition to a new state.
  *
  * This function checks whether transitioning from the current state to the specified `newState` is valid
- * by verifying if `newState` is listed in the `nextStates` array of the current state's configuration.
+ * by testing the bit for `newState` in the transition mask built from the `nextStates` array.
  *
  * @obj:      A pointer to the GameObject whose state transitions need to be validated.
  * @newState: The target state to which the object wants to transition.
@@ -55,16 +155,67 @@ void UpdateState(GameObject *obj)
  */
 bool CanEnterState(GameObject *obj, State newState)
 {
+#ifdef FSM_GENERATED_DISPATCH
+    switch (obj->archetype)
+    {
+        case FSM_ARCHETYPE_PLAYER:
+            return PlayerCanEnterState(obj->currentState, newState);
+        case FSM_ARCHETYPE_NPC:
+            return NPCCanEnterState(obj->currentState, newState);
+        case FSM_ARCHETYPE_DYNAMIC:
+            break;
+    }
+#endif
+
     // Get the current state configuration
     StateConfig *currentConfig = &obj->stateConfigs[obj->currentState];
 
-    // Loop through the possible next states and check if newState is valid
-    for (int i = 0; i < currentConfig->nextStatesCount; i++)
+    // One bit per valid next state, set up by StateTransitions or the FSM compiler
+    return (currentConfig->transitionMask >> newState) & 1u;
+}
+
+// Runs the Exit function of the game object's current state
+static void ExitCurrentState(GameObject *obj)
+{
+#ifdef FSM_GENERATED_DISPATCH
+    switch (obj->archetype)
     {
-        if (currentConfig->nextStates[i] == newState)
-            return true; // Valid transition found
+        case FSM_ARCHETYPE_PLAYER:
+            PlayerDispatchExit(obj);
+            return;
+        case FSM_ARCHETYPE_NPC:
+            NPCDispatchExit(obj);
+            return;
+        case FSM_ARCHETYPE_DYNAMIC:
+            break;
     }
-    return false; // No valid transition found
+#endif
+
+    StateConfig *config = &obj->stateConfigs[obj->currentState];
+    if (config->Exit)
+        config->Exit(obj);
+}
+
+// Runs the Entry function of the game object's current state
+static void EnterCurrentState(GameObject *obj)
+{
+#ifdef FSM_GENERATED_DISPATCH
+    switch (obj->archetype)
+    {
+        case FSM_ARCHETYPE_PLAYER:
+            PlayerDispatchEntry(obj);
+            return;
+        case FSM_ARCHETYPE_NPC:
+            NPCDispatchEntry(obj);
+            return;
+        case FSM_ARCHETYPE_DYNAMIC:
+            break;
+    }
+#endif
+
+    StateConfig *config = &obj->stateConfigs[obj->currentState];
+    if (config->Entry)
+        config->Entry(obj);
 }
 
 /**
@@ -91,25 +242,64 @@ bool ChangeState(GameObject *obj, State newState)
         return false; // Transition failed
     }
 
-    // Get the configuration of the current state and the new state
-    StateConfig *currentConfig = &obj->stateConfigs[obj->currentState];
-    StateConfig *newConfig = &obj->stateConfigs[newState];
+    // A sleeping object catches up before it leaves its state
+    WakeGameObject(obj);
+
+    // A state timeout belongs to the state being left
+    CancelTimer(&obj->stateTimer);
 
     // If the current state has an exit function defined, call it
-    if (currentConfig->Exit)
-        currentConfig->Exit(obj);
+    ExitCurrentState(obj);
 
     // Update the object's previous and current state
     obj->previousState = obj->currentState;
     obj->currentState = newState;
 
     // If the new state has an entry function defined, call it
-    if (newConfig->Entry)
-        newConfig->Entry(obj);
+    EnterCurrentState(obj);
 
     return true; // State transition successful
 }
 
+/**
+ * DeferChangeState - Requests a state change without running it immediately.
+ *
+ * Update functions run while the scheduler iterates its update set, changing state
+ * there would run Exit/Entry functions in the middle of the iteration. The change is
+ * recorded instead and ChangeState runs (and validates it) at the next sync point.
+ * Without a deferred command buffer the state changes immediately.
+ *
+ * @obj:      A pointer to the GameObject whose state is being changed.
+ * @newState: The state to which the game object will transition.
+ */
+void DeferChangeState(GameObject *obj, State newState)
+{
+    EntityCommandBuffer *commands = GetDeferredCommands();
+    if (!commands)
+    {
+        ChangeState(obj, newState);
+        return;
+    }
+
+    RecordChangeState(commands, obj, newState);
+}
+
+/**
+ * SetStateTimeout - Schedules an EVENT_TIMEOUT for the game object's current state.
+ *
+ * Replaces per-frame polling (e.g., "has the death animation finished?") with a single
+ * timer on the timer wheel. Only one state timeout is pending per object, scheduling a
+ * new one replaces the previous one, and ChangeState cancels it when the state is left.
+ *
+ * @obj:     A pointer to the GameObject that receives the timeout.
+ * @seconds: Time until the EVENT_TIMEOUT is delivered to the state's HandleEvent.
+ */
+void SetStateTimeout(GameObject *obj, float seconds)
+{
+    CancelTimer(&obj->stateTimer);
+    obj->stateTimer = ScheduleTimerSeconds(obj, EVENT_TIMEOUT, seconds, NULL);
+}
+
 /**
  * StateTransitions - Initializes the valid state transitions for a specific state.
  *
@@ -135,6 +325,32 @@ void StateTransitions(StateConfig *stateConfig, State *transitions, int stateCou
     // Copy the transitions array into the stateConfig's nextStates array
     memcpy(stateConfig->nextStates, transitions, sizeof(State) * stateCount);
     stateConfig->nextStatesCount = stateCount; // Set the count of next states
+
+    // Build the transition bitset used by CanEnterState
+    stateConfig->transitionMask = 0;
+    for (int i = 0; i < stateCount; i++)
+    {
+        stateConfig->transitionMask |= 1u << transitions[i];
+    }
+}
+
+/**
+ * StateEvents - Sets the events a specific state reacts to.
+ *
+ * Events outside the set are dropped by HandleEvent before they wake the object
+ * or reach the state's handler, like the `events` line of a compiled graph.
+ *
+ * @stateConfig: A pointer to the StateConfig object for the specific state being configured.
+ * @events:      An array of the events the state reacts to.
+ * @eventCount:  The number of events in the `events` array.
+ */
+void StateEvents(StateConfig *stateConfig, Event *events, int eventCount)
+{
+    stateConfig->eventMask = 0;
+    for (int i = 0; i < eventCount; i++)
+    {
+        stateConfig->eventMask |= 1u << events[i];
+    }
 }
 
 /**
@@ -0,0 +1,366 @@
+// mmap, open and fstat are POSIX
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#define FSM_LOADER_NO_MMAP
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../include/fsm/fsm_loader.h"
+
+// The next state lists are used in place, so a State must have the blob's int32 layout
+_Static_assert(sizeof(State) == sizeof(int32_t), "State must be 32 bits to map FSM blobs");
+_Static_assert(STATE_COUNT <= 32 && EVENT_COUNT <= 32, "FSM masks hold 32 states/events");
+
+// Most archetype graphs loaded at once
+#define MAX_FSM_GRAPHS 8
+
+typedef struct
+{
+    const char *name;    // Name used in .fsm definitions
+    FsmHandlerKind kind; // Slot the handler can be bound to
+    FsmHandler handler;  // The handler function
+} FsmHandlerEntry;
+
+static FsmHandlerEntry *registry = NULL;
+static int registryCount = 0;
+static int registryCapacity = 0;
+
+// Loaded graphs, a NULL graph records a blob that failed to load so it is not retried
+static struct
+{
+    char path[256];
+    FsmGraph *graph;
+} graphs[MAX_FSM_GRAPHS];
+static int graphCount = 0;
+
+/**
+ * RegisterFsmHandler - Registers a handler function for binding compiled graphs.
+ *
+ * @name:    The function name used in .fsm definitions.
+ * @kind:    The StateConfig slot the function can be bound to.
+ * @handler: The function, cast to FsmHandler (see REGISTER_FSM_HANDLER).
+ *
+ * Handlers are registered once at startup, before any graph is loaded.
+ */
+void RegisterFsmHandler(const char *name, FsmHandlerKind kind, FsmHandler handler)
+{
+    if (registryCount == registryCapacity)
+    {
+        int newCapacity = registryCapacity ? registryCapacity * 2 : 32;
+        FsmHandlerEntry *grown = (FsmHandlerEntry *)realloc(registry, sizeof(FsmHandlerEntry) * newCapacity);
+        if (!grown)
+        {
+            fprintf(stderr, "Failed to allocate FSM handler registry\n");
+            exit(1);
+        }
+        registry = grown;
+        registryCapacity = newCapacity;
+    }
+
+    registry[registryCount++] = (FsmHandlerEntry){name, kind, handler};
+}
+
+// Finds a registered handler by name, NULL if it is not registered
+static const FsmHandlerEntry *FindFsmHandler(const char *name)
+{
+    for (int i = 0; i < registryCount; i++)
+    {
+        if (strcmp(registry[i].name, name) == 0)
+            return &registry[i];
+    }
+    return NULL;
+}
+
+// Maps (or on platforms without mmap, reads) a whole file, returns NULL on failure
+static void *MapFile(const char *path, size_t *size, bool *mapped)
+{
+#ifdef FSM_LOADER_NO_MMAP
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return NULL;
+
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    void *data = (length > 0) ? malloc((size_t)length) : NULL;
+    if (!data || fread(data, 1, (size_t)length, file) != (size_t)length)
+    {
+        free(data);
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+
+    *size = (size_t)length;
+    *mapped = false;
+    return data;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    void *data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // The mapping stays valid after the descriptor is closed
+    if (data == MAP_FAILED)
+        return NULL;
+
+    *size = (size_t)info.st_size;
+    *mapped = true;
+    return data;
+#endif
+}
+
+// Releases a blob returned by MapFile
+static void UnmapFile(void *data, size_t size, bool mapped)
+{
+#ifdef FSM_LOADER_NO_MMAP
+    (void)size;
+    (void)mapped;
+    free(data);
+#else
+    if (mapped)
+        munmap(data, size);
+    else
+        free(data);
+#endif
+}
+
+// Checks that a byte range lies inside the blob
+static bool InBlob(const FsmGraph *graph, uint32_t offset, uint32_t length)
+{
+    return offset <= graph->size && length <= graph->size - offset;
+}
+
+// Returns the NUL terminated string at an offset, NULL if it runs off the blob
+static const char *BlobString(const FsmGraph *graph, uint32_t offset)
+{
+    if (offset >= graph->size)
+        return NULL;
+
+    const char *string = (const char *)graph->data + offset;
+    if (!memchr(string, '\0', graph->size - offset))
+        return NULL;
+    return string;
+}
+
+/**
+ * BindFsmGraph - Validates a mapped blob and fills in the graph's state table.
+ *
+ * Handler ids are resolved through the registry once per graph. State names and
+ * next state lists point into the blob, nothing is copied.
+ *
+ * Return: true if the blob is valid and every handler is registered.
+ */
+static bool BindFsmGraph(FsmGraph *graph)
+{
+    const FsmBlobHeader *header = (const FsmBlobHeader *)graph->data;
+
+    if (graph->size < sizeof(FsmBlobHeader) || header->magic != FSM_BLOB_MAGIC)
+    {
+        fprintf(stderr, "%s: not an FSM blob\n", graph->path);
+        return false;
+    }
+    if (header->version != FSM_BLOB_VERSION || header->size != graph->size)
+    {
+        fprintf(stderr, "%s: unsupported FSM blob version or truncated blob\n", graph->path);
+        return false;
+    }
+    if (header->stateCount != STATE_COUNT || header->eventCount != EVENT_COUNT)
+    {
+        fprintf(stderr, "%s: compiled against different states/events, recompile the FSM\n", graph->path);
+        return false;
+    }
+    if (!InBlob(graph, header->handlersOffset, header->handlerCount * sizeof(uint32_t)) ||
+        !InBlob(graph, header->statesOffset, STATE_COUNT * sizeof(FsmBlobState)) ||
+        !InBlob(graph, header->transitionsOffset, header->transitionCount * sizeof(int32_t)))
+    {
+        fprintf(stderr, "%s: corrupt FSM blob\n", graph->path);
+        return false;
+    }
+
+    // Resolve every handler id to a registered function
+    const uint32_t *handlerNames = (const uint32_t *)((const char *)graph->data + header->handlersOffset);
+    const FsmHandlerEntry **bound = (const FsmHandlerEntry **)malloc(sizeof(FsmHandlerEntry *) * (header->handlerCount + 1));
+    if (!bound)
+    {
+        fprintf(stderr, "Failed to allocate FSM handler bindings\n");
+        exit(1);
+    }
+
+    bool valid = true;
+    for (uint32_t i = 0; i < header->handlerCount && valid; i++)
+    {
+        const char *name = BlobString(graph, handlerNames[i]);
+        bound[i] = name ? FindFsmHandler(name) : NULL;
+        if (!bound[i])
+        {
+            fprintf(stderr, "%s: handler %s is not registered\n", graph->path, name ? name : "(corrupt)");
+            valid = false;
+        }
+    }
+
+    const FsmBlobState *blobStates = (const FsmBlobState *)((const char *)graph->data + header->statesOffset);
+    State *transitions = (State *)((char *)graph->data + header->transitionsOffset);
+
+    for (int s = 0; s < STATE_COUNT && valid; s++)
+    {
+        const FsmBlobState *blobState = &blobStates[s];
+        StateConfig *config = &graph->states[s];
+
+        config->name = (blobState->name == FSM_BLOB_NONE) ? NULL : BlobString(graph, blobState->name);
+        if (blobState->name != FSM_BLOB_NONE && !config->name)
+            valid = false;
+
+        // Bind each handler slot, checking the handler was registered for that slot
+        FsmHandler handlers[FSM_HANDLER_KIND_COUNT] = {NULL};
+        for (int kind = 0; kind < FSM_HANDLER_KIND_COUNT && valid; kind++)
+        {
+            uint32_t id = blobState->handlers[kind];
+            if (id == FSM_BLOB_NONE)
+                continue;
+
+            if (id >= header->handlerCount || bound[id]->kind != (FsmHandlerKind)kind)
+            {
+                fprintf(stderr, "%s: handler bound to the wrong slot in state %d\n", graph->path, s);
+                valid = false;
+                break;
+            }
+            handlers[kind] = bound[id]->handler;
+        }
+
+        config->HandleEvent = (EventFunction)handlers[FSM_HANDLER_EVENT];
+        config->Entry = (StateFunction)handlers[FSM_HANDLER_ENTRY];
+        config->Update = (StateFunction)handlers[FSM_HANDLER_UPDATE];
+        config->Exit = (StateFunction)handlers[FSM_HANDLER_EXIT];
+        config->Resume = (ResumeFunction)handlers[FSM_HANDLER_RESUME];
+
+        // Next states are used in place
+        if (blobState->nextStatesCount > header->transitionCount ||
+            blobState->nextStatesFirst > header->transitionCount - blobState->nextStatesCount)
+        {
+            valid = false;
+            break;
+        }
+        config->nextStates = blobState->nextStatesCount ? &transitions[blobState->nextStatesFirst] : NULL;
+        config->nextStatesCount = (int)blobState->nextStatesCount;
+        config->transitionMask = blobState->transitionMask & ((1u << STATE_COUNT) - 1);
+        config->eventMask = blobState->eventMask & ((1u << EVENT_COUNT) - 1);
+    }
+
+    free(bound);
+
+    if (!valid)
+        fprintf(stderr, "%s: failed to bind FSM graph\n", graph->path);
+    return valid;
+}
+
+// Loads and binds a graph, NULL on failure
+static FsmGraph *LoadFsmGraph(const char *path)
+{
+    FsmGraph *graph = (FsmGraph *)calloc(1, sizeof(FsmGraph));
+    if (!graph)
+    {
+        fprintf(stderr, "Failed to allocate FSM graph\n");
+        exit(1);
+    }
+
+    graph->path = path;
+    graph->data = MapFile(path, &graph->size, &graph->mapped);
+    if (!graph->data)
+    {
+        printf("FSM graph %s not found, building state tables at runtime\n", path);
+        free(graph);
+        return NULL;
+    }
+
+    if (!BindFsmGraph(graph))
+    {
+        UnmapFile(graph->data, graph->size, graph->mapped);
+        free(graph);
+        return NULL;
+    }
+
+    printf("FSM graph %s loaded (%zu bytes)\n", path, graph->size);
+    return graph;
+}
+
+/**
+ * GetFsmGraph - Returns the shared, precompiled FSM graph stored in a blob.
+ *
+ * @path: Path of the .fsmb blob produced by tools/fsm_compiler.
+ *
+ * The blob is mapped and bound the first time it is requested, later calls (e.g.,
+ * one per spawned object) only return the cached graph. A missing or invalid blob
+ * is remembered too, so callers fall back to building tables at runtime once.
+ *
+ * Return: The graph, or NULL if the blob is missing or invalid.
+ */
+FsmGraph *GetFsmGraph(const char *path)
+{
+    for (int i = 0; i < graphCount; i++)
+    {
+        if (strcmp(graphs[i].path, path) == 0)
+            return graphs[i].graph;
+    }
+
+    FsmGraph *graph = LoadFsmGraph(path);
+
+    if (graphCount < MAX_FSM_GRAPHS)
+    {
+        snprintf(graphs[graphCount].path, sizeof(graphs[graphCount].path), "%s", path);
+        graphs[graphCount].graph = graph;
+        if (graph)
+            graph->path = graphs[graphCount].path;
+        graphCount++;
+    }
+    else if (graph)
+    {
+        // Nowhere to cache it, do not leak the mapping
+        UnmapFile(graph->data, graph->size, graph->mapped);
+        free(graph);
+        graph = NULL;
+    }
+
+    return graph;
+}
+
+/**
+ * UnloadFsmGraphs - Unmaps every loaded graph and clears the handler registry.
+ *
+ * Must only be called once no GameObject uses a shared state table any more.
+ */
+void UnloadFsmGraphs()
+{
+    for (int i = 0; i < graphCount; i++)
+    {
+        FsmGraph *graph = graphs[i].graph;
+        if (graph)
+        {
+            UnmapFile(graph->data, graph->size, graph->mapped);
+            free(graph);
+        }
+    }
+    graphCount = 0;
+
+    free(registry);
+    registry = NULL;
+    registryCount = 0;
+    registryCapacity = 0;
+}
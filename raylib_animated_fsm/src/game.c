@@ -1,7 +1,192 @@
 #include <stdio.h>
+#include <string.h>
+#include <math.h>
 #include <raylib.h>
 
 #include "../include/game/game.h"
+#include "../include/utils/constants.h"
+#include "../include/utils/scheduler.h"
+#include "../include/utils/ai_system.h"
+#include "../include/utils/crowd.h"
+#include "../include/utils/squad.h"
+#include "../include/utils/perception.h"
+#include "../include/utils/job_pool.h"
+#include "../include/fsm/fsm_loader.h"
+#include "../include/render/sprite_batch.h"
+#include "../include/render/texture_atlas.h"
+#include "../include/render/world_camera.h"
+#include "../include/render/hud.h"
+#include "../include/render/overlay_batch.h"
+#include "../include/render/sprite_instancing.h"
+
+// What the AI decided and deferred since the last log line
+static AIThinkReport reportTotal = {0};
+static float reportElapsed = 0.0f;
+
+// Seconds between an NPC's decisions, NPCs of the default aggression (50) decide
+// every AI_THINK_INTERVAL and more aggressive ones more often
+static float GetNPCThinkInterval(const NPC *npc)
+{
+    return npc->aggression > 0 ? AI_THINK_INTERVAL * 50.0f / npc->aggression : AI_THINK_INTERVAL;
+}
+
+/**
+ * SpawnNPC - Creates an NPC and adds it to the game.
+ *
+ * @gameData: A pointer to the GameData structure containing the game state.
+ * @name:     The name of the NPC.
+ * @position: Where the NPC spawns.
+ * @squad:    The squad the NPC joins (SQUAD_NONE if it decides alone).
+ *
+ * The NPC joins the update set and the AI system, its first decision is one
+ * think interval away.
+ * Only called outside of update phases (at startup or when commands are applied).
+ */
+static void SpawnNPC(GameData *gameData, const char *name, Vector2 position, int squad)
+{
+    if (gameData->npcCount == MAX_NPCS)
+    {
+        printf("Cannot spawn %s, %d NPCs already alive\n", name, MAX_NPCS);
+        return;
+    }
+
+    NPC *npc = InitNPC(name, position);
+    gameData->npcs[gameData->npcCount++] = npc;
+
+    ScheduleGameObject(&npc->base);
+
+    // NPC AI decisions are made by the AI system from here on, within its squad's plan
+    AddAIAgent(&npc->base, GetNPCBehaviourTree(), GetNPCThinkInterval(npc), npc->aggression);
+    JoinSquad(&npc->base, squad);
+}
+
+/**
+ * SpawnNPCPack - Creates a pack of NPCs acting as one squad.
+ *
+ * @gameData: A pointer to the GameData structure containing the game state.
+ * @names:    The names of the NPCs (strings that outlive the game, e.g., literals).
+ * @count:    The number of NPCs, at most MAX_SQUAD_MEMBERS.
+ * @center:   Where the pack spawns, its NPCs spawn around it.
+ *
+ * Only called outside of update phases (at startup or when commands are applied).
+ */
+static void SpawnNPCPack(GameData *gameData, const char *const *names, int count, Vector2 center)
+{
+    int squad = CreateSquad();
+
+    for (int i = 0; i < count; i++)
+    {
+        float angle = 2.0f * PI * i / count;
+        Vector2 offset = {NPC_PACK_SPAWN_RADIUS * cosf(angle), NPC_PACK_SPAWN_RADIUS * sinf(angle)};
+        SpawnNPC(gameData, names[i], Vector2Add(center, offset), squad);
+    }
+}
+
+/**
+ * DespawnNPC - Removes an NPC from the game and deletes it.
+ *
+ * @gameData: A pointer to the GameData structure containing the game state.
+ * @obj:      The GameObject (NPC) to remove.
+ *
+ * The remaining NPCs keep their spawn order. The NPC stops making decisions, and
+ * deleting it also cancels its timers and removes it from the scheduler.
+ */
+static void DespawnNPC(GameData *gameData, GameObject *obj)
+{
+    for (int i = 0; i < gameData->npcCount; i++)
+    {
+        if (&gameData->npcs[i]->base == obj)
+        {
+            memmove(&gameData->npcs[i], &gameData->npcs[i + 1], sizeof(NPC *) * (gameData->npcCount - i - 1));
+            gameData->npcCount--;
+            RemoveAIAgent(obj);
+            DeleteNPC(obj);
+            return;
+        }
+    }
+}
+
+/**
+ * ApplyEntityCommands - Applies the structural changes recorded during the update.
+ *
+ * @gameData: A pointer to the GameData structure containing the game state.
+ *
+ * This is the sync point: nothing iterates the objects while the commands run.
+ * Commands are sorted by entity id and then by recording order, so the result
+ * does not depend on which system recorded first. Commands for an entity that has
+ * been despawned and stale state changes are skipped. Commands recorded while
+ * applying (e.g., by an Entry function) are applied at the next sync point.
+ */
+static void ApplyEntityCommands(GameData *gameData)
+{
+    EntityCommandBuffer *buffer = gameData->commands;
+    int count = buffer->count;
+    int despawnedId = -1;
+
+    SortEntityCommands(buffer);
+
+    for (int i = 0; i < count; i++)
+    {
+        // Copy, applying a command may record new ones and grow the buffer
+        EntityCommand command = buffer->commands[i];
+
+        if (command.entityId == despawnedId || IsEntityCommandStale(&command))
+        {
+            continue;
+        }
+
+        switch (command.type)
+        {
+            case ENTITY_COMMAND_SPAWN_NPC:
+                SpawnNPC(gameData, command.name, command.position, command.squad);
+                break;
+            case ENTITY_COMMAND_CHANGE_STATE:
+                ChangeState(command.target, command.state);
+                break;
+            case ENTITY_COMMAND_DESPAWN:
+                DespawnNPC(gameData, command.target);
+                despawnedId = command.entityId;
+                break;
+        }
+    }
+
+    DiscardEntityCommands(buffer, count);
+}
+
+/**
+ * CreateBackgroundTilemap - Creates the tilemap covering the world.
+ *
+ * @tileset: The background image, cut into BACKGROUND_TILE_SIZE tiles.
+ *
+ * The ground layer repeats the tileset's cells across the world, so the map
+ * looks like the background image tiled over it. Level tiles are set here,
+ * before the frame pipeline starts drawing.
+ */
+static Tilemap *CreateBackgroundTilemap(Texture2D tileset)
+{
+    const int columns = (WORLD_WIDTH + BACKGROUND_TILE_SIZE - 1) / BACKGROUND_TILE_SIZE;
+    const int rows = (WORLD_HEIGHT + BACKGROUND_TILE_SIZE - 1) / BACKGROUND_TILE_SIZE;
+    const int tilesetColumns = tileset.width / BACKGROUND_TILE_SIZE;
+    const int tilesetRows = tileset.height / BACKGROUND_TILE_SIZE;
+
+    Tilemap *tilemap = CreateTilemap(tileset, BACKGROUND_TILE_SIZE, columns, rows);
+
+    if (tilesetColumns <= 0 || tilesetRows <= 0)
+    {
+        return tilemap; // Background failed to load, the ground stays empty
+    }
+
+    for (int row = 0; row < rows; row++)
+    {
+        for (int column = 0; column < columns; column++)
+        {
+            int tile = (row % tilesetRows) * tilesetColumns + column % tilesetColumns;
+            SetTile(tilemap, TILEMAP_LAYER_GROUND, column, row, tile);
+        }
+    }
+
+    return tilemap;
+}
 
 /**
  * InitGame - Initializes the game, setting up the player, NPC, and mediator.
@@ -16,107 +201,201 @@ void InitGame(GameData *gameData)
 {
     printf("Game Initialized!\n");
 
+    // Timers must be available before objects schedule state timeouts
+    InitTimerWheel();
+    InitScheduler();
+    InitSpriteBatch();
+    InitOverlayBatch();
+    InitAnimationSystem();
+    InitHud();
+
+    // NPC decisions are made in parallel on the job pool
+    InitJobPool();
+    InitAISystem();
+    InitNPCBehaviourTree();
+    reportTotal = (AIThinkReport){0};
+    reportElapsed = 0.0f;
+
+    // Walking NPCs are steered as a crowd, on the job pool too
+    InitCrowd();
+
+    // The AI reads the world through the facts published each update
+    InitPerception();
+
+    // Packs of NPCs decide together, their members refine the squad's plan
+    InitSquads();
+
+    // Handlers must be registered before the first object loads its compiled FSM graph
+    RegisterPlayerFSMHandlers();
+    RegisterNPCFSMHandlers();
+
+    // Pack the frames the animation clips use into the texture atlas before any object takes its texture
+    RegisterPlayerAnimationClips();
+    RegisterNPCAnimationClips();
+    BuildTextureAtlas();
+
+#ifdef SPRITE_INSTANCING
+    // NPCs are drawn instanced, the GPU picks their frames (falls back to the sprite batch if unsupported)
+    InitNPCSpriteInstancing();
+#endif
+
+    // Spawns, despawns and state changes requested during an update are applied at its end
+    gameData->commands = CreateEntityCommandBuffer();
+    SetDeferredCommands(gameData->commands);
+
     // Initialize the player and NPC with their respective names
     gameData->player = InitPlayer("Player Hero");
-    gameData->npc = InitNPC("Skynet");
+    gameData->npcCount = 0;
+    static const char *const packNames[] = {"Skynet", "HAL", "Ultron", "GLaDOS"};
+    SpawnNPCPack(gameData, packNames, sizeof(packNames) / sizeof(packNames[0]),
+                 (Vector2){WORLD_WIDTH / 2.0f, WORLD_HEIGHT / 2.0f - 200.0f});
+
+    // Objects in the update set are updated every tick while awake, the player
+    // is the focus that wakes nearby sleepers
+    ScheduleGameObject(&gameData->player->base);
+    SetSchedulerFocus(&gameData->player->base);
 
     // Create a mediator to facilitate communication between
     // Command and FSM, ultimately updating the playes state
     gameData->mediator = CreateMediator(&gameData->player->base);
     gameData->backgroundTexture = LoadTexture("assets/background.jpg");
+    gameData->tilemap = CreateBackgroundTilemap(gameData->backgroundTexture);
+
+    // One flow field toward the player serves every chasing NPC
+    gameData->chaseField = CreateFlowField((WORLD_WIDTH + FLOW_FIELD_CELL_SIZE - 1) / FLOW_FIELD_CELL_SIZE,
+                                           (WORLD_HEIGHT + FLOW_FIELD_CELL_SIZE - 1) / FLOW_FIELD_CELL_SIZE,
+                                           FLOW_FIELD_CELL_SIZE);
+    UpdateFlowField(gameData->chaseField, gameData->player->base.position);
 
+    // The camera follows the player around the world
+    InitWorldCamera(gameData->player->base.position);
+}
+
+/**
+ * UpdateAnimationLod - Picks how often each NPC's animation is advanced.
+ *
+ * @gameData: A pointer to the GameData structure containing the game state.
+ *
+ * NPCs that could be on screen animate every tick, those just outside the view
+ * at a reduced rate, and the rest are frozen until they come close again, when
+ * their animation catches up on the time it missed. Only positions are tested,
+ * reading a frame would catch a frozen animation up. The player is always on
+ * screen and stays at full rate.
+ */
+static void UpdateAnimationLod(GameData *gameData)
+{
+    for (int i = 0; i < gameData->npcCount; i++)
+    {
+        GameObject *npc = &gameData->npcs[i]->base;
+
+        AnimationLod lod = ANIMATION_LOD_FROZEN;
+        if (IsWorldPointNearView(npc->position, SPRITE_CULL_MARGIN))
+            lod = ANIMATION_LOD_FULL;
+        else if (IsWorldPointNearView(npc->position, ANIMATION_LOD_REDUCED_MARGIN))
+            lod = ANIMATION_LOD_REDUCED;
+
+        SetAnimationCursorLod(npc->animation.cursor, lod);
+    }
+}
+
+// Sums the AI system's report of this update and logs the sums every AI_REPORT_INTERVAL
+static void LogAIThinkReport(float dt)
+{
+    AIThinkReport report = GetAIThinkReport();
+    reportTotal.due += report.due;
+    reportTotal.thought += report.thought;
+    reportTotal.deferred += report.deferred;
+    reportTotal.milliseconds += report.milliseconds;
+    reportTotal.longestWait = fmaxf(reportTotal.longestWait, report.longestWait);
+
+    reportElapsed += dt;
+    if (reportElapsed < AI_REPORT_INTERVAL)
+        return;
+
+    printf("AI: %d agents, %d due, %d decided, %d deferred (longest wait %.2fs), %.2fms deciding\n",
+           GetAIAgentCount(), reportTotal.due, reportTotal.thought, reportTotal.deferred, reportTotal.longestWait,
+           reportTotal.milliseconds);
+    reportTotal = (AIThinkReport){0};
+    reportElapsed = 0.0f;
 }
 
 /**
  * UpdateGame - Updates the game state by handling player input, NPC behavior,
  *              and updating entities based on their current states.
  *
- * This function updates the player’s state, processes AI behavior for the NPC,
- * and triggers appropriate state changes via commands. The NPC's behavior is
- * randomly determined every second.
+ * This function updates the player’s state, advances the timer wheel (which
+ * fires state timeouts), makes the NPC AI decisions that are due, and triggers appropriate state
+ * changes via commands. It does not touch the window, so it can run on a thread
+ * other than the one input is polled and frames are drawn on.
  *
  * @gameData: A pointer to the GameData structure containing the game state.
+ * @command:  The command polled from the user's input this frame.
+ * @dt:       Seconds since the last update.
  */
-void UpdateGame(GameData *gameData)
+void UpdateGame(GameData *gameData, Command command, float dt)
 {
-    DrawText("Game Updating...", 190, 260, 20, DARKBLUE);
-
-    // Poll input from the user and execute the corresponding command
-    Command command = PollInput();
+    // Execute the command polled from the user's input
     ExecuteCommand(command, gameData->mediator); // Execute the command via the mediator
 
-    // Update the player's state based on its current configuration
-    UpdateState(&gameData->player->base);
+    // Fire any timers due in this update's time (state timeouts, cooldowns, wake-ups)
+    AdvanceTimerWheel(dt);
 
-    // Simple random behavior for NPC AI (not truly an AI, just random selection)
-    // Static variable to track the last AI action time
-    static float lastAITime = 0.0f;
+    // What the AI knows about the world this update, worked out once for every agent
+    PublishWorldFacts(&gameData->player->base, gameData->npcs, gameData->npcCount);
+    const WorldFacts *facts = GetWorldFacts();
 
-    // Check if 1 second has passed since the last AI action
-    if (GetTime() - lastAITime >= 1.0f)
-    {
-        // Poll and execute random commands for the NPC (simulate AI actions)
-        printf("\n#######################################\n");
-        printf("\t%s Handle AI Events", gameData->npc->base.name);
-        printf("\n#######################################\n");
-
-        // Randomly select a command for the NPC
-        command = PollAI();
-        switch (command)
-        {
-            case COMMAND_NONE:
-                HandleEvent((GameObject *)gameData->npc, EVENT_NONE);
-                break;
-            case COMMAND_MOVE_UP:
-                HandleEvent((GameObject *)gameData->npc, EVENT_MOVE_UP);
-                break;
-            case COMMAND_MOVE_DOWN:
-                HandleEvent((GameObject *)gameData->npc, EVENT_MOVE_DOWN);
-                break;
-            case COMMAND_MOVE_LEFT:
-                HandleEvent((GameObject *)gameData->npc, EVENT_MOVE_LEFT);
-                break;
-            case COMMAND_MOVE_RIGHT:
-                HandleEvent((GameObject *)gameData->npc, EVENT_MOVE_RIGHT);
-                break;
-            case COMMAND_ATTACK:
-                HandleEvent((GameObject *)gameData->npc, EVENT_ATTACK);
-                break;
-            case COMMAND_COLLISION_START:
-                HandleEvent((GameObject *)gameData->npc, EVENT_DIE);
-                break;
-            case COMMAND_COLLISION_END:
-                HandleEvent((GameObject *)gameData->npc, EVENT_RESPAWN);
-                break;
-            default:
-                break;
-        }
+    // Lead the chase field to the player, only rebuilt when the player changed cell
+    UpdateFlowField(gameData->chaseField, facts->playerPosition);
 
-        // Update the last AI execution time
-        lastAITime = GetTime();
-    }
+    // One decision per squad that is due, its members refine it in their own decisions
+    UpdateSquads(dt);
 
-    // Update the NPC's state after handling the event
-    UpdateState(&gameData->npc->base);
+    // NPC decisions due this update, made across the job pool and handled in entity id order
+    UpdateAISystem(dt);
+    LogAIThinkReport(dt);
 
-    // Check for collisions between player and NPC
-    if (CheckCollision(&gameData->player->base, &gameData->npc->base))
-    {
-        if (gameData->player->base.currentState != STATE_COLLISION)
-        {
-            HandleEvent(&gameData->player->base, EVENT_COLLISION_START);
-        }
+    // Steer the walking NPCs along the chase field and around each other, they move in their update
+    UpdateCrowd(gameData->chaseField);
+
+    // Update the awake objects, sleeping objects cost nothing until they are woken
+    UpdateScheduledObjects();
 
-        // Try to push back player
-        HandleCollision(&gameData->player->base, &gameData->npc->base);
+    // Advance every object's animation in one pass (awake or asleep), off screen ones less often
+    UpdateAnimationSystem(dt);
+
+    // Check for collisions between player and NPCs
+    for (int i = 0; i < gameData->npcCount; i++)
+    {
+        GameObject *npc = &gameData->npcs[i]->base;
 
-        // Ensure that we are separated after handling the collision
-        if (!CheckCollision(&gameData->player->base, &gameData->npc->base))
+        if (CheckCollision(&gameData->player->base, npc))
         {
-            printf("Transitioning back to STATE_IDLE state from STATE_COLLISION\n");
-            HandleEvent(&gameData->player->base, EVENT_NONE); // Ideally a EVENT_COLLISION_END
+            if (gameData->player->base.currentState != STATE_COLLISION)
+            {
+                HandleEvent(&gameData->player->base, EVENT_COLLISION_START);
+            }
+
+            // Try to push back player
+            HandleCollision(&gameData->player->base, npc);
+
+            // Ensure that we are separated after handling the collision
+            if (!CheckCollision(&gameData->player->base, npc))
+            {
+                printf("Transitioning back to STATE_IDLE state from STATE_COLLISION\n");
+                HandleEvent(&gameData->player->base, EVENT_NONE); // Ideally a EVENT_COLLISION_END
+            }
         }
     }
+
+    // Sync point, apply the spawns, despawns and state changes recorded this update
+    ApplyEntityCommands(gameData);
+
+    // Follow the player once everything has moved
+    UpdateWorldCamera(gameData->player->base.position);
+
+    // Animation rates for the next update, from what the camera now sees
+    UpdateAnimationLod(gameData);
+
     /* else if (&gameData->player->base.currentState == STATE_COLLISION)
     {
         printf("Transitioning back to STATE_IDLE state from STATE_COLLISION\n");
@@ -124,93 +403,112 @@ void UpdateGame(GameData *gameData)
     } */
 }
 
+// Draws a health bar above a game object, only if it is damaged or targeted
+static void DrawHealthBar(const GameObject *obj, bool targeted)
+{
+    if (obj->health >= 100 && !targeted)
+        return;
+
+    const float healthBarWidth = 100.0f;
+    const float healthBarHeight = 10.0f;
+    const float healthBarX = obj->position.x - (healthBarWidth / 2); // Position health bar above the object
+    const float healthBarY = obj->position.y - 40;
+
+    // Calculate health percentage (for drawing the health bar)
+    float healthPercentage = Clamp((float)obj->health / 100, 0.0f, 1.0f);
+
+    // Draw the background of the health bar (gray)
+    SubmitOverlayRect((Rectangle){healthBarX, healthBarY, healthBarWidth, healthBarHeight}, GRAY);
+
+    // Draw the health bar foreground (green based on current health)
+    SubmitOverlayRect((Rectangle){healthBarX, healthBarY, healthBarWidth * healthPercentage, healthBarHeight}, GREEN);
+}
+
+#ifdef DEBUG
+// Outlines an object's collider (debug builds only)
+static void DrawColliderDebug(const GameObject *obj)
+{
+    SubmitOverlayCircleLines((Vector2){obj->collider.p.x, obj->collider.p.y}, obj->collider.r, 1.0f, YELLOW);
+}
+#endif
+
+// Gets the world rectangle an object draws to (its current frame and health bar)
+static Rectangle GetDrawBounds(const GameObject *obj)
+{
+    Rectangle frame = obj->animation.frameCount > 0 ? obj->animation.frames[GetAnimationFrame(&obj->animation)] : (Rectangle){0};
+    const float halfWidth = fmaxf(fabsf(frame.width) / 2.0f, 50.0f); // Health bar is 100 wide
+    const float top = fminf(obj->position.y - fabsf(frame.height) / 2.0f, obj->position.y - 40.0f);
+    const float bottom = obj->position.y + fabsf(frame.height) / 2.0f;
+
+    return (Rectangle){obj->position.x - halfWidth, top, 2.0f * halfWidth, bottom - top};
+}
+
 /**
- * DrawGame - Draws the game elements to the screen (player, NPC, health bar, etc.).
+ * BuildRenderSnapshot - Records the game elements to draw (player, NPC, health bar, etc.).
  *
- * This function handles drawing the player, NPC, health bars, and other UI
- * elements like the game title. It also handles rendering the player’s animation.
+ * The player, NPCs, health bars and HUD values are recorded into a snapshot that
+ * DrawRenderSnapshot draws later, possibly on another thread while the next update
+ * runs. Objects outside the camera's view are culled before anything is submitted,
+ * the sprites are sorted by y when they are taken from the batch.
  *
  * @gameData: A pointer to the GameData structure containing the game state.
+ * @snapshot: The snapshot to fill, its previous contents are replaced.
  */
-void DrawGame(GameData *gameData)
+void BuildRenderSnapshot(GameData *gameData, RenderSnapshot *snapshot)
 {
-    DrawText("Raylib Animated FSM Starter Kit!", 190, 180, 20, DARKBLUE);
-
-    // Begin drawing to the screen
-    BeginDrawing();
-
-    // Clear the screen with a white background
-    DrawTexture(gameData->backgroundTexture, -40, 0, WHITE);
-
-    // Draw some basic UI text (game title and description)
-//    DrawText("Welcome to Raylib Animated FSM Starter", 190, 200, 20, LIGHTGRAY);
-//    DrawText("Gameplay Programming I", 190, 220, 20, LIGHTGRAY)
-    const char *livesText = TextFormat("%d", gameData->player->lives);
-    DrawText("LIVES:", 550, 23, 40, WHITE);
-    DrawText(livesText, 690, 23, 40, WHITE);
-/*    const  char *staminaText = TextFormat("%d.0f", gameData->player->stamina);
-    DrawText("stamina:", 550, 100, 40, WHITE);
-    DrawText(staminaText, 690, 100, 40, WHITE);
-    const char *ManaText = TextFormat("%d.0f", gameData->player->mana);
-    DrawText("Mana:", 550, 200, 40, WHITE);
-    DrawText(ManaText, 690, 200, 40, WHITE);*/
-    // Drawing Player and Position Data˳
-//    const char *infoPosition = TextFormat("(%.f, %.f)", gameData->player->base.position.x, gameData->player->base.position.y);
-
-  /*  // Draw a circle representing the player at their position
-    DrawCircleLines(gameData->player->base.position.x, gameData->player->base.position.y, 20, gameData->player->base.color);
-    // Draw text showing player position below the player
-    DrawText(infoPosition,
-             gameData->player->base.position.x - (MeasureText(infoPosition, 20) / 2),
-             gameData->player->base.position.y + 30,
-             20, DARKBLUE);*/
-
-    // Drawing Health Bar for the player
-    const int healthBarWidth = 100;
-    const int healthBarHeight = 10;
-    const int healthBarX = gameData->player->base.position.x - (healthBarWidth / 2); // Position health bar above the player
-    const int healthBarY = gameData->player->base.position.y - 40;
+    // The world is drawn through the camera, only what it sees is submitted
+    snapshot->camera = GetWorldCamera();
+    snapshot->view = GetWorldView();
+    snapshot->tilemap = gameData->tilemap;
 
-    // Calculate health percentage (for drawing the health bar)
-    float healthPercentage = (float)gameData->player->base.health / 100;
+    // Sprites are collected and sorted by y so lower objects overlap higher ones
+    BeginSpriteBatch();
 
-    // Draw the background of the health bar (gray)
-    DrawRectangle(healthBarX, healthBarY, healthBarWidth, healthBarHeight, GRAY);
+    // Health bars, the shield and debug shapes are collected too and drawn over the sprites in one draw call
+    BeginOverlayBatch();
 
-    // Draw the health bar foreground (green based on current health)
-    DrawRectangle(healthBarX, healthBarY, healthBarWidth * healthPercentage, healthBarHeight, GREEN);
-
-//    // Drawing NPC and Position Data
-//    infoPosition = TextFormat("(%.f, %.f)", gameData->npc->base.position.x, gameData->npc->base.position.y);
-//
-//    // Draw the NPC circle at their position
-//    DrawCircle(gameData->npc->base.position.x, gameData->npc->base.position.y, 20, gameData->npc->base.color);
-//    // Render the npc's animation at their current position
-// Drawing Health Bar for the player
-    const int nhealthBarX = gameData->npc->base.position.x - (healthBarWidth / 2); // Position health bar above the player
-    const int nhealthBarY = gameData->npc->base.position.y - 40;
-
-    // Calculate health percentage (for drawing the health bar)
-    float nhealthPercentage = (float)gameData->npc->base.health / 100;
+    Player *player = gameData->player;
 
-    // Draw the background of the health bar (gray)
-    DrawRectangle(nhealthBarX, nhealthBarY, healthBarWidth, healthBarHeight, GRAY);
+    // Recording Health Bars and NPCs
+    for (int i = 0; i < gameData->npcCount; i++)
+    {
+        GameObject *npc = &gameData->npcs[i]->base;
 
-    // Draw the health bar foreground (green based on current health)
-    DrawRectangle(nhealthBarX, nhealthBarY, healthBarWidth * nhealthPercentage, healthBarHeight, GREEN);
-    RenderAnimation(&gameData->npc->base.animation, gameData->npc->base.position, RAYWHITE);
+        // An instanced NPC is only uploaded again if it moved
+        SetSpriteInstancePosition(npc->spriteInstance, npc->position);
 
-//    // Draw text showing NPC position below the NPC
-//    DrawText(infoPosition,
-//             gameData->npc->base.position.x - (MeasureText(infoPosition, 20) / 2),
-//             gameData->npc->base.position.y + 30,
-//             20, DARKBLUE);
+        // Far NPCs are culled on position alone, their frame is not read (or caught up)
+        if (!IsWorldPointNearView(npc->position, SPRITE_CULL_MARGIN) || !IsWorldRectVisible(GetDrawBounds(npc)))
+            continue;
 
-    // Render the player's animation at their current position
-    RenderAnimation(&gameData->player->base.animation, gameData->player->base.position, WHITE);
+        bool targeted = Vector2Distance(npc->position, player->base.position) <= HEALTH_BAR_TARGET_RANGE;
+        DrawHealthBar(npc, targeted);
+        RenderGameObject(npc, RAYWHITE);
+#ifdef DEBUG
+        DrawColliderDebug(npc);
+#endif
+    }
 
-    // End drawing to the screen
-    EndDrawing();
+    // Recording the player's shield, health bar and animation at their current position
+    if (player->shieldActive)
+    {
+        SubmitOverlayCircle(player->base.position, player->shieldRadius, player->shieldColor);
+    }
+    DrawHealthBar(&player->base, false);
+    RenderGameObject(&player->base, WHITE);
+#ifdef DEBUG
+    DrawColliderDebug(&player->base);
+#endif
+
+    // Move everything recorded into the snapshot
+    TakeSpriteBatch(&snapshot->sprites);
+    TakeOverlayBatch(&snapshot->overlays);
+
+    // The HUD is only redrawn when one of these changes
+    snapshot->hudValues[HUD_VALUE_LIVES] = gameData->player->lives;
+    snapshot->hudValues[HUD_VALUE_HEALTH] = gameData->player->base.health;
+    snapshot->hudValues[HUD_VALUE_STAMINA] = (int)gameData->player->stamina;
+    snapshot->hudValues[HUD_VALUE_MANA] = (int)gameData->player->mana;
 }
 
 /**
@@ -250,14 +548,55 @@ void DeleteGameData(GameData *gameData)
             DeletePlayer(&gameData->player->base);
         }
 
-        if (gameData->npc != NULL)
+        for (int i = 0; i < gameData->npcCount; i++)
         {
-            DeleteNPC(&gameData->npc->base);
+            DeleteNPC(&gameData->npcs[i]->base);
         }
+        gameData->npcCount = 0;
 
         if (gameData->mediator != NULL)
         {
             DeleteMediator(gameData->mediator);
         }
+
+        // Commands still pending refer to deleted objects
+        DeleteEntityCommandBuffer(gameData->commands);
+        gameData->commands = NULL;
+
+        // Releases the chunk textures (the render thread has stopped), then the tileset they were drawn from
+        DeleteTilemap(gameData->tilemap);
+        gameData->tilemap = NULL;
+        UnloadTexture(gameData->backgroundTexture);
+        gameData->backgroundTexture = (Texture2D){0};
+
+        // Nothing is steered along the chase field any more
+        DeleteFlowField(gameData->chaseField);
+        gameData->chaseField = NULL;
     }
+
+    ExitSpriteInstancing();
+    ExitHud();
+    ExitOverlayBatch();
+
+    // Every object released its animation cursor when it was deleted
+    ExitAnimationSystem();
+    ExitSpriteBatch();
+
+    // No object draws from the atlas any more
+    UnloadTextureAtlas();
+
+    // All timer targets are gone, release the scheduler and the timer pool
+    ExitScheduler();
+    ExitTimerWheel();
+
+    // The agents' objects are gone, stop the workers
+    ExitAISystem();
+    ExitCrowd();
+    ExitSquads();
+    ExitPerception();
+    ExitJobPool();
+    ExitNPCBehaviourTree();
+
+    // No object uses the shared state tables any more
+    UnloadFsmGraphs();
 }
@@ -1,5 +1,9 @@
 #include "../include/gameobjects/gameobject.h"
 #include "../include/utils/constants.h"
+#include "../include/utils/scheduler.h"
+#include "../include/utils/crowd.h"
+#include "../include/utils/squad.h"
+#include "../include/render/sprite_instancing.h"
 
 // Specific define for CUTE_HEADERS, enabling implementation of functions
 #define CUTE_C2_IMPLEMENTATION
@@ -15,6 +19,9 @@
 #pragma GCC diagnostic pop
 #endif
 
+// Next entity id, ids are never reused so stale references can be detected
+static int nextGameObjectId = 0;
+
 /**
  * @brief Initializes a GameObject with default values and assigns a name.
  *
@@ -49,8 +56,10 @@ void InitGameObject(GameObject *obj,
                     int health,
                     float speed)
 {
-    // Set the GameObject's name
+    // Set the GameObject's name and a unique id (orders deferred commands, see entity_commands.h)
     obj->name = name;
+    obj->id = nextGameObjectId++;
+    InitRandomStream(&obj->animationRandom, RANDOM_SYSTEM_ANIMATION, obj->id);
 
     obj->position = position;
     obj->velocity = velocity;
@@ -63,8 +72,29 @@ void InitGameObject(GameObject *obj,
     obj->collider = collider;
     obj->bounds = bounds;
     obj->keyframes = keyframes;
+    obj->animation = (AnimationData){0};
+    obj->animation.cursor = ANIMATION_CURSOR_NONE; // Acquired by the first InitGameObjectAnimation
+    obj->spriteInstance = SPRITE_INSTANCE_NONE;
     obj->health = health;
     obj->speed = speed;
+    obj->stateConfigs = NULL;
+    obj->sharedStateConfigs = false;
+    obj->archetype = FSM_ARCHETYPE_DYNAMIC;
+    obj->stateTimer = TIMER_HANDLE_NONE;
+
+    // Awake, but not updated until the object is added to the scheduler
+    obj->asleep = false;
+    obj->sleepTick = 0;
+    obj->updateSlot = -1;
+    obj->sleepEntry = -1;
+    obj->wakeRadius = 0.0f;
+    obj->wakeTimer = TIMER_HANDLE_NONE;
+
+    // Not steered until it joins the crowd, decides alone until it joins a squad
+    obj->crowdSlot = -1;
+    obj->squad = SQUAD_NONE;
+    obj->hasMoveGoal = false;
+    obj->moveGoal = position;
 }
 
 /**
@@ -77,13 +107,41 @@ void InitGameObject(GameObject *obj,
  * @speed: The speed at which the animation should play (frame duration in seconds).
  *
  * This function initializes the animation data for the GameObject, setting up the
- * texture, frames, and speed, and ensures the animation will loop.
+ * texture, frames, and speed, and ensures the animation will loop. The object keeps
+ * its playback cursor across clips.
+ *
+ * An object drawn by the sprite instancing only has its instance's clip changed,
+ * the GPU picks the frames, so its cursor is stopped.
  */
 void InitGameObjectAnimation(GameObject *obj, Rectangle *frames, int frameCount, float speed)
 {
-    AnimationData animation;
-    InitAnimation(&animation, obj->keyframes, frames, frameCount, speed, true);
-    obj->animation = animation;
+    InitAnimation(&obj->animation, obj->keyframes, frames, frameCount, speed, true);
+
+    if (obj->spriteInstance != SPRITE_INSTANCE_NONE)
+    {
+        SetSpriteInstanceClip(obj->spriteInstance, FindSpriteInstanceClip(frames, frameCount), speed);
+        SetAnimationCursorPlaying(obj->animation.cursor, false);
+    }
+}
+
+/**
+ * RenderGameObject - Renders the game object's current animation frame.
+ *
+ * @obj:  The GameObject to render.
+ * @tint: The tint applied to the sprite.
+ *
+ * The animation system advances every object's animation, sleeping or not, so the
+ * current frame is always up to date. Objects with a sprite instance are skipped,
+ * DrawSpriteInstancesBefore draws them.
+ */
+void RenderGameObject(const GameObject *obj, Color tint)
+{
+    if (obj->spriteInstance != SPRITE_INSTANCE_NONE)
+    {
+        return;
+    }
+
+    RenderAnimation(&obj->animation, obj->position, tint);
 }
 
 /**
@@ -196,8 +254,18 @@ void DeleteGameObject(GameObject *obj)
     if (obj == NULL)
         return;
 
-    // Check if state configurations exist for this GameObject
-    if (obj->stateConfigs)
+    // Stop updating the object and make sure no pending timer fires into it
+    UnscheduleGameObject(obj);
+    CancelTimersForGameObject(obj);
+    RemoveCrowdAgent(obj);
+    LeaveSquad(obj);
+    ReleaseAnimation(&obj->animation);
+    RemoveSpriteInstance(obj->spriteInstance);
+    obj->spriteInstance = SPRITE_INSTANCE_NONE;
+
+    // Check if state configurations exist for this GameObject (shared graphs are
+    // owned by the FSM loader)
+    if (obj->stateConfigs && !obj->sharedStateConfigs)
     {
         // Free each state's nextStates array if it exists
         for (int i = 0; i < STATE_COUNT; i++)
@@ -0,0 +1,102 @@
+#include <raylib.h>
+
+#include "../include/render/hud.h"
+
+// HUD drawn once into a texture and composited over every frame
+static RenderTexture2D target = {0};
+
+// Values the texture was last drawn with
+static int values[HUD_VALUE_COUNT] = {0};
+
+// Set when a value changes, the texture is redrawn on the next DrawHud
+static bool dirty = true;
+
+/**
+ * InitHud - Initialises the HUD.
+ *
+ * The HUD is rasterised into a screen sized render texture only when one of its
+ * values changes, every other frame just draws the texture. Text is no longer
+ * formatted and rasterised every frame.
+ */
+void InitHud()
+{
+    target = LoadRenderTexture(GetScreenWidth(), GetScreenHeight());
+
+    for (int i = 0; i < HUD_VALUE_COUNT; i++)
+    {
+        values[i] = 0;
+    }
+    dirty = true;
+}
+
+/**
+ * SetHudValue - Sets a value shown on the HUD.
+ *
+ * @value:  The HUD value to set.
+ * @amount: The value to show.
+ *
+ * Cheap enough to call every update, the HUD is only marked dirty if the value
+ * differs from the one it was last drawn with.
+ */
+void SetHudValue(HudValue value, int amount)
+{
+    if (value < 0 || value >= HUD_VALUE_COUNT || values[value] == amount)
+        return;
+
+    values[value] = amount;
+    dirty = true;
+}
+
+// Check if the HUD will be redrawn on the next DrawHud
+bool IsHudDirty()
+{
+    return dirty;
+}
+
+// Rasterises the HUD into its texture
+static void RedrawHud()
+{
+    BeginTextureMode(target);
+    ClearBackground(BLANK);
+
+    DrawText("LIVES:", 550, 23, 40, WHITE);
+    DrawText(TextFormat("%d", values[HUD_VALUE_LIVES]), 690, 23, 40, WHITE);
+
+    DrawText(TextFormat("HEALTH: %d   STAMINA: %d   MANA: %d",
+                        values[HUD_VALUE_HEALTH],
+                        values[HUD_VALUE_STAMINA],
+                        values[HUD_VALUE_MANA]),
+             20, 33, 20, WHITE);
+
+    EndTextureMode();
+    dirty = false;
+}
+
+/**
+ * DrawHud - Draws the HUD over the screen.
+ *
+ * Called between BeginDrawing and EndDrawing, after the world (outside
+ * BeginMode2D). Redraws the HUD texture first if a value changed since it was
+ * last drawn.
+ */
+void DrawHud()
+{
+    if (dirty)
+    {
+        RedrawHud();
+    }
+
+    // Render textures are stored upside down, flip the source rectangle
+    Rectangle source = {0.0f, 0.0f, (float)target.texture.width, -(float)target.texture.height};
+    DrawTextureRec(target.texture, source, (Vector2){0.0f, 0.0f}, WHITE);
+}
+
+/**
+ * ExitHud - Releases the HUD's render texture.
+ */
+void ExitHud()
+{
+    UnloadRenderTexture(target);
+    target = (RenderTexture2D){0};
+    dirty = true;
+}
@@ -0,0 +1,348 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <raymath.h>
+
+#include "../include/utils/influence_map.h"
+
+/**
+ * CreateInfluenceMap - Creates an influence map over a grid.
+ *
+ * @columns:  Number of cells across.
+ * @rows:     Number of cells down.
+ * @cellSize: Width and height of a cell (world units).
+ *
+ * Every layer is one contiguous array of floats, row by row, so the stamp and
+ * blur kernels run down whole rows in loops the compiler vectorises.
+ *
+ * Return: A pointer to the influence map, with every layer cleared.
+ */
+InfluenceMap *CreateInfluenceMap(int columns, int rows, float cellSize)
+{
+    InfluenceMap *map = (InfluenceMap *)malloc(sizeof(InfluenceMap));
+    if (!map)
+    {
+        fprintf(stderr, "Failed to allocate influence map\n");
+        exit(1);
+    }
+
+    int cellCount = columns * rows;
+    for (int layer = 0; layer < INFLUENCE_LAYER_COUNT; layer++)
+    {
+        map->layers[layer] = (float *)calloc(cellCount, sizeof(float));
+        if (!map->layers[layer])
+        {
+            fprintf(stderr, "Failed to allocate influence map\n");
+            exit(1);
+        }
+    }
+    map->scratch = (float *)calloc(cellCount, sizeof(float));
+    if (!map->scratch)
+    {
+        fprintf(stderr, "Failed to allocate influence map\n");
+        exit(1);
+    }
+
+    map->columns = columns;
+    map->rows = rows;
+    map->cellSize = cellSize;
+    return map;
+}
+
+/**
+ * ClearInfluenceMap - Clears every layer.
+ */
+void ClearInfluenceMap(InfluenceMap *map)
+{
+    for (int layer = 0; layer < INFLUENCE_LAYER_COUNT; layer++)
+    {
+        memset(map->layers[layer], 0, sizeof(float) * map->columns * map->rows);
+    }
+}
+
+/**
+ * StampInfluence - Adds to a layer at a position.
+ *
+ * @map:      The influence map.
+ * @layer:    The layer.
+ * @position: Where (world units), positions off the map are ignored.
+ * @amount:   How much, split over the four nearest cells by how near they are.
+ */
+void StampInfluence(InfluenceMap *map, InfluenceLayer layer, Vector2 position, float amount)
+{
+    // Relative to the cell centres, so a position on a centre lands on that cell alone
+    float x = position.x / map->cellSize - 0.5f;
+    float y = position.y / map->cellSize - 0.5f;
+    int column = (int)floorf(x);
+    int row = (int)floorf(y);
+    float fx = x - column;
+    float fy = y - row;
+
+    const float weights[4] = {(1 - fx) * (1 - fy), fx * (1 - fy), (1 - fx) * fy, fx * fy};
+    float *values = map->layers[layer];
+    for (int k = 0; k < 4; k++)
+    {
+        int c = column + (k & 1);
+        int r = row + (k >> 1);
+        if (c >= 0 && c < map->columns && r >= 0 && r < map->rows)
+        {
+            values[r * map->columns + c] += amount * weights[k];
+        }
+    }
+}
+
+// Cells spanned on both axes (empty if first is after last)
+typedef struct
+{
+    int firstColumn, lastColumn;
+    int firstRow, lastRow;
+} CellRange;
+
+// Gets the cells within radius of a position on both axes, clamped to the map
+static CellRange GetCellRange(const InfluenceMap *map, Vector2 position, float radius)
+{
+    CellRange range = {(int)floorf((position.x - radius) / map->cellSize),
+                       (int)floorf((position.x + radius) / map->cellSize),
+                       (int)floorf((position.y - radius) / map->cellSize),
+                       (int)floorf((position.y + radius) / map->cellSize)};
+    range.firstColumn = range.firstColumn < 0 ? 0 : range.firstColumn;
+    range.firstRow = range.firstRow < 0 ? 0 : range.firstRow;
+    range.lastColumn = range.lastColumn >= map->columns ? map->columns - 1 : range.lastColumn;
+    range.lastRow = range.lastRow >= map->rows ? map->rows - 1 : range.lastRow;
+    return range;
+}
+
+/**
+ * StampInfluenceCircle - Adds a circle around a position to a layer.
+ *
+ * @map:      The influence map.
+ * @layer:    The layer.
+ * @position: The circle's centre (world units).
+ * @radius:   How far the circle reaches.
+ * @amount:   What the circle adds at its centre.
+ *
+ * Each cell in the circle gets amount * (1 - (distance / radius)^2) added.
+ * The test uses squared lengths and the result is masked by a multiply, so
+ * the loop over a row has no square roots or branches for the compiler to
+ * vectorise.
+ */
+void StampInfluenceCircle(InfluenceMap *map, InfluenceLayer layer, Vector2 position, float radius, float amount)
+{
+    const float size = map->cellSize;
+    const float radiusSquared = radius * radius;
+    const float inverseRadiusSquared = 1.0f / radiusSquared;
+    const CellRange range = GetCellRange(map, position, radius);
+
+    const int first = range.firstColumn;
+    const int count = range.lastColumn - first + 1;
+    const int columns = map->columns;
+    const float firstDx = (first + 0.5f) * size - position.x;
+    float *values = map->layers[layer];
+    for (int row = range.firstRow; row <= range.lastRow; row++)
+    {
+        float *restrict cells = &values[row * columns + first];
+        const float dy = (row + 0.5f) * size - position.y;
+
+        for (int k = 0; k < count; k++)
+        {
+            float dx = firstDx + k * size;
+            float lengthSquared = dx * dx + dy * dy;
+            int inCircle = lengthSquared < radiusSquared;
+            cells[k] += (float)inCircle * amount * (1.0f - lengthSquared * inverseRadiusSquared);
+        }
+    }
+}
+
+/**
+ * StampInfluenceArc - Adds an arc in front of a position to a layer.
+ *
+ * @map:          The influence map.
+ * @layer:        The layer.
+ * @position:     The arc's centre (world units).
+ * @facing:       The unit direction the arc faces.
+ * @radius:       How far the arc reaches.
+ * @cosHalfAngle: Cosine of half the arc's angle (at most 90 degrees each side).
+ *
+ * Like StampInfluenceCircle with an amount of 1, for the cells in the arc only.
+ */
+void StampInfluenceArc(InfluenceMap *map, InfluenceLayer layer, Vector2 position, Vector2 facing, float radius,
+                       float cosHalfAngle)
+{
+    const float size = map->cellSize;
+    const float radiusSquared = radius * radius;
+    const float inverseRadiusSquared = 1.0f / radiusSquared;
+    const float cosSquared = cosHalfAngle * cosHalfAngle;
+    const CellRange range = GetCellRange(map, position, radius);
+
+    const int first = range.firstColumn;
+    const int count = range.lastColumn - first + 1;
+    const int columns = map->columns;
+    const float firstDx = (first + 0.5f) * size - position.x;
+    float *values = map->layers[layer];
+    for (int row = range.firstRow; row <= range.lastRow; row++)
+    {
+        float *restrict cells = &values[row * columns + first];
+        const float dy = (row + 0.5f) * size - position.y;
+
+        for (int k = 0; k < count; k++)
+        {
+            float dx = firstDx + k * size;
+            float lengthSquared = dx * dx + dy * dy;
+            float along = dx * facing.x + dy * facing.y;
+
+            // Bitwise ands, so the three tests do not short circuit into branches
+            int inArc = (along > 0.0f) & (along * along >= cosSquared * lengthSquared) & (lengthSquared < radiusSquared);
+            cells[k] += (float)inArc * (1.0f - lengthSquared * inverseRadiusSquared);
+        }
+    }
+}
+
+/**
+ * BlurInfluence - Spreads a layer into the neighbouring cells.
+ *
+ * @map:    The influence map.
+ * @layer:  The layer.
+ * @passes: How many times to filter, each pass spreads one cell further.
+ *
+ * Each pass filters the rows and then the columns with 1/4, 1/2, 1/4 weights
+ * (edges repeat the border cell). Both run along contiguous rows: the
+ * vertical pass reads three rows and writes one, so every inner loop is
+ * vectorised.
+ */
+void BlurInfluence(InfluenceMap *map, InfluenceLayer layer, int passes)
+{
+    const int columns = map->columns;
+    const int rows = map->rows;
+    float *values = map->layers[layer];
+    float *scratch = map->scratch;
+
+    if (columns < 2 || rows < 2)
+    {
+        return;
+    }
+
+    for (int pass = 0; pass < passes; pass++)
+    {
+        // Across the rows, into the scratch layer
+        for (int row = 0; row < rows; row++)
+        {
+            const float *restrict in = &values[row * columns];
+            float *restrict out = &scratch[row * columns];
+
+            out[0] = 0.75f * in[0] + 0.25f * in[1];
+            for (int column = 1; column < columns - 1; column++)
+            {
+                out[column] = 0.25f * in[column - 1] + 0.5f * in[column] + 0.25f * in[column + 1];
+            }
+            out[columns - 1] = 0.25f * in[columns - 2] + 0.75f * in[columns - 1];
+        }
+
+        // Down the columns, back into the layer
+        for (int row = 0; row < rows; row++)
+        {
+            const float *restrict above = &scratch[(row > 0 ? row - 1 : row) * columns];
+            const float *restrict middle = &scratch[row * columns];
+            const float *restrict below = &scratch[(row < rows - 1 ? row + 1 : row) * columns];
+            float *restrict out = &values[row * columns];
+
+            for (int column = 0; column < columns; column++)
+            {
+                out[column] = 0.25f * above[column] + 0.5f * middle[column] + 0.25f * below[column];
+            }
+        }
+    }
+}
+
+/**
+ * SampleInfluence - Gets a layer's value at a position.
+ *
+ * Return: The value of the cell the position is in, 0 outside the map.
+ */
+float SampleInfluence(const InfluenceMap *map, InfluenceLayer layer, Vector2 position)
+{
+    int column = (int)floorf(position.x / map->cellSize);
+    int row = (int)floorf(position.y / map->cellSize);
+    if (column < 0 || column >= map->columns || row < 0 || row >= map->rows)
+    {
+        return 0.0f;
+    }
+    return map->layers[layer][row * map->columns + column];
+}
+
+/**
+ * FindInfluencePosition - Finds the best cell around a position.
+ *
+ * @map:       The influence map.
+ * @center:    Where to search around (world units).
+ * @minRadius: Cells whose centre is nearer than this are skipped.
+ * @maxRadius: Cells whose centre is further than this are skipped.
+ * @weights:   How much each layer costs, negative weights attract.
+ * @from:      Where the asker is.
+ * @travel:    How much each world unit between a cell and from costs.
+ *
+ * Used for tactical positions, e.g., a flanking spot next to the player out of
+ * its attack arc and away from other NPCs, or a retreat spot with little threat
+ * and many allies. The travel cost makes askers in different places pick
+ * different cells where the layers alone would tie.
+ *
+ * Return: The centre of the cheapest cell, or center if no cell is in range.
+ */
+Vector2 FindInfluencePosition(const InfluenceMap *map, Vector2 center, float minRadius, float maxRadius,
+                              const float weights[INFLUENCE_LAYER_COUNT], Vector2 from, float travel)
+{
+    const float size = map->cellSize;
+    const float minSquared = minRadius * minRadius;
+    const float maxSquared = maxRadius * maxRadius;
+    const CellRange range = GetCellRange(map, center, maxRadius);
+
+    Vector2 best = center;
+    float bestCost = INFINITY;
+    for (int row = range.firstRow; row <= range.lastRow; row++)
+    {
+        for (int column = range.firstColumn; column <= range.lastColumn; column++)
+        {
+            Vector2 cellCenter = {(column + 0.5f) * size, (row + 0.5f) * size};
+            float dx = cellCenter.x - center.x;
+            float dy = cellCenter.y - center.y;
+            float distanceSquared = dx * dx + dy * dy;
+            if (distanceSquared < minSquared || distanceSquared > maxSquared)
+                continue;
+
+            int cell = row * map->columns + column;
+            float cost = travel * Vector2Distance(cellCenter, from);
+            for (int layer = 0; layer < INFLUENCE_LAYER_COUNT; layer++)
+            {
+                cost += weights[layer] * map->layers[layer][cell];
+            }
+
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                best = cellCenter;
+            }
+        }
+    }
+
+    return best;
+}
+
+/**
+ * DeleteInfluenceMap - Deletes an influence map.
+ *
+ * @map: The influence map, nothing may read it any more.
+ */
+void DeleteInfluenceMap(InfluenceMap *map)
+{
+    if (!map)
+    {
+        return;
+    }
+    for (int layer = 0; layer < INFLUENCE_LAYER_COUNT; layer++)
+    {
+        free(map->layers[layer]);
+    }
+    free(map->scratch);
+    free(map);
+}
@@ -0,0 +1,209 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#if !defined(WEB_BUILD)
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#include "../include/utils/job_pool.h"
+
+// The job being run, workers take batches from it until none are left (only
+// written while no worker is busy)
+static JobFunction jobFunction = NULL;
+static void *jobContext = NULL;
+static int jobCount = 0;
+static int jobBatchSize = 1;
+static int jobBatches = 0;
+static atomic_int nextBatch = 0; // Next batch to take
+
+static int workerCount = 0;
+
+#if !defined(WEB_BUILD)
+static pthread_t workers[MAX_JOB_WORKERS];
+static pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t jobPosted = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t jobFinished = PTHREAD_COND_INITIALIZER;
+static unsigned int jobGeneration = 0; // Bumped for every job, workers wait for it to change
+static int busyWorkers = 0;            // Workers between waking for a job and running out of batches
+static bool stopping = false;
+#endif
+
+// Takes and runs batches of the current job until none are left
+static void RunBatches()
+{
+    int batch;
+    while ((batch = atomic_fetch_add(&nextBatch, 1)) < jobBatches)
+    {
+        int first = batch * jobBatchSize;
+        int last = first + jobBatchSize < jobCount ? first + jobBatchSize : jobCount;
+        jobFunction(jobContext, first, last);
+    }
+}
+
+#if !defined(WEB_BUILD)
+// Worker thread: sleeps until a job is posted, then helps run it
+static void *RunWorker(void *arg)
+{
+    (void)arg; // The job is in the pool state
+    unsigned int seen = 0;
+
+    pthread_mutex_lock(&poolLock);
+    while (true)
+    {
+        while (jobGeneration == seen && !stopping)
+        {
+            pthread_cond_wait(&jobPosted, &poolLock);
+        }
+        if (stopping)
+        {
+            break;
+        }
+        seen = jobGeneration;
+        busyWorkers++;
+        pthread_mutex_unlock(&poolLock);
+
+        RunBatches();
+
+        // The last worker to run out of batches wakes the caller
+        pthread_mutex_lock(&poolLock);
+        if (--busyWorkers == 0)
+        {
+            pthread_cond_signal(&jobFinished);
+        }
+    }
+    pthread_mutex_unlock(&poolLock);
+
+    return NULL;
+}
+#endif
+
+/**
+ * InitJobPool - Starts the worker threads.
+ *
+ * One worker is started per core besides the calling thread (at most
+ * MAX_JOB_WORKERS), the caller runs batches too while it waits for a job. Web
+ * builds start none and run every job on the caller.
+ */
+void InitJobPool()
+{
+    workerCount = 0;
+
+#if !defined(WEB_BUILD)
+    int cores = 1;
+#if defined(_SC_NPROCESSORS_ONLN)
+    cores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    int wanted = cores - 1;
+    if (wanted > MAX_JOB_WORKERS)
+        wanted = MAX_JOB_WORKERS;
+
+    stopping = false;
+    for (int i = 0; i < wanted; i++)
+    {
+        if (pthread_create(&workers[workerCount], NULL, RunWorker, NULL) != 0)
+        {
+            fprintf(stderr, "Failed to start job worker %d, running with %d\n", i, workerCount);
+            break;
+        }
+        workerCount++;
+    }
+#endif
+}
+
+/**
+ * RunParallelJob - Runs a job across the pool.
+ *
+ * @function: Called for each batch with the range of items it covers.
+ * @context:  Passed to every call.
+ * @count:    The number of items.
+ * @minBatch: The fewest items worth handing to another thread, a job of fewer
+ *            items than two batches runs on the caller alone.
+ *
+ * Returns once every item is done. Batches run in any order on any thread, so
+ * the function must only write to the items of its range; results read back
+ * afterwards do not depend on which thread ran which batch.
+ */
+void RunParallelJob(JobFunction function, void *context, int count, int minBatch)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    if (minBatch < 1)
+        minBatch = 1;
+
+    // Not worth waking the workers
+    if (workerCount == 0 || count < 2 * minBatch)
+    {
+        function(context, 0, count);
+        return;
+    }
+
+    // A few batches per thread so a slow batch does not hold the others up
+    int threads = workerCount + 1;
+    int batchSize = (count + threads * 4 - 1) / (threads * 4);
+    if (batchSize < minBatch)
+        batchSize = minBatch;
+
+#if !defined(WEB_BUILD)
+    // A worker that woke late for the last job may still be looking at it
+    pthread_mutex_lock(&poolLock);
+    while (busyWorkers > 0)
+    {
+        pthread_cond_wait(&jobFinished, &poolLock);
+    }
+#endif
+
+    jobFunction = function;
+    jobContext = context;
+    jobCount = count;
+    jobBatchSize = batchSize;
+    jobBatches = (count + batchSize - 1) / batchSize;
+    atomic_store(&nextBatch, 0);
+
+#if !defined(WEB_BUILD)
+    jobGeneration++;
+    pthread_cond_broadcast(&jobPosted);
+    pthread_mutex_unlock(&poolLock);
+#endif
+
+    RunBatches();
+
+#if !defined(WEB_BUILD)
+    // Every batch has been taken, wait for the workers still running theirs
+    pthread_mutex_lock(&poolLock);
+    while (busyWorkers > 0)
+    {
+        pthread_cond_wait(&jobFinished, &poolLock);
+    }
+    pthread_mutex_unlock(&poolLock);
+#endif
+}
+
+// Number of worker threads besides the caller
+int GetJobPoolWorkers()
+{
+    return workerCount;
+}
+
+/**
+ * ExitJobPool - Stops the worker threads.
+ */
+void ExitJobPool()
+{
+#if !defined(WEB_BUILD)
+    pthread_mutex_lock(&poolLock);
+    stopping = true;
+    pthread_cond_broadcast(&jobPosted);
+    pthread_mutex_unlock(&poolLock);
+
+    for (int i = 0; i < workerCount; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+#endif
+    workerCount = 0;
+}
@@ -4,6 +4,7 @@
 #include <raylib.h>
 
 #include "../include/game/game.h"
+#include "../include/game/frame_pipeline.h"
 #include "../include/events/events.h"
 #include "../include/fsm/fsm.h"
 #include "../include/gameobjects/gameobject.h"
@@ -11,7 +12,8 @@
 #include "../include/gameobjects/npc.h"
 #include "../include/utils/mediator.h"
 #include "../include/utils/input_manager.h"
-#include "../include/utils/ai_manager.h"
+#include "../include/utils/ai_system.h"
+#include "../include/utils/random.h"
 
 // Specific include for build_web
 #if defined(WEB_BUILD)
@@ -25,8 +27,16 @@ void GameLoop(GameData *gameData);
 
 int main(void)
 {
-    // Seed the random number generator once at the start of the program
-    srand(time(NULL));
+    // Every random stream is derived from the world seed, build with WORLD_SEED to replay a run
+#if defined(WORLD_SEED)
+    SetWorldSeed(WORLD_SEED);
+
+    // Every due NPC decides every update, so which ones decide does not depend on the machine
+    SetAIThinkBudget(0.0f);
+#else
+    SetWorldSeed((uint64_t)time(NULL));
+#endif
+    printf("World seed: %llu\n", (unsigned long long)GetWorldSeed());
 
     InitWindow(screenWidth, screenHeight, "Raylib Animated FSM StarterKit GPPI");
 
@@ -36,6 +46,9 @@ int main(void)
     // Initialise Game
     InitGame(&gameData);
 
+    // Simulation on its own thread, drawing stays on this one (single threaded on the web)
+    StartFramePipeline(&gameData);
+
     // For web builds, do not use WindowShouldClose
     // see https://github.com/raysan5/raylib/wiki/Working-for-Web-(HTML5)#41-avoid-raylib-whilewindowshouldclose-loop
 
@@ -51,6 +64,7 @@ int main(void)
 #endif
 
     // Free resources
+    StopFramePipeline();
     CloseGame(&gameData);
 
     CloseWindow();
@@ -60,10 +74,7 @@ int main(void)
 
 void GameLoop(GameData *gameData)
 {
-    // Update Game Data
-    // Should be outside BeginDrawing(); and EndDrawing();
-    UpdateGame(gameData);
-
-    // Draw the Game Objects
-    DrawGame(gameData);
+    // Update Game Data and draw the Game Objects, the update of this frame
+    // overlaps the drawing of the last one
+    RunFramePipeline(gameData);
 }
\ No newline at end of file
@@ -1,10 +1,101 @@
 #include "../include/gameobjects/npc.h"
 #include "include/game/game.h"
+#include "../include/utils/constants.h"
+#include "../include/utils/scheduler.h"
+#include "../include/fsm/fsm_loader.h"
+#include "../include/utils/entity_commands.h"
+#include "../include/render/texture_atlas.h"
+#include "../include/render/sprite_instancing.h"
+#include "../include/utils/behaviour_tree.h"
+#include "../include/utils/crowd.h"
+
+// Precompiled NPC FSM graph, built from assets/fsm/npc.fsm by tools/fsm_compiler
+#define NPC_FSM_GRAPH "assets/fsm/npc.fsmb"
+
+// NPC sprite sheet, packed into the texture atlas at startup
+#define NPC_SPRITE_SHEET "./assets/npc_sprite_sheet.png"
+
+// Animation clips on the NPC sprite sheet, RegisterNPCAnimationClips hands them to the
+// texture atlas, which rewrites them to atlas coordinates
+static Rectangle idle[7] = {
+    {0, 128, 64, 64},   // Frame 1: Row 3, Column 1
+    {64, 128, 64, 64},  // Frame 2: Row 3, Column 2
+    {128, 128, 64, 64}, // Frame 3: Row 3, Column 3
+    {192, 128, 64, 64}, // Frame 4: Row 3, Column 4
+    {256, 128, 64, 64}, // Frame 5: Row 3, Column 5
+    {320, 128, 64, 64}, // Frame 6: Row 3, Column 6
+    {384, 128, 64, 64}  // Frame 7: Row 3, Column 7
+};
+
+static Rectangle attacking[6] = {
+    {0, 3328, 192, 192},   // Frame 1: Row 53, Column 1
+    {192, 3328, 192, 192}, // Frame 2: Row 53, Column 2
+    {384, 3328, 192, 192}, // Frame 3: Row 53, Column 3
+    {576, 3520, 192, 192}, // Frame 4: Row 53, Column 4
+    {768, 3520, 192, 192}, // Frame 5: Row 53, Column 5
+    {960, 3520, 192, 192}  // Frame 6: Row 53, Column 6
+};
+
+static Rectangle sheilding[8] = {
+    {0, 384, 64, 64},   // Frame 1: Row 7, Column 1
+    {64, 384, 64, 64},  // Frame 2: Row 7, Column 2
+    {128, 384, 64, 64}, // Frame 3: Row 7, Column 3
+    {192, 384, 64, 64}, // Frame 4: Row 7, Column 4
+    {256, 384, 64, 64}, // Frame 5: Row 7, Column 5
+    {320, 384, 64, 64}, // Frame 6: Row 7, Column 6
+    {384, 384, 64, 64}, // Frame 7: Row 7, Column 7
+    {448, 384, 64, 64}  // Frame 8: Row 7, Column 8
+};
+
+static Rectangle dead[6] = {
+    {0, 1280, 64, 64},   // Frame 1: Row 21, Column 1
+    {64, 1280, 64, 64},  // Frame 1: Row 21, Column 2
+    {128, 1280, 64, 64}, // Frame 1: Row 21, Column 3
+    {192, 1280, 64, 64}, // Frame 1: Row 21, Column 4
+    {256, 1280, 64, 64}, // Frame 1: Row 21, Column 5
+    {320, 1280, 64, 64}  // Frame 1: Row 21, Column 6
+};
+
+// How NPCs decide what to do, shared by every NPC (see InitNPCBehaviourTree)
+static const BTNodeDef behaviourOutline[] = {
+    {0, BT_SELECTOR, 0, 0, 0.0f},
+    // Nothing to fight: carry on wandering
+    {1, BT_SEQUENCE, 0, 0, 0.0f},
+    {2, BT_CONDITION, BT_KEY_TARGET_DISTANCE, BT_AT_LEAST, AI_SENSE_RANGE},
+    {2, BT_ACTION, COMMAND_NONE, 0, 0.0f},
+    // Hurt while the target attacks: shield for a while
+    {1, BT_SEQUENCE, 0, 0, 0.0f},
+    {2, BT_CONDITION, BT_KEY_HEALTH, BT_BELOW, 40.0f},
+    {2, BT_CONDITION, BT_KEY_TARGET_THREAT, BT_AT_LEAST, 0.5f},
+    {2, BT_ACTION, COMMAND_SHIELD, 0, 2.0f},
+    // Hurt with the target close: fall back to the safer spot the AI picked
+    {1, BT_SEQUENCE, 0, 0, 0.0f},
+    {2, BT_CONDITION, BT_KEY_HEALTH, BT_BELOW, NPC_RETREAT_HEALTH},
+    {2, BT_CONDITION, BT_KEY_TARGET_DISTANCE, BT_BELOW, AI_TACTICS_RANGE},
+    {2, BT_ACTION, COMMAND_CHASE, 0, 0.0f},
+    // Enough others on the target already: weigh it up instead of piling in
+    {1, BT_SEQUENCE, 0, 0, 0.0f},
+    {2, BT_CONDITION, BT_KEY_ALLIES_ATTACKING, BT_AT_LEAST, (float)NPC_MAX_ATTACKERS},
+    {2, BT_SUGGESTED, 0, 0, 0.0f},
+    // Target within reach: attack and keep at it for a moment
+    {1, BT_SEQUENCE, 0, 0, 0.0f},
+    {2, BT_CONDITION, BT_KEY_TARGET_DISTANCE, BT_BELOW, NPC_ATTACK_RANGE},
+    {2, BT_ACTION, COMMAND_ATTACK, 0, 1.0f},
+    // Keen to fight: close in along the flow field, then on a flanking spot
+    {1, BT_SEQUENCE, 0, 0, 0.0f},
+    {2, BT_CONDITION, BT_KEY_AGGRESSION, BT_AT_LEAST, 30.0f},
+    {2, BT_ACTION, COMMAND_CHASE, 0, 0.0f},
+    // Otherwise weigh it up (utility scores)
+    {1, BT_SUGGESTED, 0, 0, 0.0f},
+};
+
+static BehaviourTree *behaviourTree = NULL;
 
 /**
  * InitNPC - Initializes a new NPC object with a given name.
  *
- * @name: The name of the NPC being initialized.
+ * @name:     The name of the NPC being initialized.
+ * @position: Where the NPC spawns (and respawns after dying).
  *
  * This function allocates memory for the NPC object, initializes the GameObject
  * base structure, and sets the NPC's texture, aggression level, and state
@@ -13,7 +104,7 @@
  * Return: A pointer to the initialized NPC object, or NULL if memory allocation
  *         or texture loading fails.
  */
-NPC *InitNPC(const char *name)
+NPC *InitNPC(const char *name, Vector2 position)
 {
     // Allocate memory for the NPC structure
     NPC *npc = (NPC *)malloc(sizeof(NPC));
@@ -27,21 +118,21 @@ NPC *InitNPC(const char *name)
     }
 
     // Load player texture
-    Texture2D npcTexture = LoadTexture("./assets/npc_sprite_sheet.png");
+    Texture2D npcTexture = GetAtlasTexture(NPC_SPRITE_SHEET);
 
     // Initialize the base GameObject structure within the NPC with the provided name
     InitGameObject(&npc->base,
                    name,
-                   (Vector2){GetScreenWidth() / 2.0f, 100.0f}, // Position
-                   (Vector2){0, 0},                            // Velocity
-                   STATE_IDLE,                                 // Initial State
-                   GREEN,                                      // Player Color
-                   (c2Circle){                                 // cute_c2 Circle Collider
-                              .p = {GetScreenWidth() / 2.0f, 100.0f},
+                   position,        // Position
+                   (Vector2){0, 0}, // Velocity
+                   STATE_IDLE,      // Initial State
+                   GREEN,           // Player Color
+                   (c2Circle){      // cute_c2 Circle Collider
+                              .p = {position.x, position.y},
                               .r = 10},
                    (c2AABB){// AABB Collider for boundary checks
-                            .min = {GetScreenWidth() / 2.0f - 10, 100.0f - 10},
-                            .max = {GetScreenWidth() / 2.0f + 10, 100.0f + 10}},
+                            .min = {position.x - 10, position.y - 10},
+                            .max = {position.x + 10, position.y + 10}},
                    npcTexture,
                    100, // Initial Health
                    2
@@ -49,6 +140,10 @@ NPC *InitNPC(const char *name)
 
     // Set the default aggression level for the NPC
     npc->aggression = 50;
+    npc->spawnPoint = position;
+
+    // Drawn instanced if InitNPCSpriteInstancing succeeded (SPRITE_INSTANCE_NONE otherwise)
+    npc->base.spriteInstance = AddSpriteInstance(position, RAYWHITE);
 
     // Initialize the NPC's finite state machine (FSM) with state configurations
     InitNPCFSM(&npc->base);
@@ -88,14 +183,28 @@ void DeleteNPC(GameObject *obj)
  *
  * @obj: The GameObject (NPC) to initialize the FSM for.
  *
- * This function sets up the state machine for the NPC, allocating memory for
- * state configurations, defining valid state transitions, and associating
- * state handler functions with each state.
+ * This function sets up the state machine for the NPC. The compiled graph is
+ * shared by every NPC when the blob loads, otherwise memory is allocated for
+ * state configurations, valid state transitions are defined and state handler
+ * functions are associated with each state.
  */
 void InitNPCFSM(GameObject *obj)
 {
+    // Builds with generated dispatch call the handlers through switches compiled from
+    // the same definition, the state table is still used for names and debugging
+    obj->archetype = FSM_ARCHETYPE_NPC;
+
+    // Share the precompiled graph (assets/fsm/npc.fsm) when it is available
+    FsmGraph *graph = GetFsmGraph(NPC_FSM_GRAPH);
+    if (graph)
+    {
+        obj->stateConfigs = graph->states;
+        obj->sharedStateConfigs = true;
+        return;
+    }
+
     // Allocate memory for the state configurations array with a size for all possible states
-    obj->stateConfigs = (StateConfig *)malloc(sizeof(StateConfig) * STATE_COUNT);
+    obj->stateConfigs = (StateConfig *)calloc(STATE_COUNT, sizeof(StateConfig));
 
     // Check if memory allocation for state configurations failed
     if (!obj->stateConfigs)
@@ -107,7 +216,7 @@ void InitNPCFSM(GameObject *obj)
 
     // ---- STATE_IDLE state configuration ----
     // Define valid transitions from STATE_IDLE
-    State idleValidTransitions[] = {STATE_ATTACKING, STATE_SHIELD, STATE_DEAD , STATE_IDLE};
+    State idleValidTransitions[] = {STATE_ATTACKING, STATE_SHIELD, STATE_DEAD , STATE_IDLE, STATE_WALKING};
 
     // Set up the state configuration for STATE_IDLE
     obj->stateConfigs[STATE_IDLE].name = "NPC_Idle";
@@ -115,13 +224,32 @@ void InitNPCFSM(GameObject *obj)
     obj->stateConfigs[STATE_IDLE].Entry = NPCEnterIdle;
     obj->stateConfigs[STATE_IDLE].Update = NPCUpdateIdle;
     obj->stateConfigs[STATE_IDLE].Exit = NPCExitIdle;
+    obj->stateConfigs[STATE_IDLE].Resume = NPCResumeIdle;
 
     // Configure valid transitions for STATE_IDLE
     StateTransitions(&obj->stateConfigs[STATE_IDLE], idleValidTransitions, sizeof(idleValidTransitions) / sizeof(State));
 
+    // ---- STATE_WALKING state configuration ----
+    // Define valid transitions from STATE_WALKING
+    State walkingValidTransitions[] = {STATE_IDLE, STATE_ATTACKING, STATE_SHIELD, STATE_DEAD};
+
+    // Set up the state configuration for STATE_WALKING
+    obj->stateConfigs[STATE_WALKING].name = "NPC_Walking";
+    obj->stateConfigs[STATE_WALKING].HandleEvent = NPCWalkingHandleEvent;
+    obj->stateConfigs[STATE_WALKING].Entry = NPCEnterWalking;
+    obj->stateConfigs[STATE_WALKING].Update = NPCUpdateWalking;
+    obj->stateConfigs[STATE_WALKING].Exit = NPCExitWalking;
+
+    // Configure valid transitions for STATE_WALKING
+    StateTransitions(&obj->stateConfigs[STATE_WALKING], walkingValidTransitions, sizeof(walkingValidTransitions) / sizeof(State));
+
+    // Events STATE_WALKING reacts to, the others are dropped
+    Event walkingEvents[] = {EVENT_NONE, EVENT_ATTACK, EVENT_DEFEND, EVENT_DIE};
+    StateEvents(&obj->stateConfigs[STATE_WALKING], walkingEvents, sizeof(walkingEvents) / sizeof(Event));
+
     // ---- STATE_ATTACKING state configuration ----
     // Define valid transitions from STATE_ATTACKING
-    State attackValidTransitions[] = {STATE_IDLE, STATE_SHIELD, STATE_DEAD};
+    State attackValidTransitions[] = {STATE_IDLE, STATE_SHIELD, STATE_DEAD, STATE_WALKING};
 
     // Set up the state configuration for STATE_ATTACKING
     obj->stateConfigs[STATE_ATTACKING].name = "NPC_Attacking";
@@ -147,6 +275,10 @@ void InitNPCFSM(GameObject *obj)
     // Configure valid transitions for STATE_SHIELD
     StateTransitions(&obj->stateConfigs[STATE_SHIELD], sheildingValidTransitions, sizeof(sheildingValidTransitions) / sizeof(State));
 
+    // Events STATE_SHIELD reacts to, the others are dropped
+    Event shieldingEvents[] = {EVENT_NONE, EVENT_ATTACK, EVENT_DIE};
+    StateEvents(&obj->stateConfigs[STATE_SHIELD], shieldingEvents, sizeof(shieldingEvents) / sizeof(Event));
+
     // ---- STATE_DEAD state configuration ----
     // Define valid transitions from STATE_DEAD
     State deadValidTransitions[] = {STATE_IDLE}; // Should go to STATE_RESPAWN to keep kit small goes to IDLE
@@ -161,29 +293,127 @@ void InitNPCFSM(GameObject *obj)
     // Configure valid transitions for STATE_DEAD
     StateTransitions(&obj->stateConfigs[STATE_DEAD], deadValidTransitions, sizeof(deadValidTransitions) / sizeof(State));
 
+    // Events STATE_DEAD reacts to, the others are dropped
+    Event deadEvents[] = {EVENT_RESPAWN, EVENT_TIMEOUT};
+    StateEvents(&obj->stateConfigs[STATE_DEAD], deadEvents, sizeof(deadEvents) / sizeof(Event));
+
 // For unimplemented states, set them to empty defaults
 // Alternatively NPC has its own FSM with only the implemented states
 #define EMPTY_STATE_CONFIG \
-    (StateConfig){NULL, NULL, NULL, NULL, NULL, NULL, 0}
-    obj->stateConfigs[STATE_WALKING] = EMPTY_STATE_CONFIG;
+    (StateConfig){NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, 0, 0}
     obj->stateConfigs[STATE_RESPAWN] = EMPTY_STATE_CONFIG;
     obj->stateConfigs[STATE_COLLISION] = EMPTY_STATE_CONFIG;
 }
 
+/**
+ * RegisterNPCFSMHandlers - Registers the NPC's state handlers by name.
+ *
+ * Called once at startup so the compiled graph (assets/fsm/npc.fsm) can bind
+ * its handler ids to these functions.
+ */
+void RegisterNPCFSMHandlers()
+{
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EVENT, NPCIdleHandleEvent);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_ENTRY, NPCEnterIdle);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_UPDATE, NPCUpdateIdle);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EXIT, NPCExitIdle);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_RESUME, NPCResumeIdle);
+
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EVENT, NPCWalkingHandleEvent);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_ENTRY, NPCEnterWalking);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_UPDATE, NPCUpdateWalking);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EXIT, NPCExitWalking);
+
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EVENT, NPCAttackingHandleEvent);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_ENTRY, NPCEnterAttacking);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_UPDATE, NPCUpdateAttacking);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EXIT, NPCExitAttacking);
+
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EVENT, NPCShieldingHandleEvent);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_ENTRY, NPCEnterShielding);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_UPDATE, NPCUpdateShielding);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EXIT, NPCExitShielding);
+
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EVENT, NPCDeadHandleEvent);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_ENTRY, NPCEnterDead);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_UPDATE, NPCUpdateDead);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EXIT, NPCExitDead);
+}
+
+/**
+ * RegisterNPCAnimationClips - Registers the NPC's animation clips with the texture atlas.
+ *
+ * Called once at startup, before BuildTextureAtlas, so only the frames the NPC
+ * actually plays are packed.
+ */
+void RegisterNPCAnimationClips()
+{
+    AddAtlasClip(NPC_SPRITE_SHEET, idle, 6);
+    AddAtlasClip(NPC_SPRITE_SHEET, attacking, 6);
+    AddAtlasClip(NPC_SPRITE_SHEET, sheilding, 6);
+    AddAtlasClip(NPC_SPRITE_SHEET, dead, 6);
+}
+
+/**
+ * InitNPCSpriteInstancing - Draws NPCs instanced, with their frames picked on the GPU.
+ *
+ * Called once at startup after BuildTextureAtlas and before the first NPC spawns.
+ * NPCs spawned afterwards get a sprite instance, the CPU only updates it when the
+ * NPC changes state or moves.
+ *
+ * Return: true if NPCs are drawn instanced, false if they stay on the sprite batch.
+ */
+bool InitNPCSpriteInstancing()
+{
+    if (!InitSpriteInstancing(GetAtlasTexture(NPC_SPRITE_SHEET)))
+    {
+        return false;
+    }
+
+    AddSpriteInstanceClip(idle, 6);
+    AddSpriteInstanceClip(attacking, 6);
+    AddSpriteInstanceClip(sheilding, 6);
+    AddSpriteInstanceClip(dead, 6);
+
+    return true;
+}
+
+/**
+ * InitNPCBehaviourTree - Builds the behaviour tree every NPC decides with.
+ *
+ * Called once at startup, before the first NPC spawns. The tree is flattened
+ * once and shared, each NPC only keeps its blackboard in the AI system.
+ */
+void InitNPCBehaviourTree()
+{
+    behaviourTree = CreateBehaviourTree(behaviourOutline, sizeof(behaviourOutline) / sizeof(BTNodeDef));
+}
+
+// Get the behaviour tree every NPC decides with
+const BehaviourTree *GetNPCBehaviourTree()
+{
+    return behaviourTree;
+}
+
+/**
+ * ExitNPCBehaviourTree - Deletes the NPC behaviour tree.
+ *
+ * Called once at shutdown, after the last NPC's agent is removed.
+ */
+void ExitNPCBehaviourTree()
+{
+    DeleteBehaviourTree(behaviourTree);
+    behaviourTree = NULL;
+}
+
 // Handles events for the NPC when in the Idle state
 void NPCIdleHandleEvent(GameObject *obj, Event event)
 {
     NPC *npc = (NPC *)obj;
     printf("\n%s Idle HandleEvent\n", obj->name);
     printf("Aggression: %d\n\n", npc->aggression);
-    // Get distance to player
-    Vector2 playerPos = {GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f};
-    float distanceToPlayer = Vector2Distance(obj->position, playerPos);
 
-    // If player moves out of attack range, go back to idle/following
-    if (distanceToPlayer > 50.0f) {
-        ChangeState(obj, STATE_IDLE);
-    }
+    // Range to the player is judged by the NPC behaviour tree, which only sends the events that apply
     switch (event)
     {
     case EVENT_ATTACK:
@@ -198,12 +428,16 @@ void NPCIdleHandleEvent(GameObject *obj, Event event)
         // Transition to Dead state if a die event is received
         ChangeState(obj, STATE_DEAD);
         break;
+    case EVENT_MOVE:
+        // Chase the player along the flow field
+        ChangeState(obj, STATE_WALKING);
+        break;
     // Ignore Events for other cases
     case EVENT_NONE:
-    case EVENT_MOVE:
     case EVENT_RESPAWN:
     case EVENT_COLLISION_START:
     case EVENT_COLLISION_END:
+    case EVENT_TIMEOUT:
     case EVENT_COUNT:
         break;
         case EVENT_MOVE_UP:
@@ -227,6 +461,51 @@ void NPCIdleHandleEvent(GameObject *obj, Event event)
     }
 }
 
+// Handles events for the NPC when in the Walking state
+void NPCWalkingHandleEvent(GameObject *obj, Event event)
+{
+    NPC *npc = (NPC *)obj;
+    printf("\n%s Walking HandleEvent\n", obj->name);
+    printf("Aggression: %d\n\n", npc->aggression);
+
+    switch (event)
+    {
+    case EVENT_NONE:
+        // Stop chasing and go back to wandering
+        ChangeState(obj, STATE_IDLE);
+        break;
+    case EVENT_ATTACK:
+        // Transition to Attacking state if an attack event is received
+        ChangeState(obj, STATE_ATTACKING);
+        break;
+    case EVENT_DEFEND:
+        // Transition to Shielding state if a defend event is received
+        ChangeState(obj, STATE_SHIELD);
+        break;
+    case EVENT_DIE:
+        // Transition to Dead state if a die event is received
+        ChangeState(obj, STATE_DEAD);
+        break;
+    // Ignore Events for other cases (already chasing)
+    case EVENT_MOVE:
+    case EVENT_RESPAWN:
+    case EVENT_COLLISION_START:
+    case EVENT_COLLISION_END:
+    case EVENT_TIMEOUT:
+    case EVENT_COUNT:
+    case EVENT_MOVE_UP:
+    case EVENT_MOVE_UP_RIGHT:
+    case EVENT_MOVE_UP_LEFT:
+    case EVENT_MOVE_DOWN:
+    case EVENT_MOVE_DOWN_RIGHT:
+    case EVENT_MOVE_DOWN_LEFT:
+    case EVENT_MOVE_LEFT:
+    case EVENT_MOVE_RIGHT:
+    case EVENT_SHIELD:
+        break;
+    }
+}
+
 // Handles events for the NPC when in the Attacking state
 void NPCAttackingHandleEvent(GameObject *obj, Event event)
 {
@@ -253,12 +532,16 @@ void NPCAttackingHandleEvent(GameObject *obj, Event event)
         // Transition to Dead state if a die event is received
         ChangeState(obj, STATE_DEAD);
         break;
-    // Ignore Events for other cases
     case EVENT_MOVE:
+        // The player got away, chase it along the flow field
+        ChangeState(obj, STATE_WALKING);
+        break;
+    // Ignore Events for other cases
     case EVENT_ATTACK:
     case EVENT_RESPAWN:
     case EVENT_COLLISION_START:
     case EVENT_COLLISION_END:
+    case EVENT_TIMEOUT:
     case EVENT_COUNT:
         break;
         case EVENT_MOVE_UP:
@@ -309,6 +592,7 @@ void NPCShieldingHandleEvent(GameObject *obj, Event event)
     case EVENT_DEFEND:
     case EVENT_COLLISION_START:
     case EVENT_COLLISION_END:
+    case EVENT_TIMEOUT:
     case EVENT_COUNT:
         break;
         case EVENT_MOVE_UP:
@@ -341,16 +625,19 @@ void NPCDeadHandleEvent(GameObject *obj, Event event)
 
     switch (event)
     {
-    case EVENT_NONE:
-        // Transition back to Idle if no specific event is triggered (e.g., after dying, NPC should stay dead until respawned)
-        // You may want to handle respawning logic in the future here.
-        ChangeState(obj, STATE_IDLE);
-        break;
     case EVENT_RESPAWN:
         // Transition to Idle or another state (e.g., Spawn) upon respawn event
         ChangeState(obj, STATE_IDLE); // or STATE_SPAWNING if you have that state
         break;
+    case EVENT_TIMEOUT:
+        // The corpse has been shown long enough, replace it with a fresh NPC at the spawn point,
+        // in the same squad. Both are structural changes, applied once the current phase has finished.
+        RecordDespawn(GetDeferredCommands(), obj);
+        RecordSpawnNPC(GetDeferredCommands(), obj->name, npc->spawnPoint, obj->squad);
+        break;
     // Ignore Events for other cases (e.g., move, defend) as dead NPCs cannot perform these actions.
+    // EVENT_NONE no longer revives the NPC, it stays dead until it is respawned.
+    case EVENT_NONE:
     case EVENT_DIE:
     case EVENT_ATTACK:
     case EVENT_MOVE:
@@ -391,25 +678,18 @@ void NPCEnterIdle(GameObject *obj)
     if (npc->base.previousState != npc->base.currentState && npc->base.currentState == STATE_IDLE)
     {
         // Setup Idle Animations
-        Rectangle idle[7] = {
-            {0, 128, 64, 64},   // Frame 1: Row 3, Column 1
-            {64, 128, 64, 64},  // Frame 2: Row 3, Column 2
-            {128, 128, 64, 64}, // Frame 3: Row 3, Column 3
-            {192, 128, 64, 64}, // Frame 4: Row 3, Column 4
-            {256, 128, 64, 64}, // Frame 5: Row 3, Column 5
-            {320, 128, 64, 64}, // Frame 6: Row 3, Column 6
-            {384, 128, 64, 64}  // Frame 7: Row 3, Column 7
-        };
-
         // Initialize the idle animation frames and play it
         InitGameObjectAnimation(&npc->base, idle, 6, 0.2f);
     }
 }
 
-// Update function for Idle state, called repeatedly during game ticks while in Idle
-void NPCUpdateIdle(GameObject *obj) {
+// Idle movement speeds up by this much on each bounce, up to at most this many units per tick
+static const float IDLE_SPEED_INCREASE = 1.1f;
+static const float IDLE_MAX_SPEED = 5.0f;
 
-//    Vector2 playerPos = getPlayerPos(  );
+// Moves the NPC one tick along its idle path, bouncing off the world edges
+static void NPCIdleMove(GameObject *obj)
+{
     // Set initial velocity if not moving
     if (obj->velocity.x == 0 && obj->velocity.y == 0) {
         obj->velocity.x = obj->speed;
@@ -420,38 +700,107 @@ void NPCUpdateIdle(GameObject *obj) {
     obj->position.x += obj->velocity.x;
     obj->position.y += obj->velocity.y;
 
-    // Check for death condition
-    if (obj->health <= 0) {
-        ChangeState(obj, STATE_DEAD);
-        return;
-    }
-    // Clamp velocity to maximum of 10f
-    const float MAX_SPEED = 5.0f;
-    const float SPEED_INCREASE = 1.1f;
-
-    // Screen boundary checks with speed increase and clamping
-    if (obj->position.x <= 0 || obj->position.x >= GetScreenWidth()) {
+    // World boundary checks with speed increase and clamping
+    if (obj->position.x <= 0 || obj->position.x >= WORLD_WIDTH) {
         obj->velocity.x *= -1;  // Reverse horizontal direction
         // Increase speed but clamp to maximum
-        obj->velocity.x = obj->velocity.x * SPEED_INCREASE;
-        if (obj->velocity.x > MAX_SPEED) obj->velocity.x = MAX_SPEED;
-        if (obj->velocity.x < -MAX_SPEED) obj->velocity.x = -MAX_SPEED;
+        obj->velocity.x = obj->velocity.x * IDLE_SPEED_INCREASE;
+        if (obj->velocity.x > IDLE_MAX_SPEED) obj->velocity.x = IDLE_MAX_SPEED;
+        if (obj->velocity.x < -IDLE_MAX_SPEED) obj->velocity.x = -IDLE_MAX_SPEED;
     }
 
-    if (obj->position.y <= 0 || obj->position.y >= GetScreenHeight()) {
+    if (obj->position.y <= 0 || obj->position.y >= WORLD_HEIGHT) {
         obj->velocity.y *= -1;  // Reverse vertical direction
         // Increase speed but clamp to maximum
-        obj->velocity.y = obj->velocity.y * SPEED_INCREASE;
-        if (obj->velocity.y > MAX_SPEED) obj->velocity.y = MAX_SPEED;
-        if (obj->velocity.y < -MAX_SPEED) obj->velocity.y = -MAX_SPEED;
+        obj->velocity.y = obj->velocity.y * IDLE_SPEED_INCREASE;
+        if (obj->velocity.y > IDLE_MAX_SPEED) obj->velocity.y = IDLE_MAX_SPEED;
+        if (obj->velocity.y < -IDLE_MAX_SPEED) obj->velocity.y = -IDLE_MAX_SPEED;
     }
 
     // Update collider position
     obj->collider.p.x = obj->position.x;
     obj->collider.p.y = obj->position.y;
+}
 
+// Update function for Idle state, called repeatedly during game ticks while in Idle
+void NPCUpdateIdle(GameObject *obj) {
 
-    UpdateAnimation(&obj->animation);
+//    Vector2 playerPos = getPlayerPos(  );
+    // Check for death condition
+    if (obj->health <= 0) {
+        DeferChangeState(obj, STATE_DEAD);
+        return;
+    }
+
+    NPCIdleMove(obj);
+
+    // Nobody close enough to notice, sleep until the player comes near or the AI sends an event
+    if (!IsNearSchedulerFocus(obj, NPC_WAKE_RADIUS)) {
+        SleepGameObject(obj, 0.0f, NPC_WAKE_RADIUS);
+    }
+}
+
+// Ticks until an idle axis moving at velocity reaches the wall ahead (at least one, the
+// move that reaches it is the one that bounces)
+static float TicksToIdleWall(float position, float velocity, float limit)
+{
+    float toWall = (velocity > 0.0f ? limit - position : -position) / velocity;
+    return fmaxf(ceilf(toWall), 1.0f);
+}
+
+// Skips one axis of the idle movement ahead by a number of ticks, bouncing between 0 and
+// limit the way NPCIdleMove does. It steps wall to wall while bounces still speed it up
+// (a bounded number of them). Once a bounce leaves it at full speed the path repeats
+// every two bounces, so whole repeats are skipped at once.
+static void SkipIdleAxis(float *position, float *velocity, float limit, float ticks)
+{
+    bool repeating = false;
+    bool skipped = false;
+
+    while (ticks > 0.0f && *velocity != 0.0f)
+    {
+        if (repeating && !skipped)
+        {
+            float there = TicksToIdleWall(*position, *velocity, limit);
+            float back = TicksToIdleWall(*position + *velocity * there, -*velocity, limit);
+            ticks = fmodf(ticks, there + back);
+            skipped = true;
+            continue;
+        }
+
+        float steps = TicksToIdleWall(*position, *velocity, limit);
+        if (steps > ticks)
+        {
+            *position += *velocity * ticks;
+            return;
+        }
+
+        *position += *velocity * steps;
+        *velocity = Clamp(-*velocity * IDLE_SPEED_INCREASE, -IDLE_MAX_SPEED, IDLE_MAX_SPEED);
+        ticks -= steps;
+        repeating = fabsf(*velocity) >= IDLE_MAX_SPEED;
+    }
+}
+
+// Resume function for Idle state, moves the NPC to where its idle path would have taken it
+// while asleep (without stepping through the missed ticks, so long sleeps cost no more)
+void NPCResumeIdle(GameObject *obj, float elapsed)
+{
+    float ticks = floorf(elapsed * TIMER_TICKS_PER_SECOND);
+    if (ticks <= 0.0f) {
+        return;
+    }
+
+    if (obj->velocity.x == 0 && obj->velocity.y == 0) {
+        obj->velocity.x = obj->speed;
+        obj->velocity.y = obj->speed;
+    }
+
+    SkipIdleAxis(&obj->position.x, &obj->velocity.x, WORLD_WIDTH, ticks);
+    SkipIdleAxis(&obj->position.y, &obj->velocity.y, WORLD_HEIGHT, ticks);
+
+    obj->collider.p.x = obj->position.x;
+    obj->collider.p.y = obj->position.y;
 }
 
 
@@ -468,6 +817,51 @@ void NPCExitIdle(GameObject *obj)
     // Cleanup code for leaving Idle state, if any.
 }
 
+// Enter function for Walking state, executed once upon entering Walking
+void NPCEnterWalking(GameObject *obj)
+{
+    NPC *npc = (NPC *)obj;
+    printf("%s -> ENTER -> Walking\n", obj->name);
+    printf("Aggression: %d\n\n", npc->aggression);
+
+    // The sheet has no walk cycle, NPCs chase with the idle animation (already playing if they were idle)
+    if (obj->previousState != STATE_IDLE)
+    {
+        InitGameObjectAnimation(&npc->base, idle, 6, 0.2f);
+    }
+
+    // The crowd steers its velocity along the flow field and around other walkers
+    AddCrowdAgent(obj);
+}
+
+// Update function for Walking state, called repeatedly during game ticks while in Walking
+void NPCUpdateWalking(GameObject *obj)
+{
+    // Check for death condition
+    if (obj->health <= 0) {
+        DeferChangeState(obj, STATE_DEAD);
+        return;
+    }
+
+    // Velocity was steered by the crowd this update
+    obj->position = Vector2Add(obj->position, obj->velocity);
+
+    // Update collider position
+    obj->collider.p.x = obj->position.x;
+    obj->collider.p.y = obj->position.y;
+}
+
+// Exit function for Walking state, executed once upon leaving Walking
+void NPCExitWalking(GameObject *obj)
+{
+    NPC *npc = (NPC *)obj;
+    printf("%s <- EXIT <- Walking\n", obj->name);
+    printf("Aggression: %d\n\n", npc->aggression);
+
+    // Back to moving on its own
+    RemoveCrowdAgent(obj);
+}
+
 // Enter function for Attacking state, executed once upon entering Attacking
 void NPCEnterAttacking(GameObject *obj)
 {
@@ -475,15 +869,6 @@ void NPCEnterAttacking(GameObject *obj)
     printf("%s -> ENTER -> Attacking\n", obj->name);
     printf("Aggression: %d\n\n", npc->aggression);
     // Initialization code for entering Attacking state, such as setting up attack animations.
-    Rectangle attacking[6] = {
-        {0, 3328, 192, 192},   // Frame 1: Row 53, Column 1
-        {192, 3328, 192, 192}, // Frame 2: Row 53, Column 2
-        {384, 3328, 192, 192}, // Frame 3: Row 53, Column 3
-        {576, 3520, 192, 192}, // Frame 4: Row 53, Column 4
-        {768, 3520, 192, 192}, // Frame 5: Row 53, Column 5
-        {960, 3520, 192, 192}  // Frame 6: Row 53, Column 6
-    };
-
     // Initialize the idle animation frames and play it
     InitGameObjectAnimation(&npc->base, attacking, 6, 0.2f);
 }
@@ -495,7 +880,6 @@ void NPCUpdateAttacking(GameObject *obj)
     printf("%s -> UPDATE -> Attacking\n", obj->name);
     printf("Aggression: %d\n\n", npc->aggression);
     // During game loop and game ticks, execute Attacking state behavior here, such as dealing damage.
-    UpdateAnimation(&obj->animation);
 }
 
 // Exit function for Attacking state, executed once upon leaving Attacking
@@ -505,7 +889,6 @@ void NPCExitAttacking(GameObject *obj)
     printf("%s <- EXIT <- Attacking\n", obj->name);
     printf("Aggression: %d\n\n", npc->aggression);
     // Cleanup code for leaving Attacking state, such as resetting attack cooldown.
-    UpdateAnimation(&obj->animation);
 }
 
 // Enter function for Shielding state, executed once upon entering Shielding
@@ -516,17 +899,6 @@ void NPCEnterShielding(GameObject *obj)
     printf("Aggression: %d\n\n", npc->aggression);
     // Initialization code for entering Shielding state, such as enabling shield effects.
 
-    Rectangle sheilding[8] = {
-        {0, 384, 64, 64},   // Frame 1: Row 7, Column 1
-        {64, 384, 64, 64},  // Frame 2: Row 7, Column 2
-        {128, 384, 64, 64}, // Frame 3: Row 7, Column 3
-        {192, 384, 64, 64}, // Frame 4: Row 7, Column 4
-        {256, 384, 64, 64}, // Frame 5: Row 7, Column 5
-        {320, 384, 64, 64}, // Frame 6: Row 7, Column 6
-        {384, 384, 64, 64}, // Frame 7: Row 7, Column 7
-        {448, 384, 64, 64}  // Frame 8: Row 7, Column 8
-    };
-
     // Initialize attack animation
     InitGameObjectAnimation(&npc->base, sheilding, 6, 0.2f);
 }
@@ -538,7 +910,9 @@ void NPCUpdateShielding(GameObject *obj)
     printf("%s -> UPDATE -> Shielding\n", obj->name);
     printf("Aggression: %d\n\n", npc->aggression);
     // During game loop and game ticks, execute Shielding state behavior here, such as reducing incoming damage.
-    UpdateAnimation(&obj->animation);
+
+    // Nothing but the animation changes until the next event
+    SleepGameObject(obj, 0.0f, 0.0f);
 }
 
 // Exit function for Shielding state, executed once upon leaving Shielding
@@ -557,16 +931,11 @@ void NPCEnterDead(GameObject *obj)
     printf("%s -> ENTER -> Dead\n", obj->name);
     printf("Aggression: %d\n\n", npc->aggression);
     // Initialization code for entering Dead state, such as playing death animation or disabling further actions.
-    Rectangle dead[6] = {
-        {0, 1280, 64, 64},   // Frame 1: Row 21, Column 1
-        {64, 1280, 64, 64},  // Frame 1: Row 21, Column 2
-        {128, 1280, 64, 64}, // Frame 1: Row 21, Column 3
-        {192, 1280, 64, 64}, // Frame 1: Row 21, Column 4
-        {256, 1280, 64, 64}, // Frame 1: Row 21, Column 5
-        {320, 1280, 64, 64}  // Frame 1: Row 21, Column 6
-    };
     // Initialize dead animation
     InitGameObjectAnimation(&npc->base, dead, 6, 0.2f);
+
+    // Despawn (and respawn) once the corpse has been on screen for a while
+    SetStateTimeout(obj, NPC_CORPSE_DURATION);
 }
 
 // Update function for Dead state, called repeatedly during game ticks while in Dead
@@ -577,7 +946,9 @@ void NPCUpdateDead(GameObject *obj)
     printf("Aggression: %d\n\n", npc->aggression);
     // During game loop and game ticks, execute Dead state behavior here, such as preventing any actions.
     // This could be a place to check if the NPC should be removed or respawned.
-    UpdateAnimation(&obj->animation);
+
+    // Nothing but the animation changes until the next event
+    SleepGameObject(obj, 0.0f, 0.0f);
 }
 
 // Exit function for Dead state, executed once upon leaving Dead
@@ -0,0 +1,339 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <rlgl.h>
+
+#include "../include/render/overlay_batch.h"
+
+// Triangles recorded this frame, three vertices each
+static OverlayVertex *vertices = NULL;
+static int vertexCount = 0;
+static int vertexCapacity = 0;
+
+static bool recording = false;
+static int drawCalls = 0;
+
+// Vertices handed to rlgl between batch limit checks
+#define OVERLAY_VERTICES_PER_CHECK (3 * 1024)
+
+// Segments used for a circle, bounded so tiny circles stay round and big ones cheap
+#define OVERLAY_CIRCLE_MIN_SEGMENTS 12
+#define OVERLAY_CIRCLE_MAX_SEGMENTS 64
+
+/**
+ * InitOverlayBatch - Initialises the overlay batch.
+ *
+ * Health bars, shields and debug shapes submitted between BeginOverlayBatch and
+ * EndOverlayBatch are turned into triangles and drawn together in one draw call,
+ * instead of one immediate mode draw per shape.
+ */
+void InitOverlayBatch()
+{
+    vertexCount = 0;
+    recording = false;
+    drawCalls = 0;
+}
+
+/**
+ * BeginOverlayBatch - Starts recording overlay primitives for a frame.
+ */
+void BeginOverlayBatch()
+{
+    vertexCount = 0;
+    recording = true;
+}
+
+// Emits triangles with the default (white) texture, returns the draw calls it took
+static int EmitOverlayVertices(const OverlayVertex *emitted, int count)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    int calls = 1;
+    rlSetTexture(rlGetTextureIdDefault());
+
+    for (int first = 0; first < count; first += OVERLAY_VERTICES_PER_CHECK)
+    {
+        int chunk = count - first;
+        if (chunk > OVERLAY_VERTICES_PER_CHECK)
+            chunk = OVERLAY_VERTICES_PER_CHECK;
+
+        // Only flushes (another draw call) if the rlgl batch is full
+        if (rlCheckRenderBatchLimit(chunk))
+            calls++;
+
+        rlBegin(RL_TRIANGLES);
+        for (int i = first; i < first + chunk; i++)
+        {
+            const OverlayVertex *vertex = &emitted[i];
+            rlColor4ub(vertex->color.r, vertex->color.g, vertex->color.b, vertex->color.a);
+            rlVertex2f(vertex->position.x, vertex->position.y);
+        }
+        rlEnd();
+    }
+
+    rlSetTexture(0);
+    return calls;
+}
+
+// Emits the recorded triangles
+static void FlushOverlayVertices()
+{
+    drawCalls += EmitOverlayVertices(vertices, vertexCount);
+    vertexCount = 0;
+}
+
+// Makes room for count more vertices
+static void ReserveOverlayVertices(int count)
+{
+    if (vertexCount + count <= vertexCapacity)
+    {
+        return;
+    }
+
+    int newCapacity = vertexCapacity ? vertexCapacity : 1024;
+    while (newCapacity < vertexCount + count)
+    {
+        newCapacity *= 2;
+    }
+
+    OverlayVertex *grown = (OverlayVertex *)realloc(vertices, sizeof(OverlayVertex) * newCapacity);
+    if (!grown)
+    {
+        fprintf(stderr, "Failed to allocate overlay batch\n");
+        exit(1);
+    }
+    vertices = grown;
+    vertexCapacity = newCapacity;
+}
+
+// Appends a triangle, counter clockwise on screen (y down) as rlgl expects
+static void AddOverlayTriangle(Vector2 a, Vector2 b, Vector2 c, Color color)
+{
+    vertices[vertexCount++] = (OverlayVertex){a, color};
+    vertices[vertexCount++] = (OverlayVertex){b, color};
+    vertices[vertexCount++] = (OverlayVertex){c, color};
+}
+
+// Appends a quad as two triangles, corners in the order top left, bottom left, bottom right, top right
+static void AddOverlayQuad(Vector2 topLeft, Vector2 bottomLeft, Vector2 bottomRight, Vector2 topRight, Color color)
+{
+    AddOverlayTriangle(topLeft, bottomLeft, topRight, color);
+    AddOverlayTriangle(topRight, bottomLeft, bottomRight, color);
+}
+
+// Number of segments to approximate a circle with
+static int CircleSegments(float radius)
+{
+    int segments = (int)ceilf(radius / 2.0f);
+    if (segments < OVERLAY_CIRCLE_MIN_SEGMENTS)
+        return OVERLAY_CIRCLE_MIN_SEGMENTS;
+    if (segments > OVERLAY_CIRCLE_MAX_SEGMENTS)
+        return OVERLAY_CIRCLE_MAX_SEGMENTS;
+    return segments;
+}
+
+// Draws what was just submitted if no batch is being recorded
+static void FlushIfImmediate()
+{
+    if (!recording)
+    {
+        FlushOverlayVertices();
+    }
+}
+
+/**
+ * SubmitOverlayRect - Records a filled rectangle.
+ *
+ * @rect:  The rectangle, in world coordinates.
+ * @color: The fill color.
+ *
+ * Outside of BeginOverlayBatch/EndOverlayBatch the rectangle is drawn immediately.
+ */
+void SubmitOverlayRect(Rectangle rect, Color color)
+{
+    if (rect.width <= 0.0f || rect.height <= 0.0f)
+        return;
+
+    ReserveOverlayVertices(6);
+    AddOverlayQuad((Vector2){rect.x, rect.y},
+                   (Vector2){rect.x, rect.y + rect.height},
+                   (Vector2){rect.x + rect.width, rect.y + rect.height},
+                   (Vector2){rect.x + rect.width, rect.y},
+                   color);
+    FlushIfImmediate();
+}
+
+/**
+ * SubmitOverlayCircle - Records a filled circle.
+ *
+ * @center: The centre of the circle, in world coordinates.
+ * @radius: The radius of the circle.
+ * @color:  The fill color.
+ */
+void SubmitOverlayCircle(Vector2 center, float radius, Color color)
+{
+    if (radius <= 0.0f)
+        return;
+
+    const int segments = CircleSegments(radius);
+    const float step = 2.0f * PI / segments;
+
+    ReserveOverlayVertices(3 * segments);
+    for (int i = 0; i < segments; i++)
+    {
+        Vector2 from = {center.x + cosf(step * i) * radius, center.y + sinf(step * i) * radius};
+        Vector2 to = {center.x + cosf(step * (i + 1)) * radius, center.y + sinf(step * (i + 1)) * radius};
+        AddOverlayTriangle(center, to, from, color);
+    }
+    FlushIfImmediate();
+}
+
+/**
+ * SubmitOverlayLine - Records a line with a thickness.
+ *
+ * @start:     The start of the line, in world coordinates.
+ * @end:       The end of the line, in world coordinates.
+ * @thickness: The width of the line.
+ * @color:     The line color.
+ */
+void SubmitOverlayLine(Vector2 start, Vector2 end, float thickness, Color color)
+{
+    const float dx = end.x - start.x;
+    const float dy = end.y - start.y;
+    const float length = sqrtf(dx * dx + dy * dy);
+    if (length <= 0.0f || thickness <= 0.0f)
+        return;
+
+    // Half the thickness either side of the line
+    const float nx = -dy / length * thickness / 2.0f;
+    const float ny = dx / length * thickness / 2.0f;
+
+    ReserveOverlayVertices(6);
+    AddOverlayQuad((Vector2){start.x - nx, start.y - ny},
+                   (Vector2){start.x + nx, start.y + ny},
+                   (Vector2){end.x + nx, end.y + ny},
+                   (Vector2){end.x - nx, end.y - ny},
+                   color);
+    FlushIfImmediate();
+}
+
+/**
+ * SubmitOverlayCircleLines - Records the outline of a circle.
+ *
+ * @center:    The centre of the circle, in world coordinates.
+ * @radius:    The radius of the circle (the middle of the outline).
+ * @thickness: The width of the outline.
+ * @color:     The outline color.
+ */
+void SubmitOverlayCircleLines(Vector2 center, float radius, float thickness, Color color)
+{
+    if (radius <= 0.0f || thickness <= 0.0f)
+        return;
+
+    const int segments = CircleSegments(radius);
+    const float step = 2.0f * PI / segments;
+    const float inner = fmaxf(radius - thickness / 2.0f, 0.0f);
+    const float outer = radius + thickness / 2.0f;
+
+    ReserveOverlayVertices(6 * segments);
+    for (int i = 0; i < segments; i++)
+    {
+        const float c0 = cosf(step * i), s0 = sinf(step * i);
+        const float c1 = cosf(step * (i + 1)), s1 = sinf(step * (i + 1));
+        AddOverlayQuad((Vector2){center.x + c0 * outer, center.y + s0 * outer},
+                       (Vector2){center.x + c0 * inner, center.y + s0 * inner},
+                       (Vector2){center.x + c1 * inner, center.y + s1 * inner},
+                       (Vector2){center.x + c1 * outer, center.y + s1 * outer},
+                       color);
+    }
+    FlushIfImmediate();
+}
+
+// Check if overlay primitives are being recorded
+bool IsOverlayBatchActive()
+{
+    return recording;
+}
+
+/**
+ * EndOverlayBatch - Draws the primitives recorded since BeginOverlayBatch.
+ *
+ * Every primitive is already triangles in submission order, so the whole frame
+ * is emitted as one block with the default texture: a single draw call unless
+ * rlgl's vertex buffer fills up.
+ */
+void EndOverlayBatch()
+{
+    recording = false;
+    drawCalls = 0;
+    FlushOverlayVertices();
+}
+
+/**
+ * TakeOverlayBatch - Moves the triangles recorded since BeginOverlayBatch into a list.
+ *
+ * @list: The list to fill, its previous triangles are replaced (grown as needed).
+ *
+ * Nothing in the list refers to the batch, so it can be drawn with DrawOverlayList
+ * on another thread while the next frame is recorded.
+ */
+void TakeOverlayBatch(OverlayList *list)
+{
+    recording = false;
+
+    if (vertexCount > list->capacity)
+    {
+        OverlayVertex *grown = (OverlayVertex *)realloc(list->vertices, sizeof(OverlayVertex) * vertexCapacity);
+        if (!grown)
+        {
+            fprintf(stderr, "Failed to allocate overlay list\n");
+            exit(1);
+        }
+        list->vertices = grown;
+        list->capacity = vertexCapacity;
+    }
+
+    if (vertexCount > 0)
+    {
+        memcpy(list->vertices, vertices, sizeof(OverlayVertex) * vertexCount);
+    }
+
+    list->count = vertexCount;
+    vertexCount = 0;
+}
+
+// Draw a list taken from the batch as one block of triangles
+void DrawOverlayList(const OverlayList *list)
+{
+    drawCalls = EmitOverlayVertices(list->vertices, list->count);
+}
+
+// Release a list's storage
+void ReleaseOverlayList(OverlayList *list)
+{
+    free(list->vertices);
+    *list = (OverlayList){0};
+}
+
+// Number of draw calls the last EndOverlayBatch or DrawOverlayList issued
+int GetOverlayBatchDrawCalls()
+{
+    return drawCalls;
+}
+
+/**
+ * ExitOverlayBatch - Releases the overlay batch storage.
+ */
+void ExitOverlayBatch()
+{
+    free(vertices);
+    vertices = NULL;
+    vertexCount = 0;
+    vertexCapacity = 0;
+    recording = false;
+}
@@ -0,0 +1,192 @@
+#include <math.h>
+#include <string.h>
+
+#include <raymath.h>
+
+#include "../include/utils/perception.h"
+#include "../include/utils/constants.h"
+
+// The facts of the current update
+static WorldFacts facts = {0};
+
+// Influence maps over the world, rebuilt with the facts
+static InfluenceMap *influence = NULL;
+
+// What each influence layer costs an NPC flanking the player: stay out of its attack
+// arc and off the spots other NPCs already hold
+static const float flankWeights[INFLUENCE_LAYER_COUNT] = {
+    [INFLUENCE_THREAT] = 0.0f,
+    [INFLUENCE_ALLIES] = 1.0f,
+    [INFLUENCE_DANGER] = 4.0f,
+};
+
+// What each influence layer costs a hurt NPC falling back: away from the player
+// and its attack arc, toward the other NPCs
+static const float retreatWeights[INFLUENCE_LAYER_COUNT] = {
+    [INFLUENCE_THREAT] = 2.0f,
+    [INFLUENCE_ALLIES] = -0.5f,
+    [INFLUENCE_DANGER] = 4.0f,
+};
+
+// Gets the unit direction the player faces from the direction it last moved in
+static Vector2 GetFacing(State direction)
+{
+    switch (direction)
+    {
+    case STATE_MOVING_UP:
+        return (Vector2){0.0f, -1.0f};
+    case STATE_MOVING_LEFT:
+        return (Vector2){-1.0f, 0.0f};
+    case STATE_MOVING_RIGHT:
+        return (Vector2){1.0f, 0.0f};
+    default:
+        // Attacks face down until the player has moved (see PlayerEnterAttacking)
+        return (Vector2){0.0f, 1.0f};
+    }
+}
+
+// Rebuilds the influence maps from the facts and the NPCs
+static void UpdateInfluence(NPC *const *npcs, int npcCount)
+{
+    ClearInfluenceMap(influence);
+
+    for (int i = 0; i < npcCount; i++)
+    {
+        const GameObject *npc = &npcs[i]->base;
+        if (npc->currentState != STATE_DEAD && npc->health > 0)
+        {
+            StampInfluence(influence, INFLUENCE_ALLIES, npc->position, 1.0f);
+        }
+    }
+
+    if (facts.playerPresent)
+    {
+        StampInfluenceCircle(influence, INFLUENCE_THREAT, facts.playerPosition, INFLUENCE_THREAT_RANGE,
+                             facts.playerAttacking ? 2.0f : 1.0f);
+        StampInfluenceArc(influence, INFLUENCE_DANGER, facts.playerPosition, facts.playerFacing,
+                          INFLUENCE_DANGER_RANGE, INFLUENCE_DANGER_COS_HALF_ANGLE);
+    }
+
+    // Each NPC was stamped on a point, spread it over the spots it crowds
+    BlurInfluence(influence, INFLUENCE_ALLIES, INFLUENCE_BLUR_PASSES);
+}
+
+/**
+ * InitPerception - Initialises the perception.
+ *
+ * The perception pass looks at the world once per update and publishes what
+ * the AI needs to know about it (where the player is, who threatens it, how
+ * many NPCs are doing what). Every AI consumer reads the same facts, on any
+ * thread, instead of each agent querying the objects again.
+ */
+void InitPerception()
+{
+    memset(&facts, 0, sizeof(facts));
+    facts.nearestThreatDistance = INFINITY;
+
+    influence = CreateInfluenceMap((WORLD_WIDTH + INFLUENCE_CELL_SIZE - 1) / INFLUENCE_CELL_SIZE,
+                                   (WORLD_HEIGHT + INFLUENCE_CELL_SIZE - 1) / INFLUENCE_CELL_SIZE,
+                                   INFLUENCE_CELL_SIZE);
+    facts.influence = influence;
+}
+
+/**
+ * ExitPerception - Frees the perception's influence maps.
+ *
+ * Called once at shutdown, after the AI has stopped reading the facts.
+ */
+void ExitPerception()
+{
+    DeleteInfluenceMap(influence);
+    influence = NULL;
+    facts.influence = NULL;
+}
+
+/**
+ * PublishWorldFacts - Works out this update's facts.
+ *
+ * @player:   The player (NULL if there is none).
+ * @npcs:     The NPCs in the world.
+ * @npcCount: The number of NPCs.
+ *
+ * Called on the simulation thread before the AI runs, the facts must not
+ * change while the AI reads them. The influence maps are rebuilt with them:
+ * threat around the player (stronger while it attacks), ally density around
+ * the living NPCs and danger in the player's attack arc.
+ */
+void PublishWorldFacts(const GameObject *player, NPC *const *npcs, int npcCount)
+{
+    unsigned long tick = facts.tick + 1;
+    memset(&facts, 0, sizeof(facts));
+    facts.tick = tick;
+    facts.nearestThreatDistance = INFINITY;
+    facts.influence = influence;
+
+    if (player)
+    {
+        facts.playerPresent = true;
+        facts.playerPosition = player->position;
+        facts.playerFacing = GetFacing(player->lastDirection);
+        facts.playerState = player->currentState;
+        facts.playerAttacking = player->currentState == STATE_ATTACKING;
+        facts.playerHealth = player->health;
+    }
+
+    facts.npcCount = npcCount;
+    for (int i = 0; i < npcCount; i++)
+    {
+        const GameObject *npc = &npcs[i]->base;
+        facts.npcsInState[npc->currentState]++;
+
+        if (npc->currentState == STATE_DEAD || npc->health <= 0)
+            continue;
+        facts.npcsAlive++;
+
+        if (!player)
+            continue;
+
+        float distance = Vector2Distance(npc->position, player->position);
+        if (distance < facts.nearestThreatDistance)
+        {
+            facts.nearestThreat = npc;
+            facts.nearestThreatDistance = distance;
+        }
+        if (npc->currentState == STATE_ATTACKING && distance <= NPC_ATTACK_RANGE)
+        {
+            facts.attackersInRange++;
+        }
+    }
+
+    if (influence)
+    {
+        UpdateInfluence(npcs, npcCount);
+    }
+}
+
+// Get the facts published this update
+const WorldFacts *GetWorldFacts()
+{
+    return &facts;
+}
+
+// Find a spot next to the player to attack it from (the player's position if there is no influence map)
+Vector2 FindFlankingPosition(const WorldFacts *facts, Vector2 approach)
+{
+    if (!facts->influence)
+    {
+        return facts->playerPosition;
+    }
+    return FindInfluencePosition(facts->influence, facts->playerPosition, NPC_FLANK_MIN_RANGE, NPC_FLANK_MAX_RANGE,
+                                 flankWeights, approach, INFLUENCE_TRAVEL_COST);
+}
+
+// Find a safer spot near a position (the position itself if there is no influence map)
+Vector2 FindRetreatPosition(const WorldFacts *facts, Vector2 from)
+{
+    if (!facts->influence)
+    {
+        return from;
+    }
+    return FindInfluencePosition(facts->influence, from, 0.0f, NPC_RETREAT_RANGE, retreatWeights,
+                                 from, INFLUENCE_TRAVEL_COST);
+}
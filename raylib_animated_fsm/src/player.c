@@ -1,4 +1,222 @@
 #include "../include/gameobjects/player.h"
+#include "../include/utils/constants.h"
+#include "../include/utils/scheduler.h"
+#include "../include/fsm/fsm_loader.h"
+#include "../include/render/texture_atlas.h"
+
+// Precompiled Player FSM graph, built from assets/fsm/player.fsm by tools/fsm_compiler
+#define PLAYER_FSM_GRAPH "assets/fsm/player.fsmb"
+
+// Player sprite sheet, packed into the texture atlas at startup
+#define PLAYER_SPRITE_SHEET "./assets/player_sprite_sheet.png"
+
+// Animation clips on the player sprite sheet (see grid_player_sprite_sheet.png for rows and columns).
+// RegisterPlayerAnimationClips hands them to the texture atlas, which rewrites them to atlas coordinates.
+
+// Idle animations, picked at random
+static Rectangle idle1[8] = {
+    {0, 320, 64, 64},   // Frame 1: Row 6, Column 1
+    {64, 320, 64, 64},  // Frame 2: Row 6, Column 2
+    {128, 320, 64, 64}, // Frame 3: Row 6, Column 3
+    {192, 320, 64, 64}, // Frame 4: Row 6, Column 4
+    {256, 320, 64, 64}, // Frame 5: Row 6, Column 5
+    {320, 320, 64, 64}, // Frame 6: Row 6, Column 6
+    {384, 320, 64, 64}, // Frame 7: Row 6, Column 7
+    {448, 320, 64, 64}  // Frame 8: Row 6, Column 8
+};
+
+static Rectangle idle2[8] = {
+    {0, 384, 64, 64},   // Frame 1: Row 7, Column 1
+    {64, 384, 64, 64},  // Frame 2: Row 7, Column 2
+    {128, 384, 64, 64}, // Frame 3: Row 7, Column 3
+    {192, 384, 64, 64}, // Frame 4: Row 7, Column 4
+    {256, 384, 64, 64}, // Frame 5: Row 7, Column 5
+    {320, 384, 64, 64}, // Frame 6: Row 7, Column 6
+    {384, 384, 64, 64}, // Frame 7: Row 7, Column 7
+    {448, 384, 64, 64}  // Frame 8: Row 7, Column 8
+};
+
+static Rectangle idle3[8] = {
+    {0, 448, 64, 64},   // Frame 1: Row 8, Column 1
+    {64, 448, 64, 64},  // Frame 2: Row 8, Column 2
+    {128, 448, 64, 64}, // Frame 3: Row 8, Column 3
+    {192, 448, 64, 64}, // Frame 4: Row 8, Column 4
+    {256, 448, 64, 64}, // Frame 5: Row 8, Column 5
+    {320, 448, 64, 64}, // Frame 6: Row 8, Column 6
+    {384, 448, 64, 64}, // Frame 7: Row 8, Column 7
+    {448, 448, 64, 64}  // Frame 8: Row 8, Column 8
+};
+
+static Rectangle idle4[13] = {
+    {0, 1024, 64, 64},   // Frame 1: Row 17, Column 1
+    {64, 1024, 64, 64},  // Frame 2: Row 17, Column 2
+    {128, 1024, 64, 64}, // Frame 3: Row 17, Column 3
+    {192, 1024, 64, 64}, // Frame 4: Row 17, Column 4
+    {256, 1024, 64, 64}, // Frame 5: Row 17, Column 5
+    {320, 1024, 64, 64}, // Frame 6: Row 17, Column 6
+    {384, 1024, 64, 64}, // Frame 7: Row 17, Column 7
+    {448, 1024, 64, 64}, // Frame 8: Row 17, Column 8
+    {512, 1024, 64, 64}, // Frame 9: Row 17, Column 9
+    {576, 1024, 64, 64}, // Frame 10: Row 17, Column 10
+    {640, 1024, 64, 64}, // Frame 11: Row 17, Column 11
+    {704, 1024, 64, 64}, // Frame 12: Row 17, Column 12
+    {768, 1024, 64, 64}  // Frame 13: Row 17, Column 13
+};
+
+static Rectangle idle5[13] = {
+    {0, 1088, 64, 64},   // Frame 1: Row 18, Column 1
+    {64, 1088, 64, 64},  // Frame 2: Row 18, Column 2
+    {128, 1088, 64, 64}, // Frame 3: Row 18, Column 3
+    {192, 1088, 64, 64}, // Frame 4: Row 18, Column 4
+    {256, 1088, 64, 64}, // Frame 5: Row 18, Column 5
+    {320, 1088, 64, 64}, // Frame 6: Row 18, Column 6
+    {384, 1088, 64, 64}, // Frame 7: Row 18, Column 7
+    {448, 1088, 64, 64}, // Frame 8: Row 18, Column 8
+    {512, 1088, 64, 64}, // Frame 9: Row 18, Column 9
+    {576, 1088, 64, 64}, // Frame 10: Row 18, Column 10
+    {640, 1088, 64, 64}, // Frame 11: Row 18, Column 11
+    {704, 1088, 64, 64}, // Frame 12: Row 18, Column 12
+    {768, 1088, 64, 64}  // Frame 13: Row 18, Column 13
+};
+
+static Rectangle idle6[13] = {
+    {0, 1152, 64, 64},   // Frame 1: Row 19, Column 1
+    {64, 1152, 64, 64},  // Frame 2: Row 19, Column 2
+    {128, 1152, 64, 64}, // Frame 3: Row 19, Column 3
+    {192, 1152, 64, 64}, // Frame 4: Row 19, Column 4
+    {256, 1152, 64, 64}, // Frame 5: Row 19, Column 5
+    {320, 1152, 64, 64}, // Frame 6: Row 19, Column 6
+    {384, 1152, 64, 64}, // Frame 7: Row 19, Column 7
+    {448, 1152, 64, 64}, // Frame 8: Row 19, Column 8
+    {512, 1152, 64, 64}, // Frame 9: Row 19, Column 9
+    {576, 1152, 64, 64}, // Frame 10: Row 19, Column 10
+    {640, 1152, 64, 64}, // Frame 11: Row 19, Column 11
+    {704, 1152, 64, 64}, // Frame 12: Row 19, Column 12
+    {768, 1152, 64, 64}  // Frame 13: Row 19, Column 13
+};
+
+static Rectangle idle7[13] = {
+    {0, 1216, 64, 64},   // Frame 1: Row 20, Column 1
+    {64, 1216, 64, 64},  // Frame 2: Row 20, Column 2
+    {128, 1216, 64, 64}, // Frame 3: Row 20, Column 3
+    {192, 1216, 64, 64}, // Frame 4: Row 20, Column 4
+    {256, 1216, 64, 64}, // Frame 5: Row 20, Column 5
+    {320, 1216, 64, 64}, // Frame 6: Row 20, Column 6
+    {384, 1216, 64, 64}, // Frame 7: Row 20, Column 7
+    {448, 1216, 64, 64}, // Frame 8: Row 20, Column 8
+    {512, 1216, 64, 64}, // Frame 9: Row 20, Column 9
+    {576, 1216, 64, 64}, // Frame 10: Row 20, Column 10
+    {640, 1216, 64, 64}, // Frame 11: Row 20, Column 11
+    {704, 1216, 64, 64}, // Frame 12: Row 20, Column 12
+    {768, 1216, 64, 64}  // Frame 13: Row 20, Column 13
+};
+
+// Walking animations for each direction (diagonals use the vertical rows)
+static Rectangle walkUp[9] = {  // Row 8
+    {0, 512, 64, 64},
+    {64, 512, 64, 64},
+    {128, 512, 64, 64},
+    {192, 512, 64, 64},
+    {256, 512, 64, 64},
+    {320, 512, 64, 64},
+    {384, 512, 64, 64},
+    {448, 512, 64, 64},
+    {512, 512, 64, 64}
+};
+
+static Rectangle walkLeft[9] = {  // Row 9
+    {0, 576, 64, 64},
+    {64, 576, 64, 64},
+    {128, 576, 64, 64},
+    {192, 576, 64, 64},
+    {256, 576, 64, 64},
+    {320, 576, 64, 64},
+    {384, 576, 64, 64},
+    {448, 576, 64, 64},
+    {512, 576, 64, 64}
+};
+
+static Rectangle walkDown[9] = {  // Row 10
+    {0, 640, 64, 64},
+    {64, 640, 64, 64},
+    {128, 640, 64, 64},
+    {192, 640, 64, 64},
+    {256, 640, 64, 64},
+    {320, 640, 64, 64},
+    {384, 640, 64, 64},
+    {448, 640, 64, 64},
+    {512, 640, 64, 64}
+};
+
+static Rectangle walkRight[9] = {  // Row 11
+    {0, 704, 64, 64},
+    {64, 704, 64, 64},
+    {128, 704, 64, 64},
+    {192, 704, 64, 64},
+    {256, 704, 64, 64},
+    {320, 704, 64, 64},
+    {384, 704, 64, 64},
+    {448, 704, 64, 64},
+    {512, 704, 64, 64}
+};
+
+// Attack animations for each direction
+static Rectangle attackDown[6] = {
+    {0,   3328, 192, 192},
+    {192, 3328, 192, 192},
+    {384, 3328, 192, 192},
+    {576, 3328, 192, 192},
+    {768, 3328, 192, 192},
+    {960, 3328, 192, 192}
+};
+
+static Rectangle attackUp[6] = {
+    {0,   2994, 192, 192},
+    {192, 2994, 192, 192},
+    {384, 2994, 192, 192},
+    {576, 2994, 192, 192},
+    {768, 2994, 192, 192},
+    {960, 2994, 192, 192}
+};
+
+// Attack Left Animation
+static Rectangle attackLeft[6] = {
+    {0,   3136, 192, 192},
+    {192, 3136, 192, 192},
+    {384, 3136, 192, 192},
+    {576, 3136, 192, 192},
+    {768, 3136, 192, 192},
+    {960, 3136, 192, 192}
+};
+
+// Attack Right Animation
+static Rectangle attackRight[6] = {
+    {0,   3520, 192, 192},
+    {192, 3520, 192, 192},
+    {384, 3520, 192, 192},
+    {576, 3520, 192, 192},
+    {768, 3520, 192, 192},
+    {960, 3520, 192, 192}
+};
+
+// Death, respawn and shield animations
+static Rectangle deadFrames[6] = {
+    {0, 1280, 64, 64}, {64, 1280, 64, 64},
+    {128, 1280, 64, 64}, {192, 1280, 64, 64},
+    {256, 1280, 64, 64}, {320, 1280, 64, 64}
+};
+
+static Rectangle respawnFrames[8] = {
+    {0, 384, 64, 64}, {64, 384, 64, 64},
+    {128, 384, 64, 64}, {192, 384, 64, 64},
+    {256, 384, 64, 64}, {320, 384, 64, 64},
+    {384, 384, 64, 64}, {448, 384, 64, 64}
+};
+
+static Rectangle shieldFrames[8] = {
+    {0, 384, 64, 64}, {64, 384, 64, 64}, {128, 384, 64, 64}, {192, 384, 64, 64},
+    {256, 384, 64, 64}, {320, 384, 64, 64}, {384, 384, 64, 64}, {448, 384, 64, 64}
+};
 
 // Initialize a new Player object with a given name
 /**
@@ -27,20 +245,20 @@ Player *InitPlayer(const char *name)
     }
 
     // Load player texture
-    Texture2D playerTexture = LoadTexture("./assets/player_sprite_sheet.png");
+    Texture2D playerTexture = GetAtlasTexture(PLAYER_SPRITE_SHEET);
 
     InitGameObject(&player->base,
                    name,                                                         // Name
-                   (Vector2){GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f}, // Position
+                   (Vector2){WORLD_WIDTH / 2.0f, WORLD_HEIGHT / 2.0f}, // Position
                    (Vector2){0, 0},                                              // Velocity
                    STATE_IDLE,                                                   // Initial State
                    GREEN,                                                        // Player Color
                    (c2Circle){                                                   // cute_c2 Circle Collider
-                           .p = {GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f},
+                           .p = {WORLD_WIDTH / 2.0f, WORLD_HEIGHT / 2.0f},
                            .r = 10},
                    (c2AABB){// AABB Collider for boundary checks
-                           .min = {GetScreenWidth() / 2.0f - 10, GetScreenHeight() / 2.0f - 10},
-                           .max = {GetScreenWidth() / 2.0f + 10, GetScreenHeight() / 2.0f + 10}},
+                           .min = {WORLD_WIDTH / 2.0f - 10, WORLD_HEIGHT / 2.0f - 10},
+                           .max = {WORLD_WIDTH / 2.0f + 10, WORLD_HEIGHT / 2.0f + 10}},
                    playerTexture,
                    100, // Initial Health
                    2
@@ -50,6 +268,11 @@ Player *InitPlayer(const char *name)
     player->stamina = 100.0f;
     player->mana = 100.0f;
     player->lives = 4;  // Set initial lives to 4
+    player->attackCooldown = TIMER_HANDLE_NONE;
+    player->regenTick = GetTimerTick();
+    player->shieldColor = (Color){0, 255, 128, 128};
+    player->shieldRadius = 90.0f;
+    player->shieldActive = false; // Drawn by BuildRenderSnapshot while set
 
     // Init the Player FSM
     InitPlayerFSM(&player->base);
@@ -89,13 +312,28 @@ void DeletePlayer(GameObject *obj)
  *
  * @obj: The GameObject (Player) to initialize the FSM for.
  *
- * This function sets up the state machine for the Player, allocating memory for
- * state configurations, defining valid state transitions, and associating
- * state handler functions with each state.
+ * This function sets up the state machine for the Player. The compiled graph is
+ * shared by every Player when the blob loads, otherwise memory is allocated for
+ * state configurations, valid state transitions are defined and state handler
+ * functions are associated with each state.
  */
 void InitPlayerFSM(GameObject *obj)
 {
-    obj->stateConfigs = (StateConfig *)malloc(sizeof(StateConfig) * STATE_COUNT);
+    // Builds with generated dispatch call the handlers through switches compiled from
+    // the same definition, the state table is still used for names and debugging
+    obj->archetype = FSM_ARCHETYPE_PLAYER;
+
+    // Share the precompiled graph (assets/fsm/player.fsm) when it is available
+    FsmGraph *graph = GetFsmGraph(PLAYER_FSM_GRAPH);
+    if (graph)
+    {
+        obj->stateConfigs = graph->states;
+        obj->sharedStateConfigs = true;
+        return;
+    }
+
+    // Otherwise build the state tables for this object at runtime
+    obj->stateConfigs = (StateConfig *)calloc(STATE_COUNT, sizeof(StateConfig));
     if (!obj->stateConfigs)
     {
         fprintf(stderr, "Failed to allocate state configs\n");
@@ -112,10 +350,15 @@ void InitPlayerFSM(GameObject *obj)
     obj->stateConfigs[STATE_IDLE].Entry = PlayerEnterIdle;
     obj->stateConfigs[STATE_IDLE].Update = PlayerUpdateIdle;
     obj->stateConfigs[STATE_IDLE].Exit = PlayerExitIdle;
+    obj->stateConfigs[STATE_IDLE].Resume = PlayerResumeIdle;
 
     // Configure valid transitions for STATE_IDLE
     StateTransitions(&obj->stateConfigs[STATE_IDLE], idleValidTransitions, sizeof(idleValidTransitions) / sizeof(State));
 
+    // Events STATE_IDLE reacts to, the others are dropped
+    Event idleEvents[] = {EVENT_NONE, EVENT_MOVE, EVENT_ATTACK, EVENT_DEFEND, EVENT_DIE, EVENT_SHIELD, EVENT_MOVE_UP, EVENT_MOVE_DOWN, EVENT_MOVE_LEFT, EVENT_MOVE_RIGHT, EVENT_MOVE_UP_LEFT, EVENT_MOVE_UP_RIGHT, EVENT_MOVE_DOWN_LEFT, EVENT_MOVE_DOWN_RIGHT};
+    StateEvents(&obj->stateConfigs[STATE_IDLE], idleEvents, sizeof(idleEvents) / sizeof(Event));
+
     // ---- STATE_WALKING state configuration ----
     // Define valid transitions from STATE_WALKING
     State walkingValidTransitions[] = {STATE_WALKING, STATE_ATTACKING, STATE_SHIELD, STATE_DEAD,STATE_MOVING_UP,STATE_MOVING_RIGHT,STATE_MOVING_LEFT,STATE_MOVING_DOWN,STATE_MOVING_UP_LEFT,STATE_MOVING_UP_RIGHT,STATE_MOVING_DOWN_LEFT,STATE_MOVING_DOWN_RIGHT};
@@ -129,6 +372,10 @@ void InitPlayerFSM(GameObject *obj)
 
     // Configure valid transitions for STATE_WALKING
     StateTransitions(&obj->stateConfigs[STATE_WALKING], walkingValidTransitions, sizeof(walkingValidTransitions) / sizeof(State));
+
+    // Events STATE_WALKING and the moving states react to, the others are dropped
+    Event walkingEvents[] = {EVENT_NONE, EVENT_ATTACK, EVENT_DIE, EVENT_MOVE_UP, EVENT_MOVE_DOWN, EVENT_MOVE_LEFT, EVENT_MOVE_RIGHT, EVENT_MOVE_UP_LEFT, EVENT_MOVE_UP_RIGHT, EVENT_MOVE_DOWN_LEFT, EVENT_MOVE_DOWN_RIGHT};
+    StateEvents(&obj->stateConfigs[STATE_WALKING], walkingEvents, sizeof(walkingEvents) / sizeof(Event));
 // Up Movement
     State movingUpValidTransitions[] = {STATE_IDLE, STATE_ATTACKING, STATE_DEAD};
     obj->stateConfigs[STATE_MOVING_UP].name = "Player_Moving_Up";
@@ -137,6 +384,7 @@ void InitPlayerFSM(GameObject *obj)
     obj->stateConfigs[STATE_MOVING_UP].Update = PlayerUpdateWalking;
     obj->stateConfigs[STATE_MOVING_UP].Exit = PlayerExitWalking;
     StateTransitions(&obj->stateConfigs[STATE_MOVING_UP], movingUpValidTransitions, sizeof(movingUpValidTransitions) / sizeof(State));
+    StateEvents(&obj->stateConfigs[STATE_MOVING_UP], walkingEvents, sizeof(walkingEvents) / sizeof(Event));
 
 // Down Movement
     State movingDownValidTransitions[] = {STATE_IDLE, STATE_ATTACKING, STATE_DEAD};
@@ -146,6 +394,7 @@ void InitPlayerFSM(GameObject *obj)
     obj->stateConfigs[STATE_MOVING_DOWN].Update = PlayerUpdateWalking;
     obj->stateConfigs[STATE_MOVING_DOWN].Exit = PlayerExitWalking;
     StateTransitions(&obj->stateConfigs[STATE_MOVING_DOWN], movingDownValidTransitions, sizeof(movingDownValidTransitions) / sizeof(State));
+    StateEvents(&obj->stateConfigs[STATE_MOVING_DOWN], walkingEvents, sizeof(walkingEvents) / sizeof(Event));
 
 // Left Movement
     State movingLeftValidTransitions[] = {STATE_IDLE, STATE_ATTACKING, STATE_DEAD};
@@ -155,6 +404,7 @@ void InitPlayerFSM(GameObject *obj)
     obj->stateConfigs[STATE_MOVING_LEFT].Update = PlayerUpdateWalking;
     obj->stateConfigs[STATE_MOVING_LEFT].Exit = PlayerExitWalking;
     StateTransitions(&obj->stateConfigs[STATE_MOVING_LEFT], movingLeftValidTransitions, sizeof(movingLeftValidTransitions) / sizeof(State));
+    StateEvents(&obj->stateConfigs[STATE_MOVING_LEFT], walkingEvents, sizeof(walkingEvents) / sizeof(Event));
 
 // Right Movement
     State movingRightValidTransitions[] = {STATE_IDLE, STATE_ATTACKING, STATE_DEAD};
@@ -164,6 +414,7 @@ void InitPlayerFSM(GameObject *obj)
     obj->stateConfigs[STATE_MOVING_RIGHT].Update = PlayerUpdateWalking;
     obj->stateConfigs[STATE_MOVING_RIGHT].Exit = PlayerExitWalking;
     StateTransitions(&obj->stateConfigs[STATE_MOVING_RIGHT], movingRightValidTransitions, sizeof(movingRightValidTransitions) / sizeof(State));
+    StateEvents(&obj->stateConfigs[STATE_MOVING_RIGHT], walkingEvents, sizeof(walkingEvents) / sizeof(Event));
 // Up Left Movement
     State movingUpLeftValidTransitions[] = {STATE_IDLE, STATE_ATTACKING, STATE_DEAD};
     obj->stateConfigs[STATE_MOVING_UP_LEFT].name = "Player_Moving_Up_Left";
@@ -172,6 +423,7 @@ void InitPlayerFSM(GameObject *obj)
     obj->stateConfigs[STATE_MOVING_UP_LEFT].Update = PlayerUpdateWalking;
     obj->stateConfigs[STATE_MOVING_UP_LEFT].Exit = PlayerExitWalking;
     StateTransitions(&obj->stateConfigs[STATE_MOVING_UP_LEFT], movingUpLeftValidTransitions, sizeof(movingUpLeftValidTransitions) / sizeof(State));
+    StateEvents(&obj->stateConfigs[STATE_MOVING_UP_LEFT], walkingEvents, sizeof(walkingEvents) / sizeof(Event));
 
 // Up Right Movement
     State movingUpRightValidTransitions[] = {STATE_IDLE, STATE_ATTACKING, STATE_DEAD};
@@ -181,6 +433,7 @@ void InitPlayerFSM(GameObject *obj)
     obj->stateConfigs[STATE_MOVING_UP_RIGHT].Update = PlayerUpdateWalking;
     obj->stateConfigs[STATE_MOVING_UP_RIGHT].Exit = PlayerExitWalking;
     StateTransitions(&obj->stateConfigs[STATE_MOVING_UP_RIGHT], movingUpRightValidTransitions, sizeof(movingUpRightValidTransitions) / sizeof(State));
+    StateEvents(&obj->stateConfigs[STATE_MOVING_UP_RIGHT], walkingEvents, sizeof(walkingEvents) / sizeof(Event));
 
 // Down Left Movement
     State movingDownLeftValidTransitions[] = {STATE_IDLE, STATE_ATTACKING, STATE_DEAD};
@@ -190,6 +443,7 @@ void InitPlayerFSM(GameObject *obj)
     obj->stateConfigs[STATE_MOVING_DOWN_LEFT].Update = PlayerUpdateWalking;
     obj->stateConfigs[STATE_MOVING_DOWN_LEFT].Exit = PlayerExitWalking;
     StateTransitions(&obj->stateConfigs[STATE_MOVING_DOWN_LEFT], movingDownLeftValidTransitions, sizeof(movingDownLeftValidTransitions) / sizeof(State));
+    StateEvents(&obj->stateConfigs[STATE_MOVING_DOWN_LEFT], walkingEvents, sizeof(walkingEvents) / sizeof(Event));
 
 // Down Right Movement
     State movingDownRightValidTransitions[] = {STATE_IDLE, STATE_ATTACKING, STATE_DEAD};
@@ -199,6 +453,7 @@ void InitPlayerFSM(GameObject *obj)
     obj->stateConfigs[STATE_MOVING_DOWN_RIGHT].Update = PlayerUpdateWalking;
     obj->stateConfigs[STATE_MOVING_DOWN_RIGHT].Exit = PlayerExitWalking;
     StateTransitions(&obj->stateConfigs[STATE_MOVING_DOWN_RIGHT], movingDownRightValidTransitions, sizeof(movingDownRightValidTransitions) / sizeof(State));
+    StateEvents(&obj->stateConfigs[STATE_MOVING_DOWN_RIGHT], walkingEvents, sizeof(walkingEvents) / sizeof(Event));
  //for shield
     State shieldValidTransitions[] = {STATE_IDLE, STATE_DEAD};
     obj->stateConfigs[STATE_SHIELD].name = "Player_Shield";
@@ -208,6 +463,10 @@ void InitPlayerFSM(GameObject *obj)
     obj->stateConfigs[STATE_SHIELD].Exit = PlayerExitShield;
     StateTransitions(&obj->stateConfigs[STATE_SHIELD], shieldValidTransitions, sizeof(shieldValidTransitions) / sizeof(State));
 
+    // Events STATE_SHIELD reacts to, the others are dropped
+    Event shieldEvents[] = {EVENT_DIE, EVENT_TIMEOUT, EVENT_MOVE_UP, EVENT_MOVE_DOWN, EVENT_MOVE_LEFT, EVENT_MOVE_RIGHT, EVENT_MOVE_UP_LEFT, EVENT_MOVE_UP_RIGHT, EVENT_MOVE_DOWN_LEFT, EVENT_MOVE_DOWN_RIGHT};
+    StateEvents(&obj->stateConfigs[STATE_SHIELD], shieldEvents, sizeof(shieldEvents) / sizeof(Event));
+
     // ---- STATE_ATTACKING state configuration ----
     // Define valid transitions from STATE_ATTACKING
     State attackValidTransitions[] = {STATE_IDLE, STATE_DEAD};
@@ -221,6 +480,10 @@ void InitPlayerFSM(GameObject *obj)
     // Configure valid transitions for STATE_ATTACKING
     StateTransitions(&obj->stateConfigs[STATE_ATTACKING], attackValidTransitions, sizeof(attackValidTransitions) / sizeof(State));
 
+    // Events STATE_ATTACKING reacts to, the others are dropped
+    Event attackEvents[] = {EVENT_NONE, EVENT_DIE};
+    StateEvents(&obj->stateConfigs[STATE_ATTACKING], attackEvents, sizeof(attackEvents) / sizeof(Event));
+
     // ---- STATE_SHIELD state configuration ----
     // Define valid transitions from STATE_SHIELD
     State sheildingValidTransitions[] = {STATE_IDLE, STATE_DEAD};
@@ -230,7 +493,7 @@ void InitPlayerFSM(GameObject *obj)
 
     // ---- STATE_DEAD state configuration ----
     // Define valid transitions from STATE_DEAD
-    State deadValidTransitions[] = {STATE_RESPAWN};
+    State deadValidTransitions[] = {STATE_RESPAWN, STATE_IDLE}; // STATE_IDLE on game over
 
     // Set up the state configuration for STATE_DEAD
     obj->stateConfigs[STATE_DEAD].name = "Player_Dead";
@@ -242,6 +505,10 @@ void InitPlayerFSM(GameObject *obj)
     // Configure valid transitions for STATE_DEAD
     StateTransitions(&obj->stateConfigs[STATE_DEAD], deadValidTransitions, sizeof(deadValidTransitions) / sizeof(State));
 
+    // Events STATE_DEAD reacts to, the others are dropped
+    Event deadEvents[] = {EVENT_TIMEOUT};
+    StateEvents(&obj->stateConfigs[STATE_DEAD], deadEvents, sizeof(deadEvents) / sizeof(Event));
+
     // ---- STATE_RESPAWN state configuration ----
     // Define valid transitions from STATE_RESPAWN
     State respawnValidTransitions[] = {STATE_IDLE};
@@ -256,12 +523,79 @@ void InitPlayerFSM(GameObject *obj)
     // Configure valid transitions for STATE_RESPAWN
     StateTransitions(&obj->stateConfigs[STATE_RESPAWN], respawnValidTransitions, sizeof(respawnValidTransitions) / sizeof(State));
 
+    // Events STATE_RESPAWN reacts to, the others are dropped
+    Event respawnEvents[] = {EVENT_TIMEOUT};
+    StateEvents(&obj->stateConfigs[STATE_RESPAWN], respawnEvents, sizeof(respawnEvents) / sizeof(Event));
+
 // For unimplemented states, set them to empty defaults
 #define EMPTY_STATE_CONFIG \
-    (StateConfig){NULL, NULL, NULL, NULL, NULL, NULL, 0}
+    (StateConfig){NULL, NULL, NULL, NULL, NULL, NULL, NULL, 0, 0, 0}
     obj->stateConfigs[STATE_COLLISION] = EMPTY_STATE_CONFIG;
 }
 
+/**
+ * RegisterPlayerFSMHandlers - Registers the Player's state handlers by name.
+ *
+ * Called once at startup so the compiled graph (assets/fsm/player.fsm) can bind
+ * its handler ids to these functions.
+ */
+void RegisterPlayerFSMHandlers()
+{
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EVENT, PlayerIdleHandleEvent);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_ENTRY, PlayerEnterIdle);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_UPDATE, PlayerUpdateIdle);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EXIT, PlayerExitIdle);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_RESUME, PlayerResumeIdle);
+
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EVENT, PlayerWalkingHandleEvent);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_ENTRY, PlayerEnterWalking);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_UPDATE, PlayerUpdateWalking);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EXIT, PlayerExitWalking);
+
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EVENT, PlayerAttackingHandleEvent);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_ENTRY, PlayerEnterAttacking);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_UPDATE, PlayerUpdateAttacking);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EXIT, PlayerExitAttacking);
+
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EVENT, PlayerShieldHandleEvent);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_ENTRY, PlayerEnterShield);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_UPDATE, PlayerUpdateShield);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EXIT, PlayerExitShield);
+
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EVENT, PlayerDieHandleEvent);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_ENTRY, PlayerEnterDie);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_UPDATE, PlayerUpdateDie);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EXIT, PlayerExitDie);
+
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EVENT, PlayerRespawnHandleEvent);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_ENTRY, PlayerEnterRespawn);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_UPDATE, PlayerUpdateRespawn);
+    REGISTER_FSM_HANDLER(FSM_HANDLER_EXIT, PlayerExitRespawn);
+}
+
+/**
+ * RegisterPlayerAnimationClips - Registers the Player's animation clips with the texture atlas.
+ *
+ * Called once at startup, before BuildTextureAtlas, so only the frames the Player
+ * actually plays are packed.
+ */
+void RegisterPlayerAnimationClips()
+{
+    Rectangle *clips[] = {idle1, idle2, idle3, idle4, idle5, idle6, idle7,
+                          walkUp, walkLeft, walkDown, walkRight,
+                          attackDown, attackUp, attackLeft, attackRight,
+                          deadFrames, respawnFrames, shieldFrames};
+    int frameCounts[] = {8, 8, 8, 8, 8, 8, 8,
+                         9, 9, 9, 9,
+                         6, 6, 6, 6,
+                         6, 8, 8};
+
+    for (size_t i = 0; i < sizeof(clips) / sizeof(clips[0]); i++)
+    {
+        AddAtlasClip(PLAYER_SPRITE_SHEET, clips[i], frameCounts[i]);
+    }
+}
+
 // Handles events for the Player when in the Idle state
 void PlayerIdleHandleEvent(GameObject *obj, Event event)
 {
@@ -276,8 +610,11 @@ void PlayerIdleHandleEvent(GameObject *obj, Event event)
             ChangeState(obj, STATE_WALKING);
             break;
         case EVENT_ATTACK:
-            // Transition to Attacking state if an attack event is received
-            ChangeState(obj, STATE_ATTACKING);
+            // Transition to Attacking state if an attack event is received and the attack has cooled down
+            if (!IsTimerPending(((Player *)obj)->attackCooldown))
+            {
+                ChangeState(obj, STATE_ATTACKING);
+            }
             break;
         case EVENT_DEFEND:
             // Transition to Shielding state if a defend event is received
@@ -294,6 +631,7 @@ void PlayerIdleHandleEvent(GameObject *obj, Event event)
         case EVENT_RESPAWN:
         case EVENT_COLLISION_START:
         case EVENT_COLLISION_END:
+        case EVENT_TIMEOUT:
         case EVENT_COUNT:
             break;
         case EVENT_MOVE_UP:
@@ -340,8 +678,11 @@ void PlayerWalkingHandleEvent(GameObject *obj, Event event)
             ChangeState(obj, STATE_IDLE);
             break;
         case EVENT_ATTACK:
-            // Transition to Attacking state if an attack event is received
-            ChangeState(obj, STATE_ATTACKING);
+            // Transition to Attacking state if an attack event is received and the attack has cooled down
+            if (!IsTimerPending(player->attackCooldown))
+            {
+                ChangeState(obj, STATE_ATTACKING);
+            }
             break;
         case EVENT_DIE:
             // Transition to Dead state if a die event is received
@@ -353,6 +694,7 @@ void PlayerWalkingHandleEvent(GameObject *obj, Event event)
         case EVENT_RESPAWN:
         case EVENT_COLLISION_START:
         case EVENT_COLLISION_END:
+        case EVENT_TIMEOUT:
         case EVENT_COUNT:
             break;
         case EVENT_MOVE_UP:
@@ -408,6 +750,7 @@ void PlayerAttackingHandleEvent(GameObject *obj, Event event)
         case EVENT_RESPAWN:
         case EVENT_COLLISION_START:
         case EVENT_COLLISION_END:
+        case EVENT_TIMEOUT:
         case EVENT_COUNT:
             break;
         case EVENT_MOVE_UP:
@@ -440,18 +783,35 @@ void PlayerDieHandleEvent(GameObject *obj, Event event)
     Player *player = (Player *)obj;
     printf("\n%s Die HandleEvent\n", obj->name);
     printf("Stamina: %.1f, Mana: %.1f\n\n", player->stamina, player->mana);
-    // Complete the remainder of the method
-    (void)event; // ignoring event
+
+    // The death animation has finished (timeout scheduled in PlayerEnterDie)
+    if (event == EVENT_TIMEOUT)
+    {
+        player->lives--;
+
+        if (player->lives > 0) {
+            ChangeState(obj, STATE_RESPAWN);
+        } else {
+            // Game Over logic here
+            player->base.position = player->spawnPoint;
+            player->lives = 4;  // Reset lives for new game
+            ChangeState(obj, STATE_IDLE);
+        }
+    }
 }
 
 // Handles events for the Player when in the Respawn state
 void PlayerRespawnHandleEvent(GameObject *obj, Event event)
 {
     Player *player = (Player *)obj;
-    printf("\n%s Die HandleEvent\n", obj->name);
+    printf("\n%s Respawn HandleEvent\n", obj->name);
     printf("Stamina: %.1f, Mana: %.1f\n\n", player->stamina, player->mana);
-    // Complete the remainder of the method
-    (void)event; // ignoring event
+
+    // The respawn animation has finished (timeout scheduled in PlayerEnterRespawn)
+    if (event == EVENT_TIMEOUT)
+    {
+        ChangeState(obj, STATE_IDLE);
+    }
 }
 
 // Common movement function to handle state and animation transitions
@@ -470,104 +830,7 @@ void SelectRandomIdleAnimation(GameObject *obj)
 {
 
     // See grid_player_sprite_sheet.png for rows and columns
-    int randomChoice = rand() % 7 + 1;
-
-    Rectangle idle1[8] = {
-            {0, 320, 64, 64},   // Frame 1: Row 6, Column 1
-            {64, 320, 64, 64},  // Frame 2: Row 6, Column 2
-            {128, 320, 64, 64}, // Frame 3: Row 6, Column 3
-            {192, 320, 64, 64}, // Frame 4: Row 6, Column 4
-            {256, 320, 64, 64}, // Frame 5: Row 6, Column 5
-            {320, 320, 64, 64}, // Frame 6: Row 6, Column 6
-            {384, 320, 64, 64}, // Frame 7: Row 6, Column 7
-            {448, 320, 64, 64}  // Frame 8: Row 6, Column 8
-    };
-
-    Rectangle idle2[8] = {
-            {0, 384, 64, 64},   // Frame 1: Row 7, Column 1
-            {64, 384, 64, 64},  // Frame 2: Row 7, Column 2
-            {128, 384, 64, 64}, // Frame 3: Row 7, Column 3
-            {192, 384, 64, 64}, // Frame 4: Row 7, Column 4
-            {256, 384, 64, 64}, // Frame 5: Row 7, Column 5
-            {320, 384, 64, 64}, // Frame 6: Row 7, Column 6
-            {384, 384, 64, 64}, // Frame 7: Row 7, Column 7
-            {448, 384, 64, 64}  // Frame 8: Row 7, Column 8
-    };
-
-    Rectangle idle3[8] = {
-            {0, 448, 64, 64},   // Frame 1: Row 8, Column 1
-            {64, 448, 64, 64},  // Frame 2: Row 8, Column 2
-            {128, 448, 64, 64}, // Frame 3: Row 8, Column 3
-            {192, 448, 64, 64}, // Frame 4: Row 8, Column 4
-            {256, 448, 64, 64}, // Frame 5: Row 8, Column 5
-            {320, 448, 64, 64}, // Frame 6: Row 8, Column 6
-            {384, 448, 64, 64}, // Frame 7: Row 8, Column 7
-            {448, 448, 64, 64}  // Frame 8: Row 8, Column 8
-    };
-
-    Rectangle idle4[13] = {
-            {0, 1024, 64, 64},   // Frame 1: Row 17, Column 1
-            {64, 1024, 64, 64},  // Frame 2: Row 17, Column 2
-            {128, 1024, 64, 64}, // Frame 3: Row 17, Column 3
-            {192, 1024, 64, 64}, // Frame 4: Row 17, Column 4
-            {256, 1024, 64, 64}, // Frame 5: Row 17, Column 5
-            {320, 1024, 64, 64}, // Frame 6: Row 17, Column 6
-            {384, 1024, 64, 64}, // Frame 7: Row 17, Column 7
-            {448, 1024, 64, 64}, // Frame 8: Row 17, Column 8
-            {512, 1024, 64, 64}, // Frame 9: Row 17, Column 9
-            {576, 1024, 64, 64}, // Frame 10: Row 17, Column 10
-            {640, 1024, 64, 64}, // Frame 11: Row 17, Column 11
-            {704, 1024, 64, 64}, // Frame 12: Row 17, Column 12
-            {768, 1024, 64, 64}  // Frame 13: Row 17, Column 13
-    };
-
-    Rectangle idle5[13] = {
-            {0, 1088, 64, 64},   // Frame 1: Row 18, Column 1
-            {64, 1088, 64, 64},  // Frame 2: Row 18, Column 2
-            {128, 1088, 64, 64}, // Frame 3: Row 18, Column 3
-            {192, 1088, 64, 64}, // Frame 4: Row 18, Column 4
-            {256, 1088, 64, 64}, // Frame 5: Row 18, Column 5
-            {320, 1088, 64, 64}, // Frame 6: Row 18, Column 6
-            {384, 1088, 64, 64}, // Frame 7: Row 18, Column 7
-            {448, 1088, 64, 64}, // Frame 8: Row 18, Column 8
-            {512, 1088, 64, 64}, // Frame 9: Row 18, Column 9
-            {576, 1088, 64, 64}, // Frame 10: Row 18, Column 10
-            {640, 1088, 64, 64}, // Frame 11: Row 18, Column 11
-            {704, 1088, 64, 64}, // Frame 12: Row 18, Column 12
-            {768, 1088, 64, 64}  // Frame 13: Row 18, Column 13
-    };
-
-    Rectangle idle6[13] = {
-            {0, 1152, 64, 64},   // Frame 1: Row 19, Column 1
-            {64, 1152, 64, 64},  // Frame 2: Row 19, Column 2
-            {128, 1152, 64, 64}, // Frame 3: Row 19, Column 3
-            {192, 1152, 64, 64}, // Frame 4: Row 19, Column 4
-            {256, 1152, 64, 64}, // Frame 5: Row 19, Column 5
-            {320, 1152, 64, 64}, // Frame 6: Row 19, Column 6
-            {384, 1152, 64, 64}, // Frame 7: Row 19, Column 7
-            {448, 1152, 64, 64}, // Frame 8: Row 19, Column 8
-            {512, 1152, 64, 64}, // Frame 9: Row 19, Column 9
-            {576, 1152, 64, 64}, // Frame 10: Row 19, Column 10
-            {640, 1152, 64, 64}, // Frame 11: Row 19, Column 11
-            {704, 1152, 64, 64}, // Frame 12: Row 19, Column 12
-            {768, 1152, 64, 64}  // Frame 13: Row 19, Column 13
-    };
-
-    Rectangle idle7[13] = {
-            {0, 1216, 64, 64},   // Frame 1: Row 20, Column 1
-            {64, 1216, 64, 64},  // Frame 2: Row 20, Column 2
-            {128, 1216, 64, 64}, // Frame 3: Row 20, Column 3
-            {192, 1216, 64, 64}, // Frame 4: Row 20, Column 4
-            {256, 1216, 64, 64}, // Frame 5: Row 20, Column 5
-            {320, 1216, 64, 64}, // Frame 6: Row 20, Column 6
-            {384, 1216, 64, 64}, // Frame 7: Row 20, Column 7
-            {448, 1216, 64, 64}, // Frame 8: Row 20, Column 8
-            {512, 1216, 64, 64}, // Frame 9: Row 20, Column 9
-            {576, 1216, 64, 64}, // Frame 10: Row 20, Column 10
-            {640, 1216, 64, 64}, // Frame 11: Row 20, Column 11
-            {704, 1216, 64, 64}, // Frame 12: Row 20, Column 12
-            {768, 1216, 64, 64}  // Frame 13: Row 20, Column 13
-    };
+    int randomChoice = NextRandomInt(&obj->animationRandom, 7) + 1;
 
     switch (randomChoice)
     {
@@ -604,25 +867,47 @@ void PlayerEnterIdle(GameObject *obj)
     printf("\n%s -> ENTER -> Idle\n", obj->name);
     printf("Stamina: %.1f, Mana: %.1f\n\n", player->stamina, player->mana);
 
+    // Regeneration starts from now
+    player->regenTick = GetTimerTick();
+
     if (player->base.previousState != player->base.currentState && player->base.currentState == STATE_IDLE)
     {
         SelectRandomIdleAnimation(&player->base);
     }
 }
 
-void PlayerUpdateIdle(GameObject *obj) {
-    Player *player = (Player *)obj;
-
-    // Regenerate stamina and mana while idle
+// Regenerates stamina and mana for the timer ticks since the last regeneration while idle,
+// so the rate follows simulated time whatever the frame rate or time asleep
+static void PlayerRegenerate(Player *player)
+{
     const float REGEN_RATE = 0.5f;
     const float MAX_STAMINA = 100.0f;
     const float MAX_MANA = 100.0f;
 
+    unsigned int now = GetTimerTick();
+    float ticks = (float)(now - player->regenTick);
+    player->regenTick = now;
+
     // Increase stamina and mana
-    player->stamina = fminf(player->stamina + REGEN_RATE, MAX_STAMINA);
-    player->mana = fminf(player->mana + REGEN_RATE, MAX_MANA);
+    player->stamina = fminf(player->stamina + REGEN_RATE * ticks, MAX_STAMINA);
+    player->mana = fminf(player->mana + REGEN_RATE * ticks, MAX_MANA);
+}
 
-    UpdateAnimation(&obj->animation);
+void PlayerUpdateIdle(GameObject *obj) {
+    Player *player = (Player *)obj;
+
+    // Regenerate stamina and mana while idle
+    PlayerRegenerate(player);
+
+    // Only regeneration changes while idle (the animation system keeps the animation
+    // playing), it is caught up on wake (PlayerResumeIdle), so sleep until the next input event
+    SleepGameObject(obj, 0.0f, 0.0f);
+}
+
+void PlayerResumeIdle(GameObject *obj, float elapsed)
+{
+    (void)elapsed; // The regeneration counts the ticks itself
+    PlayerRegenerate((Player *)obj);
 }
 
 void PlayerExitIdle(GameObject *obj)
@@ -638,58 +923,28 @@ void PlayerEnterWalking(GameObject *obj) {
     printf("\n%s -> ENTER -> Walking\n", obj->name);
     printf("Stamina: %.1f, Mana: %.1f\n\n", player->stamina, player->mana);
 
-    Rectangle walkFrames[9];
+    Rectangle *walkFrames;
 
     // Select animation frames based on movement direction
     switch (player->base.currentState) {
         case STATE_MOVING_UP_LEFT:
-            for (int i = 0; i < 9; i++) {
-                walkFrames[i] = (Rectangle){i * 64, 512, 64, 64};  // Row 8
-            }
-            break;
         case STATE_MOVING_UP_RIGHT:
-            for (int i = 0; i < 9; i++) {
-                walkFrames[i] = (Rectangle){i * 64, 512, 64, 64};  // Row 8
-            }
+        case STATE_MOVING_UP:
+            walkFrames = walkUp;
             break;
         case STATE_MOVING_DOWN_LEFT:
-            for (int i = 0; i < 9; i++) {
-                walkFrames[i] = (Rectangle){i * 64, 640, 64, 64};  // Row 10
-            }
-            break;
         case STATE_MOVING_DOWN_RIGHT:
-            for (int i = 0; i < 9; i++) {
-                walkFrames[i] = (Rectangle){i * 64, 640, 64, 64};  // Row 10
-            }
-            break;
-        case STATE_MOVING_UP:
-            for (int i = 0; i < 9; i++) {
-                walkFrames[i] = (Rectangle){i * 64, 512, 64, 64};  // Row 8
-            }
-            break;
-
         case STATE_MOVING_DOWN:
-            for (int i = 0; i < 9; i++) {
-                walkFrames[i] = (Rectangle){i * 64, 640, 64, 64};  // Row 10
-            }
+            walkFrames = walkDown;
             break;
-
         case STATE_MOVING_LEFT:
-            for (int i = 0; i < 9; i++) {
-                walkFrames[i] = (Rectangle){i * 64, 576, 64, 64};  // Row 9
-            }
+            walkFrames = walkLeft;
             break;
-
         case STATE_MOVING_RIGHT:
-            for (int i = 0; i < 9; i++) {
-                walkFrames[i] = (Rectangle){i * 64, 704, 64, 64};  // Row 11
-            }
+            walkFrames = walkRight;
             break;
-
         default:  // Default to walking up animation
-            for (int i = 0; i < 9; i++) {
-                walkFrames[i] = (Rectangle){i * 64, 512, 64, 64};
-            }
+            walkFrames = walkUp;
             break;
     }
 
@@ -711,7 +966,7 @@ void PlayerUpdateWalking(GameObject *obj) {
     // If stamina depleted, force return to idle
     if (player->stamina <= 0) {
         player->stamina = 0;
-        ChangeState(obj, STATE_IDLE);
+        DeferChangeState(obj, STATE_IDLE);
         return;
     }
 
@@ -758,40 +1013,37 @@ void PlayerUpdateWalking(GameObject *obj) {
     // Move player in the determined direction
     PlayerMove(player, moveDirection);
 
-    // Screen boundary checks
+    // World boundary checks
     const float PLAYER_RADIUS = 32.0f;  // Half of player sprite size
 
     // Check horizontal boundaries
     if (obj->position.x < PLAYER_RADIUS) {
         obj->position.x = PLAYER_RADIUS;
     }
-    if (obj->position.x > GetScreenWidth() - PLAYER_RADIUS) {
-        obj->position.x = GetScreenWidth() - PLAYER_RADIUS;
+    if (obj->position.x > WORLD_WIDTH - PLAYER_RADIUS) {
+        obj->position.x = WORLD_WIDTH - PLAYER_RADIUS;
     }
 
     // Check vertical boundaries
     if (obj->position.y < PLAYER_RADIUS) {
         obj->position.y = PLAYER_RADIUS;
     }
-    if (obj->position.y > GetScreenHeight() - PLAYER_RADIUS) {
-        obj->position.y = GetScreenHeight() - PLAYER_RADIUS;
+    if (obj->position.y > WORLD_HEIGHT - PLAYER_RADIUS) {
+        obj->position.y = WORLD_HEIGHT - PLAYER_RADIUS;
     }
 
     // Update collider position
     obj->collider.p.x = obj->position.x;
     obj->collider.p.y = obj->position.y;
 
-    // Update animation frames
-    UpdateAnimation(&obj->animation);
-
     // Check for death conditions
     if (player->base.health <= 0) {
-        ChangeState(obj, STATE_DEAD);
+        DeferChangeState(obj, STATE_DEAD);
     }
 
     // Return to idle if animation completes
-    if (obj->animation.currentFrame >= obj->animation.frameCount - 1) {
-        ChangeState(obj, STATE_IDLE);
+    if (GetAnimationFrame(&obj->animation) >= obj->animation.frameCount - 1) {
+        DeferChangeState(obj, STATE_IDLE);
     }
 }
 
@@ -812,43 +1064,6 @@ void PlayerEnterAttacking(GameObject *obj) {
     // Example: Deduct some stamina when attacking
 
     // Define attack animations for each direction
-    Rectangle attackDown[6] = {
-            {0,   3328, 192, 192},
-            {192, 3328, 192, 192},
-            {384, 3328, 192, 192},
-            {576, 3328, 192, 192},
-            {768, 3328, 192, 192},
-            {960, 3328, 192, 192}
-    };
-
-    Rectangle attackUp[6] = {
-            {0,   2994, 192, 192},
-            {192, 2994, 192, 192},
-            {384, 2994, 192, 192},
-            {576, 2994, 192, 192},
-            {768, 2994, 192, 192},
-            {960, 2994, 192, 192}
-    };
-
-// Shield Left Animation
-    Rectangle attackLeft[6] = {
-            {0,   3136, 192, 192},
-            {192, 3136, 192, 192},
-            {384, 3136, 192, 192},
-            {576, 3136, 192, 192},
-            {768, 3136, 192, 192},
-            {960, 3136, 192, 192}
-    };
-
-// Shield Right Animation
-    Rectangle attackRight[6] = {
-            {0,   3520, 192, 192},
-            {192, 3520, 192, 192},
-            {384, 3520, 192, 192},
-            {576, 3520, 192, 192},
-            {768, 3520, 192, 192},
-            {960, 3520, 192, 192}
-    };
     // Determine attack direction based on last movement
     switch (player->base.lastDirection) {
         case STATE_MOVING_UP:
@@ -882,11 +1097,9 @@ void PlayerUpdateAttacking(GameObject *obj)
     // If mana depleted, force return to idle
     if (player->mana <= 0) {
         player->mana = 0;
-        ChangeState(obj, STATE_IDLE);
+        DeferChangeState(obj, STATE_IDLE);
         return;
     }
-
-    UpdateAnimation(&obj->animation);
 }
 
 void PlayerExitAttacking(GameObject *obj)
@@ -894,8 +1107,8 @@ void PlayerExitAttacking(GameObject *obj)
     Player *player = (Player *)obj;
     printf("\n%s <- EXIT <- Attacking\n", obj->name);
     printf("Stamina: %.1f, Mana: %.1f\n\n", player->stamina, player->mana);
-    // Complete the remainder of the method
-    // Reset or adjust any temporary changes during attack, if needed
+    // Start the attack cooldown, a bare timer checked with IsTimerPending
+    player->attackCooldown = ScheduleTimerSeconds(NULL, EVENT_NONE, COMMAND_FIRE_COOLDOWN, NULL);
 }
 
 
@@ -904,31 +1117,15 @@ void PlayerEnterDie(GameObject *obj)
 {
     printf("\n%s -> ENTER -> Die\n", obj->name);
     Player *player = (Player *)obj;
-    Rectangle deadFrames[6] = {
-            {0, 1280, 64, 64}, {64, 1280, 64, 64},
-            {128, 1280, 64, 64}, {192, 1280, 64, 64},
-            {256, 1280, 64, 64}, {320, 1280, 64, 64}
-    };
     InitGameObjectAnimation(&player->base, deadFrames, 6, 0.2f);
+
+    // Lose a life once the death animation has played through
+    SetStateTimeout(obj, GetAnimationDuration(&obj->animation));
 }
 
 void PlayerUpdateDie(GameObject *obj)
 {
-    Player *player = (Player *)obj;
     printf("\n%s -> UPDATE -> Die\n", obj->name);
-    UpdateAnimation(&obj->animation);
-    if (obj->animation.currentFrame >= obj->animation.frameCount - 1) {
-        player->lives--;
-
-        if (player->lives > 0) {
-            ChangeState(obj, STATE_RESPAWN);
-        } else {
-            // Game Over logic here
-            player->base.position = player->spawnPoint;
-            player->lives = 4;  // Reset lives for new game
-            ChangeState(obj, STATE_IDLE);
-        }
-    }
 }
 
 void PlayerExitDie(GameObject *obj)
@@ -941,29 +1138,20 @@ void PlayerEnterRespawn(GameObject *obj)
 {
     Player *player = (Player *)obj;
     // Reset position and stats
-    player->base.position = (Vector2){GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f};
+    player->base.position = (Vector2){WORLD_WIDTH / 2.0f, WORLD_HEIGHT / 2.0f};
     player->base.health = 100;
     player->stamina = 100;
     player->mana = 100;
 
-    Rectangle respawnFrames[8] = {
-            {0, 384, 64, 64}, {64, 384, 64, 64},
-            {128, 384, 64, 64}, {192, 384, 64, 64},
-            {256, 384, 64, 64}, {320, 384, 64, 64},
-            {384, 384, 64, 64}, {448, 384, 64, 64}
-    };
     InitGameObjectAnimation(&player->base, respawnFrames, 8, 0.1f);
 
+    // Back to idle once the respawn animation has played through
+    SetStateTimeout(obj, GetAnimationDuration(&obj->animation));
 }
 
 void PlayerUpdateRespawn(GameObject *obj)
 {
     printf("\n%s -> UPDATE -> Respawn\n", obj->name);
-    UpdateAnimation(&obj->animation);
-    if (obj->animation.currentFrame >= obj->animation.frameCount - 1) {
-        ChangeState(obj, STATE_IDLE);
-    }
-
 }
 
 void PlayerExitRespawn(GameObject *obj)
@@ -980,11 +1168,10 @@ void PlayerEnterShield(GameObject *obj)
     player->shieldColor = (Color){0, 255, 128, 128};
     player->shieldRadius = 90.0f; // Slightly larger than player
     player->shieldActive = true;
-    Rectangle shieldFrames[8] = {
-            {0, 384, 64, 64}, {64, 384, 64, 64}, {128, 384, 64, 64}, {192, 384, 64, 64},
-            {256, 384, 64, 64}, {320, 384, 64, 64}, {384, 384, 64, 64}, {448, 384, 64, 64}
-    };
     InitGameObjectAnimation(&player->base, shieldFrames, 8, 0.1f);
+
+    // The shield only lasts for SHIELD_DURATION
+    SetStateTimeout(obj, SHIELD_DURATION);
 }
 
 void PlayerShieldHandleEvent(GameObject *obj, Event event)
@@ -1020,6 +1207,10 @@ void PlayerShieldHandleEvent(GameObject *obj, Event event)
         case EVENT_DIE:
             ChangeState(obj, STATE_DEAD);
             break;
+        case EVENT_TIMEOUT:
+            // Shield has worn off
+            ChangeState(obj, STATE_IDLE);
+            break;
         default:
             break;
     }
@@ -1030,20 +1221,15 @@ void PlayerUpdateShield(GameObject *obj)
     Player *player = (Player *)obj;
     printf("\n%s -> UPDATE -> Shield\n", obj->name);
     printf("Stamina: %.1f, Mana: %.1f\n\n", player->stamina, player->mana);
-    UpdateAnimation(&obj->animation);
 
     // Consume stamina while shielding
     player->stamina -= 0.05f;
     if (player->stamina <= 0)
     {
-        ChangeState(obj, STATE_IDLE);
+        DeferChangeState(obj, STATE_IDLE);
     }
-    DrawCircle(
-            (int)player->base.position.x,
-            (int)player->base.position.y,
-            player->shieldRadius,
-            player->shieldColor
-    );
+
+    // The shield itself is drawn by BuildRenderSnapshot while shieldActive is set
 }
 
 void PlayerExitShield(GameObject *obj)
@@ -0,0 +1,80 @@
+#include "../include/utils/random.h"
+
+// Seed every stream is derived from
+static uint64_t worldSeed = 0;
+
+// SplitMix64 finaliser, spreads every input bit over the output
+static uint64_t MixBits(uint64_t z)
+{
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * SetWorldSeed - Sets the seed every random stream is derived from.
+ *
+ * @seed: The world seed, a run started with the same seed (and the same input)
+ *        draws the same numbers everywhere.
+ */
+void SetWorldSeed(uint64_t seed)
+{
+    worldSeed = seed;
+}
+
+// Get the world seed (log it to replay a run)
+uint64_t GetWorldSeed()
+{
+    return worldSeed;
+}
+
+/**
+ * InitRandomStream - Initialises an entity's random stream for a system.
+ *
+ * @stream:   The stream to initialise.
+ * @system:   The system drawing from the stream.
+ * @entityId: The entity the numbers are for (its creation order id).
+ *
+ * The stream's numbers depend only on the world seed, the system and the entity,
+ * not on what any other stream drew or on which thread it is drawn from.
+ */
+void InitRandomStream(RandomStream *stream, RandomSystem system, int entityId)
+{
+    stream->key = MixBits(worldSeed ^ MixBits(((uint64_t)system << 32) | (uint32_t)entityId));
+    stream->counter = 0;
+}
+
+/**
+ * NextRandom - Draws a random 32-bit number.
+ *
+ * @stream: The stream to draw from.
+ *
+ * Counter based: the number is a hash of the stream's key and how many numbers it
+ * has drawn, so streams share no state and need no locks, and drawing costs a few
+ * multiplies.
+ *
+ * Return: The next number of the stream.
+ */
+uint32_t NextRandom(RandomStream *stream)
+{
+    uint64_t z = stream->key + ++stream->counter * 0x9E3779B97F4A7C15ull;
+    return (uint32_t)(MixBits(z) >> 32);
+}
+
+// Draw a random integer in [0, bound)
+int NextRandomInt(RandomStream *stream, int bound)
+{
+    if (bound <= 0)
+    {
+        return 0;
+    }
+
+    // Scales instead of taking the remainder, no division
+    return (int)(((uint64_t)NextRandom(stream) * (uint32_t)bound) >> 32);
+}
+
+// Draw a random float in [0, 1)
+float NextRandomFloat(RandomStream *stream)
+{
+    return (NextRandom(stream) >> 8) * (1.0f / 16777216.0f);
+}
@@ -0,0 +1,89 @@
+#include <math.h>
+
+#include <raylib.h>
+
+#include "../include/render/render_snapshot.h"
+#include "../include/render/sprite_instancing.h"
+#include "../include/utils/constants.h"
+
+// Draws the sorted sprites with the instanced sprites sorted in among the actors,
+// as if they were in the batch (a split only where instances come between sprites)
+static void DrawSpritesAndInstances(const SpriteList *sprites, Rectangle view)
+{
+    BeginSpriteInstances(view, SPRITE_CULL_MARGIN);
+
+    int first = 0;
+    for (int i = 0; i < sprites->count; i++)
+    {
+        const Sprite *sprite = &sprites->sprites[i];
+        if (sprite->layer < SPRITE_LAYER_ACTORS)
+            continue;
+
+        // Every instance is an actor, the layers above go over all of them
+        float depth = sprite->layer == SPRITE_LAYER_ACTORS ? sprite->depth : INFINITY;
+        if (!HasSpriteInstancesBefore(depth))
+            continue;
+
+        DrawSpriteListRange(sprites, first, i - first);
+        DrawSpriteInstancesBefore(depth);
+        first = i;
+    }
+
+    DrawSpriteListRange(sprites, first, sprites->count - first);
+    DrawSpriteInstancesBefore(INFINITY);
+}
+
+/**
+ * DrawRenderSnapshot - Draws a frame from a render snapshot.
+ *
+ * @snapshot: The snapshot to draw, built by BuildRenderSnapshot.
+ *
+ * Only the snapshot is read (and the instanced sprites as of the last
+ * SyncSpriteInstances), never the game objects, so the simulation can build the
+ * next snapshot on another thread while this one is drawn. The world is drawn
+ * through the snapshot's camera, and the retained HUD is composited in screen
+ * space on top.
+ */
+void DrawRenderSnapshot(const RenderSnapshot *snapshot)
+{
+    // Begin drawing to the screen
+    BeginDrawing();
+
+    // Clear whatever the tilemap does not cover
+    ClearBackground(BLACK);
+
+    // Chunks coming into view are rendered into their cache textures before the world is drawn
+    StreamTilemapChunks(snapshot->tilemap, snapshot->view);
+
+    BeginMode2D(snapshot->camera);
+
+    // The static level layers, one draw per cached chunk, under everything else
+    DrawTilemap(snapshot->tilemap, snapshot->view);
+
+    // Sprites were sorted when the snapshot was taken, instanced NPCs are drawn between them by depth
+    DrawSpritesAndInstances(&snapshot->sprites, snapshot->view);
+
+    // Overlays go over the sprites
+    DrawOverlayList(&snapshot->overlays);
+
+    EndMode2D();
+
+    // The HUD texture is only redrawn if one of the values changed
+    for (int i = 0; i < HUD_VALUE_COUNT; i++)
+    {
+        SetHudValue((HudValue)i, snapshot->hudValues[i]);
+    }
+    DrawHud();
+
+    // End drawing to the screen
+    EndDrawing();
+}
+
+/**
+ * ReleaseRenderSnapshot - Releases a snapshot's sprite and overlay storage.
+ */
+void ReleaseRenderSnapshot(RenderSnapshot *snapshot)
+{
+    ReleaseSpriteList(&snapshot->sprites);
+    ReleaseOverlayList(&snapshot->overlays);
+}
@@ -0,0 +1,339 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../include/utils/scheduler.h"
+#include "../include/utils/constants.h"
+#include "../include/utils/spatial_grid.h"
+
+// Cell size of the sleeper proximity grid (about the size of a wake radius)
+#define SLEEPER_GRID_CELL_SIZE 256.0f
+#define SLEEPER_GRID_BUCKETS 1024
+
+// Most sleepers woken by proximity in a single tick, the rest wake on the next tick
+#define MAX_PROXIMITY_WAKES 64
+
+static GameObject **awake = NULL; // The update set, only awake objects are in it
+static int awakeCount = 0;
+static int awakeCapacity = 0;
+static int sleepingCount = 0;
+
+static SpatialGrid *sleepers = NULL; // Sleepers with a proximity trigger
+static GameObject *focus = NULL;     // Object whose position triggers proximity wakes
+static float maxWakeRadius = 0.0f;   // Largest wake radius registered
+
+static bool updating = false;       // True while UpdateScheduledObjects is iterating
+static bool compactPending = false; // Slots were vacated during iteration
+
+// Adds a game object to the end of the update set
+static void AddAwake(GameObject *obj)
+{
+    if (awakeCount == awakeCapacity)
+    {
+        int newCapacity = awakeCapacity ? awakeCapacity * 2 : 16;
+        GameObject **grown = (GameObject **)realloc(awake, sizeof(GameObject *) * newCapacity);
+        if (!grown)
+        {
+            fprintf(stderr, "Failed to allocate update set\n");
+            exit(1);
+        }
+        awake = grown;
+        awakeCapacity = newCapacity;
+    }
+
+    obj->updateSlot = awakeCount;
+    awake[awakeCount++] = obj;
+}
+
+/**
+ * RemoveAwake - Removes a game object from the update set.
+ *
+ * Outside of an update the last object is swapped into the vacated slot. While the
+ * update set is being iterated the slot is only cleared, and the set is compacted
+ * once the iteration has finished so no object is skipped or updated twice.
+ */
+static void RemoveAwake(GameObject *obj)
+{
+    int slot = obj->updateSlot;
+    if (slot == -1)
+    {
+        return;
+    }
+    obj->updateSlot = -1;
+
+    if (updating)
+    {
+        awake[slot] = NULL;
+        compactPending = true;
+        return;
+    }
+
+    awakeCount--;
+    if (slot != awakeCount)
+    {
+        awake[slot] = awake[awakeCount];
+        awake[slot]->updateSlot = slot;
+    }
+}
+
+// Removes the cleared slots left behind by sleeps during an update (keeps the order)
+static void CompactAwake()
+{
+    int kept = 0;
+    for (int i = 0; i < awakeCount; i++)
+    {
+        if (awake[i] != NULL)
+        {
+            awake[kept] = awake[i];
+            awake[kept]->updateSlot = kept;
+            kept++;
+        }
+    }
+    awakeCount = kept;
+    compactPending = false;
+}
+
+// Drops the wake triggers of a sleeping object and marks it awake
+static void ReleaseSleep(GameObject *obj)
+{
+    if (obj->sleepEntry != -1)
+    {
+        SpatialGridRemove(sleepers, obj->sleepEntry);
+        obj->sleepEntry = -1;
+    }
+    CancelTimer(&obj->wakeTimer);
+
+    obj->asleep = false;
+    sleepingCount--;
+}
+
+// Timer callback waking an object whose sleep duration is over
+static void WakeOnTimer(GameObject *obj, Event event)
+{
+    (void)event; // Timer carries no event
+    obj->wakeTimer = TIMER_HANDLE_NONE;
+    WakeGameObject(obj);
+}
+
+/**
+ * InitScheduler - Initialises the update scheduler.
+ *
+ * The scheduler owns the update set: only awake objects are in it, so the per tick
+ * cost of UpdateScheduledObjects scales with the number of active objects.
+ */
+void InitScheduler()
+{
+    awakeCount = 0;
+    sleepingCount = 0;
+    focus = NULL;
+    maxWakeRadius = 0.0f;
+    updating = false;
+    compactPending = false;
+
+    if (!sleepers)
+    {
+        sleepers = CreateSpatialGrid(SLEEPER_GRID_CELL_SIZE, SLEEPER_GRID_BUCKETS);
+    }
+}
+
+/**
+ * ScheduleGameObject - Adds a game object to the update set.
+ *
+ * @obj: The GameObject to update every tick while it is awake.
+ */
+void ScheduleGameObject(GameObject *obj)
+{
+    if (obj->updateSlot != -1 || obj->asleep)
+    {
+        return; // Already scheduled
+    }
+    AddAwake(obj);
+}
+
+/**
+ * UnscheduleGameObject - Removes a game object from the scheduler.
+ *
+ * @obj: The GameObject to remove, whether it is awake or asleep.
+ *
+ * Called when a GameObject is deleted. A sleeping object is dropped without
+ * catching up the work it skipped.
+ */
+void UnscheduleGameObject(GameObject *obj)
+{
+    if (obj->asleep)
+    {
+        ReleaseSleep(obj);
+    }
+    RemoveAwake(obj);
+}
+
+/**
+ * SetSchedulerFocus - Sets the object whose position triggers proximity wakes.
+ *
+ * @focus: Normally the player, NULL disables proximity wakes.
+ */
+void SetSchedulerFocus(GameObject *newFocus)
+{
+    focus = newFocus;
+}
+
+/**
+ * IsNearSchedulerFocus - Checks if a game object is within radius of the focus.
+ *
+ * Return: true if the object is within radius, or if no focus is set.
+ */
+bool IsNearSchedulerFocus(const GameObject *obj, float radius)
+{
+    if (!focus)
+    {
+        return true;
+    }
+    return Vector2Distance(obj->position, focus->position) <= radius;
+}
+
+/**
+ * SleepGameObject - Puts a game object to sleep, removing it from the update set.
+ *
+ * @obj:              The GameObject falling asleep (must be scheduled and awake).
+ * @wakeAfterSeconds: Wake the object after this many seconds (0 for no timer).
+ * @wakeRadius:       Wake the object when the focus comes this close (0 for no proximity wake).
+ *
+ * Any event other than EVENT_NONE also wakes the object (see HandleEvent). While asleep
+ * the object's Update is not called (its animation keeps playing in the animation
+ * system), the state work it skips is caught up from the elapsed time when it wakes.
+ */
+void SleepGameObject(GameObject *obj, float wakeAfterSeconds, float wakeRadius)
+{
+    if (obj->asleep || obj->updateSlot == -1)
+    {
+        return; // Already asleep or not scheduled
+    }
+
+    RemoveAwake(obj);
+
+    obj->asleep = true;
+    obj->sleepTick = GetTimerTick();
+    obj->wakeRadius = wakeRadius;
+    sleepingCount++;
+
+    if (wakeRadius > 0.0f)
+    {
+        obj->sleepEntry = SpatialGridInsert(sleepers, obj, obj->position);
+        if (wakeRadius > maxWakeRadius)
+        {
+            maxWakeRadius = wakeRadius;
+        }
+    }
+
+    if (wakeAfterSeconds > 0.0f)
+    {
+        obj->wakeTimer = ScheduleTimerSeconds(obj, EVENT_NONE, wakeAfterSeconds, WakeOnTimer);
+    }
+}
+
+/**
+ * WakeGameObject - Wakes a sleeping game object and catches up the work it skipped.
+ *
+ * @obj: The GameObject to wake (ignored if it is awake).
+ *
+ * The animation system kept the animation playing, the state's Resume function (if
+ * any) reconstructs the rest, e.g., stamina and mana regeneration while idle.
+ */
+void WakeGameObject(GameObject *obj)
+{
+    if (!obj->asleep)
+    {
+        return;
+    }
+
+    float elapsed = GetSleepDuration(obj);
+
+    ReleaseSleep(obj);
+    AddAwake(obj);
+
+    // Catch up on the work skipped while asleep
+    ResumeState(obj, elapsed);
+}
+
+/**
+ * GetSleepDuration - Returns how long a game object has been asleep.
+ *
+ * The duration is simulated time, counted in timer ticks, so it does not depend
+ * on how the simulation thread was scheduled (and replays exactly).
+ *
+ * Return: Seconds since the object fell asleep, or 0 if it is awake.
+ */
+float GetSleepDuration(const GameObject *obj)
+{
+    return obj->asleep ? (float)(GetTimerTick() - obj->sleepTick) / TIMER_TICKS_PER_SECOND : 0.0f;
+}
+
+/**
+ * UpdateScheduledObjects - Runs one tick of the update set.
+ *
+ * Sleepers close to the focus are woken first (only the grid cells around the focus
+ * are visited), then UpdateState is called for every awake object. Objects can fall
+ * asleep or be woken during the iteration, objects woken mid-tick update next tick.
+ */
+void UpdateScheduledObjects()
+{
+    // Proximity wake-ups
+    if (focus && sleepers->count > 0)
+    {
+        GameObject *nearby[MAX_PROXIMITY_WAKES];
+        int found = SpatialGridQuery(sleepers, focus->position, maxWakeRadius, nearby, MAX_PROXIMITY_WAKES);
+
+        for (int i = 0; i < found; i++)
+        {
+            if (Vector2Distance(nearby[i]->position, focus->position) <= nearby[i]->wakeRadius)
+            {
+                WakeGameObject(nearby[i]);
+            }
+        }
+    }
+
+    // Update the awake objects
+    updating = true;
+    int count = awakeCount;
+    for (int i = 0; i < count; i++)
+    {
+        GameObject *obj = awake[i];
+        if (obj)
+        {
+            UpdateState(obj);
+        }
+    }
+    updating = false;
+
+    if (compactPending)
+    {
+        CompactAwake();
+    }
+}
+
+// Number of objects updated each tick
+int GetAwakeObjectCount()
+{
+    return awakeCount;
+}
+
+// Number of objects currently asleep
+int GetSleepingObjectCount()
+{
+    return sleepingCount;
+}
+
+/**
+ * ExitScheduler - Releases the scheduler storage.
+ */
+void ExitScheduler()
+{
+    free(awake);
+    awake = NULL;
+    awakeCount = 0;
+    awakeCapacity = 0;
+    sleepingCount = 0;
+    focus = NULL;
+
+    DeleteSpatialGrid(sleepers);
+    sleepers = NULL;
+}
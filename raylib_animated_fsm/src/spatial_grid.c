@@ -0,0 +1,235 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../include/utils/spatial_grid.h"
+
+// Initial number of entries in the pool, the pool doubles when exhausted
+#define SPATIAL_GRID_INITIAL_CAPACITY 64
+
+// Hash a cell coordinate into a bucket index
+static int HashCell(const SpatialGrid *grid, int cellX, int cellY)
+{
+    unsigned int hash = ((unsigned int)cellX * 73856093u) ^ ((unsigned int)cellY * 19349663u);
+    return (int)(hash & (unsigned int)(grid->bucketCount - 1));
+}
+
+// Cell coordinate containing a world coordinate
+static int CellOf(const SpatialGrid *grid, float value)
+{
+    return (int)floorf(value / grid->cellSize);
+}
+
+// Grows the entry pool and threads the new entries onto the free list
+static void GrowSpatialGrid(SpatialGrid *grid)
+{
+    int newCapacity = grid->capacity ? grid->capacity * 2 : SPATIAL_GRID_INITIAL_CAPACITY;
+    SpatialEntry *grown = (SpatialEntry *)realloc(grid->entries, sizeof(SpatialEntry) * newCapacity);
+    if (!grown)
+    {
+        fprintf(stderr, "Failed to allocate spatial grid entries\n");
+        exit(1);
+    }
+
+    for (int i = grid->capacity; i < newCapacity; i++)
+    {
+        grown[i].obj = NULL;
+        grown[i].next = (i + 1 < newCapacity) ? i + 1 : grid->freeEntry;
+    }
+
+    grid->freeEntry = grid->capacity;
+    grid->entries = grown;
+    grid->capacity = newCapacity;
+}
+
+/**
+ * CreateSpatialGrid - Creates an empty spatial grid.
+ *
+ * @cellSize:    Width and height of a grid cell, ideally close to the typical query radius.
+ * @bucketCount: Number of hash buckets, rounded up to a power of two.
+ *
+ * Return: A pointer to the new SpatialGrid. Exits if memory allocation fails.
+ */
+SpatialGrid *CreateSpatialGrid(float cellSize, int bucketCount)
+{
+    SpatialGrid *grid = (SpatialGrid *)malloc(sizeof(SpatialGrid));
+    if (!grid)
+    {
+        fprintf(stderr, "Failed to allocate spatial grid\n");
+        exit(1);
+    }
+
+    int buckets = 1;
+    while (buckets < bucketCount)
+    {
+        buckets <<= 1;
+    }
+
+    grid->cellSize = cellSize;
+    grid->bucketCount = buckets;
+    grid->buckets = (int *)malloc(sizeof(int) * buckets);
+    if (!grid->buckets)
+    {
+        fprintf(stderr, "Failed to allocate spatial grid buckets\n");
+        exit(1);
+    }
+    grid->entries = NULL;
+    grid->capacity = 0;
+    grid->freeEntry = -1;
+
+    SpatialGridClear(grid);
+    return grid;
+}
+
+/**
+ * SpatialGridInsert - Inserts an object into the cell containing a position.
+ *
+ * @grid:     The grid to insert into.
+ * @obj:      The GameObject being stored.
+ * @position: The position used to pick the cell (the grid does not track movement).
+ *
+ * Return: The entry index, needed to remove the object again.
+ */
+int SpatialGridInsert(SpatialGrid *grid, GameObject *obj, Vector2 position)
+{
+    if (grid->freeEntry == -1)
+    {
+        GrowSpatialGrid(grid);
+    }
+
+    int index = grid->freeEntry;
+    SpatialEntry *entry = &grid->entries[index];
+    grid->freeEntry = entry->next;
+
+    entry->obj = obj;
+    entry->position = position;
+    entry->cellX = CellOf(grid, position.x);
+    entry->cellY = CellOf(grid, position.y);
+    entry->bucket = HashCell(grid, entry->cellX, entry->cellY);
+
+    // Push onto the front of the bucket list
+    entry->prev = -1;
+    entry->next = grid->buckets[entry->bucket];
+    if (entry->next != -1)
+    {
+        grid->entries[entry->next].prev = index;
+    }
+    grid->buckets[entry->bucket] = index;
+    grid->count++;
+
+    return index;
+}
+
+/**
+ * SpatialGridRemove - Removes an entry from the grid in O(1).
+ *
+ * @grid:  The grid holding the entry.
+ * @entry: The entry index returned by SpatialGridInsert.
+ */
+void SpatialGridRemove(SpatialGrid *grid, int entry)
+{
+    if (entry < 0 || entry >= grid->capacity || grid->entries[entry].obj == NULL)
+    {
+        return;
+    }
+
+    SpatialEntry *removed = &grid->entries[entry];
+
+    if (removed->prev != -1)
+        grid->entries[removed->prev].next = removed->next;
+    else
+        grid->buckets[removed->bucket] = removed->next;
+
+    if (removed->next != -1)
+        grid->entries[removed->next].prev = removed->prev;
+
+    removed->obj = NULL;
+    removed->next = grid->freeEntry;
+    grid->freeEntry = entry;
+    grid->count--;
+}
+
+/**
+ * SpatialGridClear - Removes every entry from the grid, keeping its storage.
+ */
+void SpatialGridClear(SpatialGrid *grid)
+{
+    for (int i = 0; i < grid->bucketCount; i++)
+    {
+        grid->buckets[i] = -1;
+    }
+
+    // Rebuild the free list over the whole pool
+    grid->freeEntry = grid->capacity ? 0 : -1;
+    for (int i = 0; i < grid->capacity; i++)
+    {
+        grid->entries[i].obj = NULL;
+        grid->entries[i].next = (i + 1 < grid->capacity) ? i + 1 : -1;
+    }
+    grid->count = 0;
+}
+
+/**
+ * SpatialGridQuery - Finds the objects within a radius of a point.
+ *
+ * @grid:       The grid to search.
+ * @center:     Centre of the query circle.
+ * @radius:     Radius of the query circle.
+ * @results:    Output array receiving the objects found.
+ * @maxResults: Capacity of the results array.
+ *
+ * Only the cells overlapping the query circle are visited, so the cost depends on
+ * how many objects are nearby rather than on how many are in the grid. Entries are
+ * matched on their own cell so a hash collision never reports an object twice.
+ *
+ * Return: The number of objects written to results.
+ */
+int SpatialGridQuery(const SpatialGrid *grid, Vector2 center, float radius, GameObject **results, int maxResults)
+{
+    int found = 0;
+    float radiusSqr = radius * radius;
+
+    int minX = CellOf(grid, center.x - radius);
+    int maxX = CellOf(grid, center.x + radius);
+    int minY = CellOf(grid, center.y - radius);
+    int maxY = CellOf(grid, center.y + radius);
+
+    for (int cellY = minY; cellY <= maxY; cellY++)
+    {
+        for (int cellX = minX; cellX <= maxX; cellX++)
+        {
+            int index = grid->buckets[HashCell(grid, cellX, cellY)];
+            while (index != -1)
+            {
+                const SpatialEntry *entry = &grid->entries[index];
+                if (entry->cellX == cellX && entry->cellY == cellY)
+                {
+                    float dx = entry->position.x - center.x;
+                    float dy = entry->position.y - center.y;
+                    if (dx * dx + dy * dy <= radiusSqr)
+                    {
+                        if (found == maxResults)
+                            return found;
+                        results[found++] = entry->obj;
+                    }
+                }
+                index = entry->next;
+            }
+        }
+    }
+
+    return found;
+}
+
+/**
+ * DeleteSpatialGrid - Frees the grid and its storage.
+ */
+void DeleteSpatialGrid(SpatialGrid *grid)
+{
+    if (grid)
+    {
+        free(grid->buckets);
+        free(grid->entries);
+        free(grid);
+    }
+}
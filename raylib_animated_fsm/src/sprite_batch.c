@@ -0,0 +1,367 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include <rlgl.h>
+
+#include "../include/render/sprite_batch.h"
+
+// Sprites recorded this frame
+static Sprite *sprites = NULL;
+static int spriteCount = 0;
+static int spriteCapacity = 0;
+
+// Sort key of a recorded sprite, and where the sprite is
+typedef struct
+{
+    uint64_t key;
+    int index;
+} SpriteKey;
+
+// Scratch space for sorting, sized with the sprites
+static SpriteKey *keys = NULL;
+static SpriteKey *keysScratch = NULL;
+static Sprite *sortedSprites = NULL;
+
+static bool recording = false;
+static int drawCalls = 0;
+
+/**
+ * InitSpriteBatch - Initialises the sprite batch.
+ *
+ * Sprites submitted between BeginSpriteBatch and EndSpriteBatch are drawn together,
+ * sorted by layer and depth, so overlapping objects are drawn back to front and
+ * every run of sprites sharing a texture costs one draw call and one texture bind.
+ */
+void InitSpriteBatch()
+{
+    spriteCount = 0;
+    recording = false;
+    drawCalls = 0;
+}
+
+/**
+ * BeginSpriteBatch - Starts recording sprites for a frame.
+ */
+void BeginSpriteBatch()
+{
+    spriteCount = 0;
+    recording = true;
+}
+
+/**
+ * SubmitSprite - Records a sprite for the current frame.
+ *
+ * @texture:  The texture the sprite is taken from.
+ * @source:   The source rectangle on the texture.
+ * @position: The top left corner of the sprite on screen.
+ * @tint:     The tint applied to the sprite.
+ * @layer:    The layer the sprite is drawn in.
+ * @depth:    Draw order within the layer, the world y the sprite stands on for
+ *            top down overlap (lower is further back and drawn first).
+ *
+ * Outside of BeginSpriteBatch/EndSpriteBatch the sprite is drawn immediately.
+ */
+void SubmitSprite(Texture2D texture, Rectangle source, Vector2 position, Color tint, SpriteLayer layer, float depth)
+{
+    if (!recording)
+    {
+        DrawTextureRec(texture, source, position, tint);
+        return;
+    }
+
+    if (spriteCount == spriteCapacity)
+    {
+        int newCapacity = spriteCapacity ? spriteCapacity * 2 : 256;
+        Sprite *grown = (Sprite *)realloc(sprites, sizeof(Sprite) * newCapacity);
+        Sprite *grownSorted = (Sprite *)realloc(sortedSprites, sizeof(Sprite) * newCapacity);
+        SpriteKey *grownKeys = (SpriteKey *)realloc(keys, sizeof(SpriteKey) * newCapacity);
+        SpriteKey *grownScratch = (SpriteKey *)realloc(keysScratch, sizeof(SpriteKey) * newCapacity);
+        if (!grown || !grownSorted || !grownKeys || !grownScratch)
+        {
+            fprintf(stderr, "Failed to allocate sprite batch\n");
+            exit(1);
+        }
+        sprites = grown;
+        sortedSprites = grownSorted;
+        keys = grownKeys;
+        keysScratch = grownScratch;
+        spriteCapacity = newCapacity;
+    }
+
+    sprites[spriteCount] = (Sprite){texture, source, position, tint, layer, depth};
+    spriteCount++;
+}
+
+// Check if sprites are being recorded
+bool IsSpriteBatchActive()
+{
+    return recording;
+}
+
+// Maps a float to an unsigned integer with the same ordering
+static uint32_t OrderedFloatBits(float value)
+{
+    // -0 and +0 compare equal, give them the same bits
+    if (value == 0.0f)
+        value = 0.0f;
+
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    // Negative floats order backwards, flip all their bits, positives only need the sign bit set
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+// Sort key of a sprite: layer, then depth, then texture (low 16 bits of the id)
+static uint64_t SpriteSortKey(const Sprite *sprite)
+{
+    return ((uint64_t)sprite->layer << 48) |
+           ((uint64_t)OrderedFloatBits(sprite->depth) << 16) |
+           (uint64_t)(sprite->texture.id & 0xFFFFu);
+}
+
+/**
+ * SortSprites - Sorts the recorded sprites by layer, depth and texture.
+ *
+ * A least significant digit radix sort over the 64-bit sort keys, a byte per
+ * pass. Bytes every key shares (the unused high bits, the layer in a single
+ * layer frame) are skipped, so a frame usually costs four or five linear passes
+ * over the keys instead of O(n log n) comparisons. The sort is stable, sprites at
+ * the same depth keep their submission order.
+ */
+static void SortSprites()
+{
+    for (int i = 0; i < spriteCount; i++)
+    {
+        keys[i] = (SpriteKey){SpriteSortKey(&sprites[i]), i};
+    }
+
+    SpriteKey *from = keys;
+    SpriteKey *to = keysScratch;
+
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        int counts[256] = {0};
+        for (int i = 0; i < spriteCount; i++)
+        {
+            counts[(from[i].key >> shift) & 0xFF]++;
+        }
+
+        // Every key has the same byte here, the order does not change
+        if (counts[(from[0].key >> shift) & 0xFF] == spriteCount)
+            continue;
+
+        int offset = 0;
+        for (int digit = 0; digit < 256; digit++)
+        {
+            int count = counts[digit];
+            counts[digit] = offset;
+            offset += count;
+        }
+
+        for (int i = 0; i < spriteCount; i++)
+        {
+            to[counts[(from[i].key >> shift) & 0xFF]++] = from[i];
+        }
+
+        SpriteKey *swap = from;
+        from = to;
+        to = swap;
+    }
+
+    // Gather the sprites in sorted order, the sorted buffer becomes the sprite buffer
+    for (int i = 0; i < spriteCount; i++)
+    {
+        sortedSprites[i] = sprites[from[i].index];
+    }
+
+    Sprite *swap = sprites;
+    sprites = sortedSprites;
+    sortedSprites = swap;
+}
+
+// Emits one textured quad, the same vertices DrawTextureRec produces
+static void EmitSpriteQuad(const Sprite *sprite)
+{
+    const float width = (float)sprite->texture.width;
+    const float height = (float)sprite->texture.height;
+
+    Rectangle source = sprite->source;
+    bool flipX = source.width < 0;
+    bool flipY = source.height < 0;
+    source.width = fabsf(source.width);
+    source.height = fabsf(source.height);
+
+    float left = source.x / width;
+    float right = (source.x + source.width) / width;
+    float top = source.y / height;
+    float bottom = (source.y + source.height) / height;
+
+    if (flipX)
+    {
+        float swap = left;
+        left = right;
+        right = swap;
+    }
+    if (flipY)
+    {
+        float swap = top;
+        top = bottom;
+        bottom = swap;
+    }
+
+    const float x = sprite->position.x;
+    const float y = sprite->position.y;
+
+    rlColor4ub(sprite->tint.r, sprite->tint.g, sprite->tint.b, sprite->tint.a);
+
+    rlTexCoord2f(left, top);
+    rlVertex2f(x, y);
+
+    rlTexCoord2f(left, bottom);
+    rlVertex2f(x, y + source.height);
+
+    rlTexCoord2f(right, bottom);
+    rlVertex2f(x + source.width, y + source.height);
+
+    rlTexCoord2f(right, top);
+    rlVertex2f(x + source.width, y);
+}
+
+// Emits sorted sprites, each run sharing a layer and texture as one block of quads
+static void DrawSortedSprites(const Sprite *sorted, int count)
+{
+    drawCalls = 0;
+
+    int first = 0;
+    while (first < count)
+    {
+        // Find the run of sprites sharing the layer and texture
+        int last = first + 1;
+        while (last < count &&
+               sorted[last].layer == sorted[first].layer &&
+               sorted[last].texture.id == sorted[first].texture.id)
+        {
+            last++;
+        }
+
+        // Flush once up front if the run does not fit, rlgl flushes on its own between quads otherwise
+        rlCheckRenderBatchLimit(4 * (last - first));
+
+        rlSetTexture(sorted[first].texture.id);
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (int i = first; i < last; i++)
+        {
+            EmitSpriteQuad(&sorted[i]);
+        }
+        rlEnd();
+
+        drawCalls++;
+        first = last;
+    }
+
+    rlSetTexture(0);
+}
+
+/**
+ * EndSpriteBatch - Draws the sprites recorded since BeginSpriteBatch.
+ *
+ * The sprites are sorted by layer and depth (texture breaks ties, submission order
+ * after that), then each run of sprites sharing a texture is emitted as one block
+ * of quads. rlgl only starts a new draw call when the texture changes, so sprites
+ * packed into one atlas cost a single draw call however they interleave in depth.
+ */
+void EndSpriteBatch()
+{
+    recording = false;
+
+    if (spriteCount > 0)
+    {
+        SortSprites();
+    }
+
+    DrawSortedSprites(sprites, spriteCount);
+    spriteCount = 0;
+}
+
+/**
+ * TakeSpriteBatch - Moves the sprites recorded since BeginSpriteBatch into a list.
+ *
+ * @list: The list to fill, its previous sprites are replaced (grown as needed).
+ *
+ * The sprites are sorted as EndSpriteBatch would but not drawn. Nothing in the
+ * list refers to the batch, so it can be drawn with DrawSpriteList on another
+ * thread while the next frame is recorded.
+ */
+void TakeSpriteBatch(SpriteList *list)
+{
+    recording = false;
+
+    if (spriteCount > list->capacity)
+    {
+        Sprite *grown = (Sprite *)realloc(list->sprites, sizeof(Sprite) * spriteCapacity);
+        if (!grown)
+        {
+            fprintf(stderr, "Failed to allocate sprite list\n");
+            exit(1);
+        }
+        list->sprites = grown;
+        list->capacity = spriteCapacity;
+    }
+
+    if (spriteCount > 0)
+    {
+        SortSprites();
+        memcpy(list->sprites, sprites, sizeof(Sprite) * spriteCount);
+    }
+
+    list->count = spriteCount;
+    spriteCount = 0;
+}
+
+// Draw a list taken from the batch (one draw call per run of a texture)
+void DrawSpriteList(const SpriteList *list)
+{
+    DrawSortedSprites(list->sprites, list->count);
+}
+
+// Draw part of a list taken from the batch, e.g., to draw something else between its sprites
+void DrawSpriteListRange(const SpriteList *list, int first, int count)
+{
+    DrawSortedSprites(count > 0 ? &list->sprites[first] : NULL, count);
+}
+
+// Release a list's storage
+void ReleaseSpriteList(SpriteList *list)
+{
+    free(list->sprites);
+    *list = (SpriteList){0};
+}
+
+// Number of draw calls the last EndSpriteBatch, DrawSpriteList or DrawSpriteListRange issued
+int GetSpriteBatchDrawCalls()
+{
+    return drawCalls;
+}
+
+/**
+ * ExitSpriteBatch - Releases the sprite batch storage.
+ */
+void ExitSpriteBatch()
+{
+    free(sprites);
+    free(sortedSprites);
+    free(keys);
+    free(keysScratch);
+    sprites = NULL;
+    sortedSprites = NULL;
+    keys = NULL;
+    keysScratch = NULL;
+    spriteCount = 0;
+    spriteCapacity = 0;
+    recording = false;
+}
@@ -0,0 +1,661 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <limits.h>
+
+#include <raylib.h>
+#include <raymath.h>
+#include <rlgl.h>
+
+#include "../include/render/sprite_instancing.h"
+
+#define SPRITE_INSTANCING_STRING(x) #x
+#define SPRITE_INSTANCING_EXPAND(x) SPRITE_INSTANCING_STRING(x)
+
+// Picks each instance's frame from the clip table, so the CPU never touches a
+// playing animation
+static const char *spriteInstanceVertexShader =
+    "#version 330\n"
+    "in vec2 vertexCorner;\n"      // Corner of the quad (0 or 1 on each axis)
+    "in vec3 instanceAnimation;\n" // Clip, start time, frames per second
+    "in vec2 instancePosition;\n"
+    "in vec4 instanceTint;\n"
+    "uniform mat4 mvp;\n"
+    "uniform float time;\n"
+    "uniform vec2 textureSize;\n"
+    "uniform vec4 clips[" SPRITE_INSTANCING_EXPAND(MAX_SPRITE_INSTANCE_CLIPS) "];\n"   // First frame, frame count
+    "uniform vec4 frames[" SPRITE_INSTANCING_EXPAND(MAX_SPRITE_INSTANCE_FRAMES) "];\n" // Source rectangle on the texture
+    "out vec2 fragTexCoord;\n"
+    "out vec4 fragColor;\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 clip = clips[int(instanceAnimation.x)];\n"
+    "    float elapsed = max(time - instanceAnimation.y, 0.0) * instanceAnimation.z;\n"
+    "    vec4 source = frames[int(clip.x + mod(floor(elapsed), clip.y))];\n"
+    "    vec2 size = abs(source.zw);\n"
+    "    vec2 flip = vec2(lessThan(source.zw, vec2(0.0)));\n"
+    "    vec2 corner = mix(vertexCorner, 1.0 - vertexCorner, flip);\n"
+    "    fragTexCoord = (source.xy + corner * size) / textureSize;\n"
+    "    fragColor = instanceTint;\n"
+    "    gl_Position = mvp * vec4(instancePosition - size * 0.5 + vertexCorner * size, 0.0, 1.0);\n"
+    "}\n";
+
+static const char *spriteInstanceFragmentShader =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    finalColor = texture(texture0, fragTexCoord) * fragColor;\n"
+    "}\n";
+
+// A clip in the clip table
+typedef struct
+{
+    const Rectangle *frames; // The clip's frames (read when the table is uploaded)
+    int frameCount;
+    int firstFrame; // Index of the clip's first frame in the frame table
+} SpriteInstanceClip;
+
+static bool enabled = false;
+static Texture2D instanceTexture = {0};
+static Shader shader = {0};
+static double epoch = 0.0;
+
+// Shader locations
+static int mvpLocation = -1;
+static int timeLocation = -1;
+static int textureSizeLocation = -1;
+static int clipsLocation = -1;
+static int framesLocation = -1;
+static int textureLocation = -1;
+
+// Clip table, uploaded as uniforms when it changes
+static SpriteInstanceClip clips[MAX_SPRITE_INSTANCE_CLIPS];
+static int clipCount = 0;
+static int frameTableCount = 0;
+static bool clipsDirty = false;
+
+// Instances, packed so they upload as one buffer and kept in depth order (y), handles map to their index
+static SpriteInstance *instances = NULL;
+static int *instanceHandles = NULL; // Handle of the instance at each index
+static int *handleIndices = NULL;   // Index of each handle (-1 if free)
+static int *freeHandles = NULL;
+static int instanceCount = 0;
+static int handleCount = 0;
+static int freeHandleCount = 0;
+static int instanceCapacity = 0;
+static int syncedCount = 0; // Instances in the instance buffer at the last sync
+
+// Depth of each instance in the instance buffer, so draws find depths without reading the instances
+static float *syncedDepths = NULL;
+
+// Instances in view for the frame being drawn, and the first one not drawn yet
+static int visibleEnd = 0;
+static int drawnEnd = 0;
+
+// Instances changed since the last upload
+static int dirtyFirst = INT_MAX;
+static int dirtyLast = -1;
+
+// GPU buffers
+static unsigned int vertexArray = 0;
+static unsigned int cornerBuffer = 0;
+static unsigned int instanceBuffer = 0;
+static int instanceBufferCapacity = 0;
+
+// Marks an instance to be uploaded
+static void MarkInstanceDirty(int index)
+{
+    if (index < dirtyFirst)
+        dirtyFirst = index;
+    if (index > dirtyLast)
+        dirtyLast = index;
+}
+
+// Points the instance attributes at the instance buffer from an instance on (vertex array and buffer bound)
+static void BindInstanceAttributes(int first)
+{
+    const int stride = sizeof(SpriteInstance);
+    const int offset = first * stride;
+    const int animation = GetShaderLocationAttrib(shader, "instanceAnimation");
+    const int position = GetShaderLocationAttrib(shader, "instancePosition");
+    const int tint = GetShaderLocationAttrib(shader, "instanceTint");
+
+    rlSetVertexAttribute(animation, 3, RL_FLOAT, false, stride, offset + offsetof(SpriteInstance, clip));
+    rlEnableVertexAttribute(animation);
+    rlSetVertexAttributeDivisor(animation, 1);
+
+    rlSetVertexAttribute(position, 2, RL_FLOAT, false, stride, offset + offsetof(SpriteInstance, position));
+    rlEnableVertexAttribute(position);
+    rlSetVertexAttributeDivisor(position, 1);
+
+    rlSetVertexAttribute(tint, 4, RL_UNSIGNED_BYTE, true, stride, offset + offsetof(SpriteInstance, tint));
+    rlEnableVertexAttribute(tint);
+    rlSetVertexAttributeDivisor(tint, 1);
+}
+
+/**
+ * InitSpriteInstancing - Initialises instanced drawing of animated sprites.
+ *
+ * @texture: The texture every instance is drawn from (e.g., an atlas page).
+ *
+ * Each instance only stores its clip, the time the clip started, its speed,
+ * position and tint. The vertex shader computes the current frame from the clip
+ * table and the time, so the CPU only writes an instance when it changes clip
+ * (a state change) or moves, and a crowd of idle animating sprites costs nothing
+ * per frame beyond the draw call.
+ *
+ * Needs OpenGL 3.3 (instancing), web builds return false and keep drawing sprites
+ * through the sprite batch.
+ *
+ * Return: true if instanced sprites will be drawn.
+ */
+bool InitSpriteInstancing(Texture2D texture)
+{
+    enabled = false;
+    instanceTexture = texture;
+    epoch = GetTime();
+    clipCount = 0;
+    frameTableCount = 0;
+    instanceCount = 0;
+    handleCount = 0;
+    freeHandleCount = 0;
+    syncedCount = 0;
+    visibleEnd = 0;
+    drawnEnd = 0;
+
+#if defined(WEB_BUILD)
+    return false;
+#else
+    shader = LoadShaderFromMemory(spriteInstanceVertexShader, spriteInstanceFragmentShader);
+    if (!IsShaderValid(shader) || shader.id == rlGetShaderIdDefault())
+    {
+        fprintf(stderr, "Sprite instancing shader failed to load, drawing sprites through the sprite batch\n");
+        return false;
+    }
+
+    mvpLocation = GetShaderLocation(shader, "mvp");
+    timeLocation = GetShaderLocation(shader, "time");
+    textureSizeLocation = GetShaderLocation(shader, "textureSize");
+    clipsLocation = GetShaderLocation(shader, "clips");
+    framesLocation = GetShaderLocation(shader, "frames");
+    textureLocation = GetShaderLocation(shader, "texture0");
+
+    vertexArray = rlLoadVertexArray();
+    if (!rlEnableVertexArray(vertexArray))
+    {
+        fprintf(stderr, "Vertex arrays not supported, drawing sprites through the sprite batch\n");
+        UnloadShader(shader);
+        return false;
+    }
+
+    // Two triangles, same winding as the sprite batch quads
+    static const float corners[] = {0, 0, 0, 1, 1, 1, 0, 0, 1, 1, 1, 0};
+    const int corner = GetShaderLocationAttrib(shader, "vertexCorner");
+    cornerBuffer = rlLoadVertexBuffer(corners, sizeof(corners), false);
+    rlSetVertexAttribute(corner, 2, RL_FLOAT, false, 0, 0);
+    rlEnableVertexAttribute(corner);
+
+    instanceBufferCapacity = 256;
+    instanceBuffer = rlLoadVertexBuffer(NULL, instanceBufferCapacity * sizeof(SpriteInstance), true);
+    BindInstanceAttributes(0);
+
+    syncedDepths = (float *)malloc(sizeof(float) * instanceBufferCapacity);
+    if (!syncedDepths)
+    {
+        fprintf(stderr, "Failed to allocate sprite instances\n");
+        exit(1);
+    }
+
+    rlDisableVertexArray();
+
+    enabled = true;
+    return true;
+#endif
+}
+
+// Check if instanced sprites are drawn (InitSpriteInstancing succeeded)
+bool IsSpriteInstancingEnabled()
+{
+    return enabled;
+}
+
+/**
+ * AddSpriteInstanceClip - Adds a clip to the GPU clip table.
+ *
+ * @frames:     The clip's frames on the texture (the table is kept, not copied, so
+ *              rects rewritten by the texture atlas are picked up).
+ * @frameCount: The number of frames.
+ *
+ * Return: The clip id, or -1 if the table is full.
+ */
+int AddSpriteInstanceClip(const Rectangle *frames, int frameCount)
+{
+    if (clipCount == MAX_SPRITE_INSTANCE_CLIPS || frameCount <= 0 ||
+        frameTableCount + frameCount > MAX_SPRITE_INSTANCE_FRAMES)
+    {
+        fprintf(stderr, "Sprite instance clip table full\n");
+        return -1;
+    }
+
+    clips[clipCount] = (SpriteInstanceClip){frames, frameCount, frameTableCount};
+    frameTableCount += frameCount;
+    clipsDirty = true;
+
+    return clipCount++;
+}
+
+// Find the clip id of a clip's frames (-1 if the clip is not in the table)
+int FindSpriteInstanceClip(const Rectangle *frames, int frameCount)
+{
+    for (int i = 0; i < clipCount; i++)
+    {
+        if (clips[i].frames == frames && clips[i].frameCount == frameCount)
+            return i;
+    }
+    return -1;
+}
+
+/**
+ * AddSpriteInstance - Adds an instance.
+ *
+ * @position: Centre of the sprite in world coordinates.
+ * @tint:     Tint applied to the sprite.
+ *
+ * The instance shows the first frame of clip 0 until SetSpriteInstanceClip.
+ *
+ * Return: The instance's handle, or SPRITE_INSTANCE_NONE if instancing is disabled.
+ */
+int AddSpriteInstance(Vector2 position, Color tint)
+{
+    if (!enabled)
+    {
+        return SPRITE_INSTANCE_NONE;
+    }
+
+    if (instanceCount == instanceCapacity || handleCount == instanceCapacity)
+    {
+        int newCapacity = instanceCapacity ? instanceCapacity * 2 : 256;
+        SpriteInstance *grown = (SpriteInstance *)realloc(instances, sizeof(SpriteInstance) * newCapacity);
+        int *grownHandles = (int *)realloc(instanceHandles, sizeof(int) * newCapacity);
+        int *grownIndices = (int *)realloc(handleIndices, sizeof(int) * newCapacity);
+        int *grownFree = (int *)realloc(freeHandles, sizeof(int) * newCapacity);
+        if (!grown || !grownHandles || !grownIndices || !grownFree)
+        {
+            fprintf(stderr, "Failed to allocate sprite instances\n");
+            exit(1);
+        }
+        instances = grown;
+        instanceHandles = grownHandles;
+        handleIndices = grownIndices;
+        freeHandles = grownFree;
+        instanceCapacity = newCapacity;
+    }
+
+    int handle = freeHandleCount > 0 ? freeHandles[--freeHandleCount] : handleCount++;
+    int index = instanceCount++;
+
+    instances[index] = (SpriteInstance){0.0f, 0.0f, 0.0f, position, tint};
+    instanceHandles[index] = handle;
+    handleIndices[handle] = index;
+    MarkInstanceDirty(index);
+
+    return handle;
+}
+
+// Gets the index of a live instance (-1 if the handle is not live)
+static int GetInstanceIndex(int instance)
+{
+    if (instance < 0 || instance >= handleCount)
+        return -1;
+    return handleIndices[instance];
+}
+
+/**
+ * SetSpriteInstanceClip - Plays a clip on an instance from now.
+ *
+ * @instance:      The instance's handle.
+ * @clip:          The clip id (from AddSpriteInstanceClip).
+ * @frameDuration: The duration of each frame, in seconds.
+ *
+ * Called when the instance's object changes state, the shader advances the clip
+ * from here on.
+ */
+void SetSpriteInstanceClip(int instance, int clip, float frameDuration)
+{
+    int index = GetInstanceIndex(instance);
+    if (index < 0 || clip < 0 || clip >= clipCount)
+    {
+        return;
+    }
+
+    instances[index].clip = (float)clip;
+    instances[index].startTime = (float)(GetTime() - epoch);
+    instances[index].speed = (frameDuration > 0.0f) ? 1.0f / frameDuration : 0.0f;
+    MarkInstanceDirty(index);
+}
+
+// Move an instance (only uploaded if the position changed)
+void SetSpriteInstancePosition(int instance, Vector2 position)
+{
+    int index = GetInstanceIndex(instance);
+    if (index < 0)
+    {
+        return;
+    }
+
+    if (instances[index].position.x == position.x && instances[index].position.y == position.y)
+    {
+        return;
+    }
+
+    instances[index].position = position;
+    MarkInstanceDirty(index);
+}
+
+/**
+ * RemoveSpriteInstance - Removes an instance.
+ *
+ * @instance: The instance's handle (ignored if SPRITE_INSTANCE_NONE).
+ *
+ * The last instance moves into the removed one's place, keeping the instances
+ * packed for upload.
+ */
+void RemoveSpriteInstance(int instance)
+{
+    int index = GetInstanceIndex(instance);
+    if (index < 0)
+    {
+        return;
+    }
+
+    int last = --instanceCount;
+    if (index != last)
+    {
+        instances[index] = instances[last];
+        instanceHandles[index] = instanceHandles[last];
+        handleIndices[instanceHandles[index]] = index;
+        MarkInstanceDirty(index);
+    }
+
+    handleIndices[instance] = -1;
+    freeHandles[freeHandleCount++] = instance;
+}
+
+// Uploads the clip table as uniforms (shader enabled)
+static void UploadClipTable()
+{
+    Vector4 clipTable[MAX_SPRITE_INSTANCE_CLIPS];
+    Vector4 frameTable[MAX_SPRITE_INSTANCE_FRAMES];
+
+    for (int i = 0; i < clipCount; i++)
+    {
+        clipTable[i] = (Vector4){(float)clips[i].firstFrame, (float)clips[i].frameCount, 0.0f, 0.0f};
+
+        for (int frame = 0; frame < clips[i].frameCount; frame++)
+        {
+            Rectangle source = clips[i].frames[frame];
+            frameTable[clips[i].firstFrame + frame] = (Vector4){source.x, source.y, source.width, source.height};
+        }
+    }
+
+    rlSetUniform(clipsLocation, clipTable, RL_SHADER_UNIFORM_VEC4, clipCount);
+    rlSetUniform(framesLocation, frameTable, RL_SHADER_UNIFORM_VEC4, frameTableCount);
+    clipsDirty = false;
+}
+
+// Uploads the instances changed since the last sync
+static void UploadInstances()
+{
+    if (instanceCount > instanceBufferCapacity)
+    {
+        // Recreate the buffer big enough for every instance, all of them are uploaded
+        while (instanceBufferCapacity < instanceCount)
+        {
+            instanceBufferCapacity *= 2;
+        }
+
+        rlEnableVertexArray(vertexArray);
+        rlUnloadVertexBuffer(instanceBuffer);
+        instanceBuffer = rlLoadVertexBuffer(NULL, instanceBufferCapacity * sizeof(SpriteInstance), true);
+        rlUpdateVertexBuffer(instanceBuffer, instances, instanceCount * sizeof(SpriteInstance), 0);
+        BindInstanceAttributes(0);
+        rlDisableVertexArray();
+
+        float *grown = (float *)realloc(syncedDepths, sizeof(float) * instanceBufferCapacity);
+        if (!grown)
+        {
+            fprintf(stderr, "Failed to allocate sprite instances\n");
+            exit(1);
+        }
+        syncedDepths = grown;
+        for (int i = 0; i < instanceCount; i++)
+        {
+            syncedDepths[i] = instances[i].position.y;
+        }
+
+        dirtyFirst = INT_MAX;
+        dirtyLast = -1;
+        return;
+    }
+
+    if (dirtyLast >= instanceCount)
+        dirtyLast = instanceCount - 1;
+
+    if (dirtyFirst <= dirtyLast)
+    {
+        rlUpdateVertexBuffer(instanceBuffer,
+                             &instances[dirtyFirst],
+                             (dirtyLast - dirtyFirst + 1) * sizeof(SpriteInstance),
+                             dirtyFirst * sizeof(SpriteInstance));
+
+        for (int i = dirtyFirst; i <= dirtyLast; i++)
+        {
+            syncedDepths[i] = instances[i].position.y;
+        }
+    }
+
+    dirtyFirst = INT_MAX;
+    dirtyLast = -1;
+}
+
+// Puts the instances back in depth order, only the moved ones are out of place so
+// an insertion sort is about one pass, every instance it moves is uploaded again
+static void SortInstances()
+{
+    for (int i = 1; i < instanceCount; i++)
+    {
+        if (instances[i - 1].position.y <= instances[i].position.y)
+            continue;
+
+        SpriteInstance moved = instances[i];
+        int handle = instanceHandles[i];
+        int j = i;
+        while (j > 0 && instances[j - 1].position.y > moved.position.y)
+        {
+            instances[j] = instances[j - 1];
+            instanceHandles[j] = instanceHandles[j - 1];
+            handleIndices[instanceHandles[j]] = j;
+            j--;
+        }
+        instances[j] = moved;
+        instanceHandles[j] = handle;
+        handleIndices[handle] = j;
+
+        MarkInstanceDirty(j);
+        MarkInstanceDirty(i);
+    }
+}
+
+/**
+ * SyncSpriteInstances - Uploads the instances changed since the last sync.
+ *
+ * Instances are added, moved and removed by the simulation, which can run on
+ * another thread while a frame is drawn. The GPU copy is only brought up to date
+ * here, from the render thread at a point where the simulation is not running,
+ * so DrawSpriteInstancesBefore draws the instances as of the snapshot being
+ * drawn. The instances are kept sorted by depth (y) first, like the sprite
+ * batch's actors, so a frame draws them in a few ranges between the sprites.
+ * Nothing is sorted or uploaded while no instance changed.
+ */
+void SyncSpriteInstances()
+{
+    if (!enabled)
+    {
+        return;
+    }
+
+    if (dirtyLast >= 0)
+    {
+        SortInstances();
+    }
+
+    UploadInstances();
+    syncedCount = instanceCount;
+}
+
+// Gets the first synced instance whose depth is not above a depth (syncedCount if there is none)
+static int FindSyncedDepth(float depth)
+{
+    int low = 0;
+    int high = syncedCount;
+    while (low < high)
+    {
+        int middle = (low + high) / 2;
+        if (syncedDepths[middle] < depth)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+/**
+ * BeginSpriteInstances - Starts drawing the instances for a frame.
+ *
+ * @view:   The part of the world the camera sees.
+ * @margin: How far outside the view an instance's centre may be and still be drawn.
+ *
+ * The instances are sorted by depth, which is their y, so the ones in view on
+ * that axis are one range: the instances above or below the view are culled
+ * without being looked at. Instances beside the view are left to the GPU.
+ */
+void BeginSpriteInstances(Rectangle view, float margin)
+{
+    if (!enabled)
+    {
+        return;
+    }
+
+    drawnEnd = FindSyncedDepth(view.y - margin);
+    visibleEnd = FindSyncedDepth(view.y + view.height + margin);
+}
+
+// Check if DrawSpriteInstancesBefore would draw anything at this depth
+bool HasSpriteInstancesBefore(float depth)
+{
+    if (!enabled || drawnEnd >= visibleEnd || clipCount == 0)
+    {
+        return false;
+    }
+    return syncedDepths[drawnEnd] < depth;
+}
+
+/**
+ * DrawSpriteInstancesBefore - Draws the instances in view above a depth.
+ *
+ * @depth: The depth (world y) of the next sprite the batch draws, INFINITY for the rest.
+ *
+ * Called inside BeginMode2D, so the instances use the camera's transform. The
+ * instances in view that are not drawn yet and stand above the depth are drawn
+ * in one instanced draw call, so calling this before each of the batch's actor
+ * sprites (see DrawRenderSnapshot) sorts the instances in with them, and a
+ * frame costs one draw per sprite that has instances behind it. Only the GPU
+ * copy is read, the simulation can change instances meanwhile.
+ */
+void DrawSpriteInstancesBefore(float depth)
+{
+    if (!HasSpriteInstancesBefore(depth))
+    {
+        return;
+    }
+
+    int first = drawnEnd;
+    int last = FindSyncedDepth(depth);
+    if (last > visibleEnd)
+        last = visibleEnd;
+    drawnEnd = last;
+
+    // Anything batched so far is drawn first
+    rlDrawRenderBatchActive();
+
+    rlEnableShader(shader.id);
+
+    // The clip table is only built before the first frame (clips are added at startup)
+    if (clipsDirty)
+    {
+        UploadClipTable();
+    }
+
+    Matrix mvp = MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+    float time = (float)(GetTime() - epoch);
+    Vector2 textureSize = {(float)instanceTexture.width, (float)instanceTexture.height};
+    int textureSlot = 0;
+
+    rlSetUniformMatrix(mvpLocation, mvp);
+    rlSetUniform(timeLocation, &time, RL_SHADER_UNIFORM_FLOAT, 1);
+    rlSetUniform(textureSizeLocation, &textureSize, RL_SHADER_UNIFORM_VEC2, 1);
+    rlSetUniform(textureLocation, &textureSlot, RL_SHADER_UNIFORM_INT, 1);
+
+    rlActiveTextureSlot(0);
+    rlEnableTexture(instanceTexture.id);
+
+    // The range starts where the instance attributes point, the quad's corners are shared
+    rlEnableVertexArray(vertexArray);
+    rlEnableVertexBuffer(instanceBuffer);
+    BindInstanceAttributes(first);
+    rlDrawVertexArrayInstanced(0, 6, last - first);
+    rlDisableVertexArray();
+
+    rlDisableTexture();
+    rlDisableShader();
+}
+
+/**
+ * ExitSpriteInstancing - Releases the shader, GPU buffers and instances.
+ */
+void ExitSpriteInstancing()
+{
+    if (enabled)
+    {
+        rlUnloadVertexBuffer(instanceBuffer);
+        rlUnloadVertexBuffer(cornerBuffer);
+        rlUnloadVertexArray(vertexArray);
+        UnloadShader(shader);
+    }
+
+    free(instances);
+    free(instanceHandles);
+    free(handleIndices);
+    free(freeHandles);
+    free(syncedDepths);
+    instances = NULL;
+    instanceHandles = NULL;
+    handleIndices = NULL;
+    freeHandles = NULL;
+    syncedDepths = NULL;
+    instanceCount = 0;
+    handleCount = 0;
+    freeHandleCount = 0;
+    instanceCapacity = 0;
+    syncedCount = 0;
+    visibleEnd = 0;
+    drawnEnd = 0;
+    instanceBufferCapacity = 0;
+    clipCount = 0;
+    frameTableCount = 0;
+    enabled = false;
+}
@@ -0,0 +1,255 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <raymath.h>
+
+#include "../include/utils/squad.h"
+#include "../include/utils/constants.h"
+#include "../include/utils/perception.h"
+
+// A pack of NPCs making one decision for all of them
+typedef struct
+{
+    GameObject *members[MAX_SQUAD_MEMBERS]; // Members, each knows its squad (GameObject.squad)
+    int memberCount;
+    float untilThink; // Seconds until the next decision
+    SquadPlan plan;   // The current decision
+} Squad;
+
+// Every squad created so far, by index
+static Squad *squads = NULL;
+static int squadCount = 0;
+static int squadCapacity = 0;
+
+/**
+ * InitSquads - Initialises the squads.
+ *
+ * NPCs that come in packs act together: each squad decides once for all of
+ * its members what they do (engage the player or fall back) and where each of
+ * them stands, and every member's own AI only refines its part of that plan
+ * (e.g., attacking once it is in reach). The decision work that each member
+ * would repeat is done once per squad.
+ */
+void InitSquads()
+{
+    squadCount = 0;
+}
+
+/**
+ * CreateSquad - Creates an empty squad.
+ *
+ * Return: The squad's index, its first decision is made at the next update.
+ */
+int CreateSquad()
+{
+    if (squadCount == squadCapacity)
+    {
+        int newCapacity = squadCapacity ? squadCapacity * 2 : 16;
+        Squad *grown = (Squad *)realloc(squads, sizeof(Squad) * newCapacity);
+        if (!grown)
+        {
+            fprintf(stderr, "Failed to allocate squads\n");
+            exit(1);
+        }
+        squads = grown;
+        squadCapacity = newCapacity;
+    }
+
+    squads[squadCount] = (Squad){.memberCount = 0, .untilThink = 0.0f, .plan = {.order = SQUAD_ORDER_NONE}};
+    return squadCount++;
+}
+
+/**
+ * JoinSquad - Adds an object to a squad.
+ *
+ * @obj:   The object, it follows the squad's plan from its next decision on.
+ * @squad: The squad's index.
+ */
+void JoinSquad(GameObject *obj, int squad)
+{
+    if (obj->squad != SQUAD_NONE || squad < 0 || squad >= squadCount)
+    {
+        return;
+    }
+
+    Squad *joined = &squads[squad];
+    if (joined->memberCount == MAX_SQUAD_MEMBERS)
+    {
+        printf("Squad %d is full, %s decides alone\n", squad, obj->name);
+        return;
+    }
+
+    joined->members[joined->memberCount++] = obj;
+    obj->squad = squad;
+}
+
+/**
+ * LeaveSquad - Removes an object from its squad.
+ *
+ * @obj: The object, it decides alone from its next decision on.
+ *
+ * The last member takes the object's place (and its formation slot).
+ */
+void LeaveSquad(GameObject *obj)
+{
+    if (obj->squad == SQUAD_NONE)
+    {
+        return;
+    }
+
+    Squad *left = &squads[obj->squad];
+    for (int i = 0; i < left->memberCount; i++)
+    {
+        if (left->members[i] == obj)
+        {
+            left->members[i] = left->members[--left->memberCount];
+            break;
+        }
+    }
+    obj->squad = SQUAD_NONE;
+}
+
+// Spreads the members along the flanking ring around the player, centred on the rally spot
+static void FormEngageSlots(SquadPlan *plan, const WorldFacts *facts, int memberCount)
+{
+    Vector2 fromPlayer = Vector2Subtract(plan->rally, facts->playerPosition);
+    float radius = fmaxf(Vector2Length(fromPlayer), NPC_FLANK_MIN_RANGE);
+    float centre = atan2f(fromPlayer.y, fromPlayer.x);
+
+    for (int i = 0; i < memberCount; i++)
+    {
+        float angle = centre + (i - (memberCount - 1) * 0.5f) * SQUAD_ENGAGE_SPREAD;
+        plan->slots[i] = Vector2Add(facts->playerPosition, (Vector2){radius * cosf(angle), radius * sinf(angle)});
+    }
+}
+
+// Spreads the members around the rally spot (the only member stands on it)
+static void FormRetreatSlots(SquadPlan *plan, int memberCount)
+{
+    float radius = memberCount > 1 ? SQUAD_FORMATION_SPACING : 0.0f;
+
+    for (int i = 0; i < memberCount; i++)
+    {
+        float angle = 2.0f * PI * i / memberCount;
+        plan->slots[i] = Vector2Add(plan->rally, (Vector2){radius * cosf(angle), radius * sinf(angle)});
+    }
+}
+
+// Makes a squad's decision from the world facts and its living members
+static void DecideSquad(Squad *squad, const WorldFacts *facts)
+{
+    SquadPlan *plan = &squad->plan;
+
+    // Where the pack is and how it is holding up
+    Vector2 centroid = {0, 0};
+    float health = 0.0f;
+    int living = 0;
+    for (int i = 0; i < squad->memberCount; i++)
+    {
+        const GameObject *member = squad->members[i];
+        if (member->currentState == STATE_DEAD || member->health <= 0)
+            continue;
+
+        centroid = Vector2Add(centroid, member->position);
+        health += member->health;
+        living++;
+    }
+
+    plan->order = SQUAD_ORDER_NONE;
+    if (living == 0 || !facts->playerPresent)
+    {
+        return;
+    }
+
+    centroid = Vector2Scale(centroid, 1.0f / living);
+    if (Vector2Distance(centroid, facts->playerPosition) >= AI_SENSE_RANGE)
+    {
+        return;
+    }
+
+    if (health / living < NPC_RETREAT_HEALTH)
+    {
+        plan->order = SQUAD_ORDER_RETREAT;
+        plan->rally = FindRetreatPosition(facts, centroid);
+        FormRetreatSlots(plan, squad->memberCount);
+    }
+    else
+    {
+        plan->order = SQUAD_ORDER_ENGAGE;
+        plan->rally = FindFlankingPosition(facts, centroid);
+        FormEngageSlots(plan, facts, squad->memberCount);
+    }
+}
+
+/**
+ * UpdateSquads - Makes the decisions of the squads that are due.
+ *
+ * @dt: Seconds since the last update.
+ *
+ * Called on the simulation thread after the world facts are published and
+ * before the AI system runs, which reads the plans on its workers. A squad
+ * decides every AI_THINK_INTERVAL, its members refine the plan at their own
+ * intervals in between.
+ */
+void UpdateSquads(float dt)
+{
+    const WorldFacts *facts = GetWorldFacts();
+
+    for (int i = 0; i < squadCount; i++)
+    {
+        Squad *squad = &squads[i];
+        if (squad->memberCount == 0)
+            continue;
+
+        squad->untilThink -= dt;
+        if (squad->untilThink > 0.0f)
+            continue;
+
+        squad->untilThink += AI_THINK_INTERVAL;
+        if (squad->untilThink <= 0.0f)
+        {
+            squad->untilThink = AI_THINK_INTERVAL;
+        }
+        DecideSquad(squad, facts);
+    }
+}
+
+// Get the order of an object's squad and the object's slot in the formation
+bool GetSquadOrder(const GameObject *obj, SquadOrder *order, Vector2 *slot)
+{
+    if (obj->squad == SQUAD_NONE)
+    {
+        return false;
+    }
+
+    const Squad *squad = &squads[obj->squad];
+    if (squad->plan.order == SQUAD_ORDER_NONE)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < squad->memberCount; i++)
+    {
+        if (squad->members[i] == obj)
+        {
+            *order = squad->plan.order;
+            *slot = squad->plan.slots[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * ExitSquads - Releases the squads.
+ *
+ * Called once at shutdown, after every member has left.
+ */
+void ExitSquads()
+{
+    free(squads);
+    squads = NULL;
+    squadCount = 0;
+    squadCapacity = 0;
+}
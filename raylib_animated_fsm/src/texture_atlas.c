@@ -0,0 +1,441 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "../include/render/texture_atlas.h"
+
+// Width of an atlas page, pages are trimmed to the height they use
+#define ATLAS_PAGE_SIZE 2048
+
+// Transparent pixels around every frame, stops neighbours bleeding in when filtered
+#define ATLAS_PADDING 2
+
+#define MAX_ATLAS_SHEETS 8
+#define MAX_ATLAS_PAGES 4
+
+// A sprite sheet clips are registered against
+typedef struct
+{
+    char path[256];    // Sheet file
+    int page;          // Atlas page holding its frames, -1 if the sheet is not packed
+    Texture2D texture; // The sheet itself, loaded on demand when it is not packed
+    bool loaded;       // True if texture was loaded
+} AtlasSheet;
+
+// A registered clip, rewritten in place once the atlas is built
+typedef struct
+{
+    int sheet;
+    Rectangle *frames;
+    int frameCount;
+} AtlasClip;
+
+// A unique frame on a sheet and where it was packed
+typedef struct
+{
+    int sheet;
+    Rectangle source;
+    Rectangle packed;
+} AtlasFrame;
+
+// Shelf packing cursor of a page
+typedef struct
+{
+    int x;           // Next free column on the current shelf
+    int y;           // Top of the current shelf
+    int shelfHeight; // Height of the tallest frame on the current shelf
+} AtlasCursor;
+
+static AtlasSheet sheets[MAX_ATLAS_SHEETS];
+static int sheetCount = 0;
+
+static AtlasClip *clips = NULL;
+static int clipCount = 0;
+static int clipCapacity = 0;
+
+static AtlasFrame *frames = NULL;
+static int frameCount = 0;
+
+static Texture2D pages[MAX_ATLAS_PAGES];
+static int pageHeights[MAX_ATLAS_PAGES];
+static int pageCount = 0;
+
+static bool built = false;
+
+// Finds a sheet by path, adding it if it is new (-1 if there is no room)
+static int FindAtlasSheet(const char *path)
+{
+    for (int i = 0; i < sheetCount; i++)
+    {
+        if (strcmp(sheets[i].path, path) == 0)
+            return i;
+    }
+
+    if (sheetCount == MAX_ATLAS_SHEETS)
+    {
+        fprintf(stderr, "Too many sprite sheets for the texture atlas: %s\n", path);
+        return -1;
+    }
+
+    AtlasSheet *sheet = &sheets[sheetCount];
+    snprintf(sheet->path, sizeof(sheet->path), "%s", path);
+    sheet->page = -1;
+    sheet->loaded = false;
+    return sheetCount++;
+}
+
+/**
+ * AddAtlasClip - Registers the frames of an animation clip for packing.
+ *
+ * @sheetPath:      The sprite sheet the frames are on.
+ * @clipFrames:     The clip's frame rectangles, must stay valid (e.g., a static table).
+ * @clipFrameCount: The number of frames in the clip.
+ *
+ * Only frames referenced by a registered clip are packed. BuildTextureAtlas rewrites
+ * the rectangles in place, so animations initialised from the clip afterwards point
+ * into the atlas page returned by GetAtlasTexture.
+ */
+void AddAtlasClip(const char *sheetPath, Rectangle *clipFrames, int clipFrameCount)
+{
+    if (built)
+    {
+        fprintf(stderr, "Texture atlas already built, clip on %s not packed\n", sheetPath);
+        return;
+    }
+
+    int sheet = FindAtlasSheet(sheetPath);
+    if (sheet < 0)
+        return;
+
+    if (clipCount == clipCapacity)
+    {
+        int newCapacity = clipCapacity ? clipCapacity * 2 : 32;
+        AtlasClip *grown = (AtlasClip *)realloc(clips, sizeof(AtlasClip) * newCapacity);
+        if (!grown)
+        {
+            fprintf(stderr, "Failed to allocate atlas clips\n");
+            exit(1);
+        }
+        clips = grown;
+        clipCapacity = newCapacity;
+    }
+
+    clips[clipCount++] = (AtlasClip){sheet, clipFrames, clipFrameCount};
+}
+
+// Returns the unique frame for a source rectangle, -1 if it is not registered
+static int FindAtlasFrame(int sheet, Rectangle source)
+{
+    for (int i = 0; i < frameCount; i++)
+    {
+        const AtlasFrame *frame = &frames[i];
+        if (frame->sheet == sheet &&
+            frame->source.x == source.x && frame->source.y == source.y &&
+            frame->source.width == source.width && frame->source.height == source.height)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Collects the unique frames referenced by the registered clips
+static void CollectAtlasFrames()
+{
+    int total = 0;
+    for (int c = 0; c < clipCount; c++)
+        total += clips[c].frameCount;
+
+    frames = (AtlasFrame *)malloc(sizeof(AtlasFrame) * (total > 0 ? total : 1));
+    if (!frames)
+    {
+        fprintf(stderr, "Failed to allocate atlas frames\n");
+        exit(1);
+    }
+
+    for (int c = 0; c < clipCount; c++)
+    {
+        for (int f = 0; f < clips[c].frameCount; f++)
+        {
+            Rectangle source = clips[c].frames[f];
+            if (FindAtlasFrame(clips[c].sheet, source) < 0)
+            {
+                frames[frameCount++] = (AtlasFrame){clips[c].sheet, source, source};
+            }
+        }
+    }
+}
+
+// Orders frame indices tallest first, which keeps the shelves tight
+static int CompareFrameHeights(const void *lhs, const void *rhs)
+{
+    const AtlasFrame *a = &frames[*(const int *)lhs];
+    const AtlasFrame *b = &frames[*(const int *)rhs];
+
+    if (a->source.height != b->source.height)
+        return (a->source.height > b->source.height) ? -1 : 1;
+    if (a->source.width != b->source.width)
+        return (a->source.width > b->source.width) ? -1 : 1;
+    return *(const int *)lhs - *(const int *)rhs;
+}
+
+/**
+ * PackSheetFrames - Shelf packs one sheet's frames into a page.
+ *
+ * @order:  The sheet's frame indices, tallest first.
+ * @count:  The number of frames.
+ * @cursor: The page's packing cursor, only advanced if every frame fits.
+ *
+ * A sheet's frames all go on the same page so every object keeps drawing from a
+ * single texture.
+ *
+ * Return: true if the frames were packed.
+ */
+static bool PackSheetFrames(const int *order, int count, AtlasCursor *cursor)
+{
+    AtlasCursor next = *cursor;
+
+    for (int i = 0; i < count; i++)
+    {
+        const AtlasFrame *frame = &frames[order[i]];
+        int width = (int)frame->source.width + ATLAS_PADDING * 2;
+        int height = (int)frame->source.height + ATLAS_PADDING * 2;
+
+        if (width > ATLAS_PAGE_SIZE)
+            return false;
+
+        // Start a new shelf when the frame does not fit on the current one
+        if (next.x + width > ATLAS_PAGE_SIZE)
+        {
+            next.y += next.shelfHeight;
+            next.x = 0;
+            next.shelfHeight = 0;
+        }
+        if (next.y + height > ATLAS_PAGE_SIZE)
+            return false;
+
+        next.x += width;
+        if (height > next.shelfHeight)
+            next.shelfHeight = height;
+    }
+
+    // Everything fits, place the frames for real
+    for (int i = 0; i < count; i++)
+    {
+        AtlasFrame *frame = &frames[order[i]];
+        int width = (int)frame->source.width + ATLAS_PADDING * 2;
+        int height = (int)frame->source.height + ATLAS_PADDING * 2;
+
+        if (cursor->x + width > ATLAS_PAGE_SIZE)
+        {
+            cursor->y += cursor->shelfHeight;
+            cursor->x = 0;
+            cursor->shelfHeight = 0;
+        }
+
+        frame->packed = (Rectangle){
+            (float)(cursor->x + ATLAS_PADDING),
+            (float)(cursor->y + ATLAS_PADDING),
+            frame->source.width,
+            frame->source.height};
+
+        cursor->x += width;
+        if (height > cursor->shelfHeight)
+            cursor->shelfHeight = height;
+    }
+    return true;
+}
+
+// Checks that every frame of a sheet lies inside its image
+static bool SheetFramesInImage(int sheet, Image image)
+{
+    for (int i = 0; i < frameCount; i++)
+    {
+        const Rectangle source = frames[i].source;
+        if (frames[i].sheet == sheet &&
+            (source.x < 0 || source.y < 0 || source.width <= 0 || source.height <= 0 ||
+             source.x + source.width > image.width || source.y + source.height > image.height))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * BuildTextureAtlas - Packs the frames of every registered clip into atlas pages.
+ *
+ * Each sheet is loaded as an image once, only the frames its clips reference are
+ * copied onto a page and the sheet image is released again, so the unused rows of
+ * the sheets never stay resident. Clip rectangles are then rewritten to the page.
+ * A sheet that cannot be loaded or packed keeps its original rectangles and is
+ * drawn from the sheet texture instead.
+ *
+ * Must be called once, after InitWindow and before the first clip is played.
+ */
+void BuildTextureAtlas()
+{
+    if (built)
+        return;
+    built = true;
+
+    CollectAtlasFrames();
+
+    Image images[MAX_ATLAS_SHEETS] = {0};
+    int *order = (int *)malloc(sizeof(int) * (frameCount > 0 ? frameCount : 1));
+    if (!order)
+    {
+        fprintf(stderr, "Failed to allocate atlas frames\n");
+        exit(1);
+    }
+
+    AtlasCursor cursors[MAX_ATLAS_PAGES] = {0};
+    pageCount = 0;
+
+    for (int s = 0; s < sheetCount; s++)
+    {
+        images[s] = LoadImage(sheets[s].path);
+        if (!images[s].data || !SheetFramesInImage(s, images[s]))
+        {
+            printf("Texture atlas: %s not packed, drawing from the sheet\n", sheets[s].path);
+            continue;
+        }
+        ImageFormat(&images[s], PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+        int count = 0;
+        for (int i = 0; i < frameCount; i++)
+        {
+            if (frames[i].sheet == s)
+                order[count++] = i;
+        }
+        qsort(order, count, sizeof(int), CompareFrameHeights);
+
+        // Try the current page, then a fresh one
+        int page = pageCount - 1;
+        if (page < 0 || !PackSheetFrames(order, count, &cursors[page]))
+        {
+            page = -1;
+            if (pageCount < MAX_ATLAS_PAGES && PackSheetFrames(order, count, &cursors[pageCount]))
+            {
+                page = pageCount++;
+            }
+        }
+
+        sheets[s].page = page;
+        if (page < 0)
+        {
+            printf("Texture atlas: %s does not fit, drawing from the sheet\n", sheets[s].path);
+        }
+    }
+
+    // Copy the frames onto the pages
+    for (int p = 0; p < pageCount; p++)
+    {
+        int height = cursors[p].y + cursors[p].shelfHeight;
+        Image pageImage = GenImageColor(ATLAS_PAGE_SIZE, height, BLANK);
+
+        for (int i = 0; i < frameCount; i++)
+        {
+            const AtlasFrame *frame = &frames[i];
+            if (sheets[frame->sheet].page == p)
+            {
+                ImageDraw(&pageImage, images[frame->sheet], frame->source, frame->packed, WHITE);
+            }
+        }
+
+        pages[p] = LoadTextureFromImage(pageImage);
+        pageHeights[p] = height;
+        UnloadImage(pageImage);
+    }
+
+    for (int s = 0; s < sheetCount; s++)
+    {
+        if (images[s].data)
+            UnloadImage(images[s]);
+    }
+
+    // Point the clips at the packed frames
+    int packedFrames = 0;
+    for (int c = 0; c < clipCount; c++)
+    {
+        if (sheets[clips[c].sheet].page < 0)
+            continue;
+
+        for (int f = 0; f < clips[c].frameCount; f++)
+        {
+            // A table registered twice has already been rewritten
+            int frame = FindAtlasFrame(clips[c].sheet, clips[c].frames[f]);
+            if (frame >= 0)
+                clips[c].frames[f] = frames[frame].packed;
+        }
+    }
+    for (int i = 0; i < frameCount; i++)
+    {
+        if (sheets[frames[i].sheet].page >= 0)
+            packedFrames++;
+    }
+
+    for (int p = 0; p < pageCount; p++)
+    {
+        printf("Texture atlas page %d: %dx%d\n", p, ATLAS_PAGE_SIZE, pageHeights[p]);
+    }
+    printf("Texture atlas: %d frames from %d sheets packed into %d page(s)\n", packedFrames, sheetCount, pageCount);
+
+    free(order);
+}
+
+/**
+ * GetAtlasTexture - Returns the texture a sheet's clips are drawn from.
+ *
+ * @sheetPath: The sprite sheet the clips were registered against.
+ *
+ * Return: The atlas page holding the sheet's frames, or the sheet itself (loaded
+ *         once and shared) if it was not packed.
+ */
+Texture2D GetAtlasTexture(const char *sheetPath)
+{
+    int sheet = FindAtlasSheet(sheetPath);
+    if (sheet < 0)
+        return LoadTexture(sheetPath); // No room to cache it, should not happen with MAX_ATLAS_SHEETS
+
+    if (sheets[sheet].page >= 0)
+        return pages[sheets[sheet].page];
+
+    if (!sheets[sheet].loaded)
+    {
+        sheets[sheet].texture = LoadTexture(sheetPath);
+        sheets[sheet].loaded = true;
+    }
+    return sheets[sheet].texture;
+}
+
+/**
+ * UnloadTextureAtlas - Unloads the atlas pages and sheets loaded as a fallback.
+ *
+ * Must only be called once no object draws from the atlas any more.
+ */
+void UnloadTextureAtlas()
+{
+    for (int p = 0; p < pageCount; p++)
+        UnloadTexture(pages[p]);
+    pageCount = 0;
+
+    for (int s = 0; s < sheetCount; s++)
+    {
+        if (sheets[s].loaded)
+            UnloadTexture(sheets[s].texture);
+    }
+    sheetCount = 0;
+
+    free(clips);
+    clips = NULL;
+    clipCount = 0;
+    clipCapacity = 0;
+
+    free(frames);
+    frames = NULL;
+    frameCount = 0;
+
+    built = false;
+}
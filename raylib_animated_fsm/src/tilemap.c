@@ -0,0 +1,353 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <raylib.h>
+
+#include "../include/render/tilemap.h"
+
+// Chunks this many tiles outside the view are cached ahead of the camera
+#define TILEMAP_PRELOAD_TILES 4
+
+// Cached chunks are only released a whole chunk outside the view, so a camera
+// moving back and forth over a chunk edge does not rebuild it every frame
+#define TILEMAP_EVICT_TILES TILEMAP_CHUNK_TILES
+
+// Range of chunks a world rectangle overlaps, clamped to the map
+typedef struct
+{
+    int firstColumn;
+    int lastColumn;
+    int firstRow;
+    int lastRow;
+} ChunkRange;
+
+// Gets the chunks a world rectangle grown by margin overlaps (empty if none)
+static ChunkRange GetChunkRange(const Tilemap *tilemap, Rectangle rect, float margin)
+{
+    const float chunkSize = (float)(TILEMAP_CHUNK_TILES * tilemap->tileSize);
+
+    ChunkRange range = {
+        (int)floorf((rect.x - margin) / chunkSize),
+        (int)floorf((rect.x + rect.width + margin) / chunkSize),
+        (int)floorf((rect.y - margin) / chunkSize),
+        (int)floorf((rect.y + rect.height + margin) / chunkSize)};
+
+    if (range.firstColumn < 0)
+        range.firstColumn = 0;
+    if (range.firstRow < 0)
+        range.firstRow = 0;
+    if (range.lastColumn >= tilemap->chunkColumns)
+        range.lastColumn = tilemap->chunkColumns - 1;
+    if (range.lastRow >= tilemap->chunkRows)
+        range.lastRow = tilemap->chunkRows - 1;
+
+    return range;
+}
+
+// Checks if a chunk is in a range
+static bool IsChunkInRange(ChunkRange range, int column, int row)
+{
+    return column >= range.firstColumn && column <= range.lastColumn &&
+           row >= range.firstRow && row <= range.lastRow;
+}
+
+// Gets the source rectangle of a tile on the tileset
+static Rectangle GetTileSource(const Tilemap *tilemap, int tile)
+{
+    const int tilesetColumns = tilemap->tileset.width / tilemap->tileSize;
+    const float size = (float)tilemap->tileSize;
+
+    return (Rectangle){(float)(tile % tilesetColumns) * size, (float)(tile / tilesetColumns) * size, size, size};
+}
+
+// Draws every layer of the tiles in a block of the map, offset so the block's
+// first tile lands on origin
+static void DrawTiles(const Tilemap *tilemap, int firstColumn, int lastColumn, int firstRow, int lastRow, Vector2 origin)
+{
+    const float size = (float)tilemap->tileSize;
+
+    for (int layer = 0; layer < TILEMAP_LAYER_COUNT; layer++)
+    {
+        for (int row = firstRow; row <= lastRow; row++)
+        {
+            const int *tiles = &tilemap->tiles[layer][row * tilemap->columns];
+            for (int column = firstColumn; column <= lastColumn; column++)
+            {
+                if (tiles[column] == TILE_EMPTY)
+                    continue;
+
+                Vector2 position = {origin.x + (column - firstColumn) * size, origin.y + (row - firstRow) * size};
+                DrawTextureRec(tilemap->tileset, GetTileSource(tilemap, tiles[column]), position, WHITE);
+            }
+        }
+    }
+}
+
+// Gets the tiles a chunk covers (chunks on the right and bottom edges may be partial)
+static void GetChunkTiles(const Tilemap *tilemap, int column, int row, int *firstColumn, int *lastColumn, int *firstRow, int *lastRow)
+{
+    *firstColumn = column * TILEMAP_CHUNK_TILES;
+    *firstRow = row * TILEMAP_CHUNK_TILES;
+    *lastColumn = (int)fminf((float)(*firstColumn + TILEMAP_CHUNK_TILES), (float)tilemap->columns) - 1;
+    *lastRow = (int)fminf((float)(*firstRow + TILEMAP_CHUNK_TILES), (float)tilemap->rows) - 1;
+}
+
+/**
+ * CreateTilemap - Creates an empty tilemap.
+ *
+ * @tileset:  The texture tiles are taken from, a grid of tileSize cells numbered
+ *            left to right, top to bottom.
+ * @tileSize: The size of a tile, on the tileset and in the world.
+ * @columns:  The number of tiles across the map.
+ * @rows:     The number of tiles down the map.
+ *
+ * The map is split into chunks of TILEMAP_CHUNK_TILES x TILEMAP_CHUNK_TILES tiles.
+ * Chunks near the camera are rendered once, every layer at once, into a texture
+ * that is drawn with a single call per frame after that, so drawing the map costs
+ * a handful of draws however many tiles and layers it has.
+ *
+ * Return: The tilemap, every tile TILE_EMPTY.
+ */
+Tilemap *CreateTilemap(Texture2D tileset, int tileSize, int columns, int rows)
+{
+    Tilemap *tilemap = (Tilemap *)malloc(sizeof(Tilemap));
+    if (!tilemap)
+    {
+        fprintf(stderr, "Failed to allocate tilemap\n");
+        exit(1);
+    }
+
+    tilemap->tileset = tileset;
+    tilemap->tileSize = tileSize;
+    tilemap->columns = columns;
+    tilemap->rows = rows;
+    tilemap->chunkColumns = (columns + TILEMAP_CHUNK_TILES - 1) / TILEMAP_CHUNK_TILES;
+    tilemap->chunkRows = (rows + TILEMAP_CHUNK_TILES - 1) / TILEMAP_CHUNK_TILES;
+    tilemap->cachedChunks = 0;
+
+    for (int layer = 0; layer < TILEMAP_LAYER_COUNT; layer++)
+    {
+        tilemap->tiles[layer] = (int *)malloc(sizeof(int) * columns * rows);
+        if (!tilemap->tiles[layer])
+        {
+            fprintf(stderr, "Failed to allocate tilemap\n");
+            exit(1);
+        }
+
+        for (int i = 0; i < columns * rows; i++)
+        {
+            tilemap->tiles[layer][i] = TILE_EMPTY;
+        }
+    }
+
+    tilemap->chunks = (TilemapChunk *)calloc(tilemap->chunkColumns * tilemap->chunkRows, sizeof(TilemapChunk));
+    tilemap->cached = (int *)malloc(sizeof(int) * tilemap->chunkColumns * tilemap->chunkRows);
+    if (!tilemap->chunks || !tilemap->cached)
+    {
+        fprintf(stderr, "Failed to allocate tilemap chunks\n");
+        exit(1);
+    }
+
+    return tilemap;
+}
+
+/**
+ * SetTile - Sets a tile.
+ *
+ * @tilemap: The tilemap.
+ * @layer:   The layer the tile is in.
+ * @column:  The tile's column.
+ * @row:     The tile's row.
+ * @tile:    The tile's cell on the tileset, or TILE_EMPTY.
+ *
+ * The tile's chunk is drawn again the next time it is cached or drawn.
+ */
+void SetTile(Tilemap *tilemap, TilemapLayer layer, int column, int row, int tile)
+{
+    if (layer < 0 || layer >= TILEMAP_LAYER_COUNT ||
+        column < 0 || column >= tilemap->columns || row < 0 || row >= tilemap->rows)
+    {
+        return;
+    }
+
+    tilemap->tiles[layer][row * tilemap->columns + column] = tile;
+    tilemap->chunks[(row / TILEMAP_CHUNK_TILES) * tilemap->chunkColumns + column / TILEMAP_CHUNK_TILES].dirty = true;
+}
+
+// Get a tile (TILE_EMPTY outside the map)
+int GetTile(const Tilemap *tilemap, TilemapLayer layer, int column, int row)
+{
+    if (layer < 0 || layer >= TILEMAP_LAYER_COUNT ||
+        column < 0 || column >= tilemap->columns || row < 0 || row >= tilemap->rows)
+    {
+        return TILE_EMPTY;
+    }
+
+    return tilemap->tiles[layer][row * tilemap->columns + column];
+}
+
+// Renders a chunk's tiles into its cache texture (loaded on first use)
+static void BuildChunk(Tilemap *tilemap, int column, int row)
+{
+    TilemapChunk *chunk = &tilemap->chunks[row * tilemap->chunkColumns + column];
+
+    int firstColumn, lastColumn, firstRow, lastRow;
+    GetChunkTiles(tilemap, column, row, &firstColumn, &lastColumn, &firstRow, &lastRow);
+
+    if (!chunk->cached)
+    {
+        chunk->texture = LoadRenderTexture((lastColumn - firstColumn + 1) * tilemap->tileSize,
+                                           (lastRow - firstRow + 1) * tilemap->tileSize);
+        chunk->cached = true;
+        tilemap->cached[tilemap->cachedChunks++] = row * tilemap->chunkColumns + column;
+    }
+
+    BeginTextureMode(chunk->texture);
+    ClearBackground(BLANK);
+    DrawTiles(tilemap, firstColumn, lastColumn, firstRow, lastRow, (Vector2){0.0f, 0.0f});
+    EndTextureMode();
+
+    chunk->dirty = false;
+}
+
+// Releases the cache texture of the chunk at a position in the cached list
+static void EvictChunk(Tilemap *tilemap, int position)
+{
+    TilemapChunk *chunk = &tilemap->chunks[tilemap->cached[position]];
+
+    UnloadRenderTexture(chunk->texture);
+    chunk->texture = (RenderTexture2D){0};
+    chunk->cached = false;
+
+    tilemap->cached[position] = tilemap->cached[--tilemap->cachedChunks];
+}
+
+/**
+ * StreamTilemapChunks - Caches the chunks around the view and releases the far ones.
+ *
+ * @tilemap: The tilemap.
+ * @view:    The part of the world the camera sees.
+ *
+ * Called once per frame on the render thread, between BeginDrawing and BeginMode2D
+ * (chunks are rendered in texture mode). Chunks in view are cached before those
+ * just outside it, and at most TILEMAP_CHUNK_BUILDS_PER_FRAME are rendered per
+ * frame so a fast camera never stalls a frame. Only the chunks around the camera
+ * hold a texture, so a large map costs no more memory or time than a small one.
+ */
+void StreamTilemapChunks(Tilemap *tilemap, Rectangle view)
+{
+    const float preload = (float)(TILEMAP_PRELOAD_TILES * tilemap->tileSize);
+    const float evict = (float)(TILEMAP_EVICT_TILES * tilemap->tileSize);
+
+    // Release the chunks the camera has moved well away from
+    ChunkRange kept = GetChunkRange(tilemap, view, evict);
+    for (int i = tilemap->cachedChunks - 1; i >= 0; i--)
+    {
+        int index = tilemap->cached[i];
+        if (!IsChunkInRange(kept, index % tilemap->chunkColumns, index / tilemap->chunkColumns))
+        {
+            EvictChunk(tilemap, i);
+        }
+    }
+
+    // Cache the chunks in view first, then the ones the camera is heading towards
+    int builds = 0;
+    const float margins[] = {0.0f, preload};
+    for (int pass = 0; pass < 2; pass++)
+    {
+        ChunkRange range = GetChunkRange(tilemap, view, margins[pass]);
+        for (int row = range.firstRow; row <= range.lastRow; row++)
+        {
+            for (int column = range.firstColumn; column <= range.lastColumn; column++)
+            {
+                const TilemapChunk *chunk = &tilemap->chunks[row * tilemap->chunkColumns + column];
+                if (chunk->cached && !chunk->dirty)
+                    continue;
+
+                if (builds == TILEMAP_CHUNK_BUILDS_PER_FRAME)
+                    return;
+
+                BuildChunk(tilemap, column, row);
+                builds++;
+            }
+        }
+    }
+}
+
+/**
+ * DrawTilemap - Draws the part of the tilemap in view.
+ *
+ * @tilemap: The tilemap.
+ * @view:    The part of the world the camera sees.
+ *
+ * Called inside BeginMode2D. Each cached chunk in view is one draw of its texture,
+ * a chunk not cached yet (or changed since) is drawn tile by tile, only the tiles
+ * in view, until StreamTilemapChunks gets to it.
+ */
+void DrawTilemap(const Tilemap *tilemap, Rectangle view)
+{
+    const float size = (float)tilemap->tileSize;
+
+    ChunkRange range = GetChunkRange(tilemap, view, 0.0f);
+    for (int row = range.firstRow; row <= range.lastRow; row++)
+    {
+        for (int column = range.firstColumn; column <= range.lastColumn; column++)
+        {
+            const TilemapChunk *chunk = &tilemap->chunks[row * tilemap->chunkColumns + column];
+
+            int firstColumn, lastColumn, firstRow, lastRow;
+            GetChunkTiles(tilemap, column, row, &firstColumn, &lastColumn, &firstRow, &lastRow);
+            Vector2 origin = {firstColumn * size, firstRow * size};
+
+            if (chunk->cached && !chunk->dirty)
+            {
+                // Render textures are stored upside down, flip the source rectangle
+                Rectangle source = {0.0f, 0.0f, (float)chunk->texture.texture.width, -(float)chunk->texture.texture.height};
+                DrawTextureRec(chunk->texture.texture, source, origin, WHITE);
+                continue;
+            }
+
+            // Only the chunk's tiles in view
+            int viewFirstColumn = (int)fmaxf((float)firstColumn, floorf(view.x / size));
+            int viewLastColumn = (int)fminf((float)lastColumn, floorf((view.x + view.width) / size));
+            int viewFirstRow = (int)fmaxf((float)firstRow, floorf(view.y / size));
+            int viewLastRow = (int)fminf((float)lastRow, floorf((view.y + view.height) / size));
+
+            DrawTiles(tilemap, viewFirstColumn, viewLastColumn, viewFirstRow, viewLastRow,
+                      (Vector2){viewFirstColumn * size, viewFirstRow * size});
+        }
+    }
+}
+
+// Number of chunks with a cache texture loaded
+int GetCachedTilemapChunks(const Tilemap *tilemap)
+{
+    return tilemap->cachedChunks;
+}
+
+/**
+ * DeleteTilemap - Deletes a tilemap and its chunk textures.
+ *
+ * @tilemap: The tilemap to delete (ignored if NULL).
+ */
+void DeleteTilemap(Tilemap *tilemap)
+{
+    if (!tilemap)
+    {
+        return;
+    }
+
+    while (tilemap->cachedChunks > 0)
+    {
+        EvictChunk(tilemap, tilemap->cachedChunks - 1);
+    }
+
+    for (int layer = 0; layer < TILEMAP_LAYER_COUNT; layer++)
+    {
+        free(tilemap->tiles[layer]);
+    }
+    free(tilemap->chunks);
+    free(tilemap->cached);
+    free(tilemap);
+}
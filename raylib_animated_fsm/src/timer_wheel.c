@@ -0,0 +1,333 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../include/utils/timer_wheel.h"
+#include "../include/utils/constants.h"
+
+// Wheel geometry, 4 levels of 64 slots covers 64^4 (16,777,216) ticks
+#define TIMER_WHEEL_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_LEVELS 4
+#define TIMER_WHEEL_MAX_DELAY ((1u << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) - 1)
+
+// Initial number of timers in the pool, the pool doubles when exhausted
+#define TIMER_POOL_INITIAL_CAPACITY 256
+
+// A pending timer, linked into one wheel slot through next/prev pool indices
+typedef struct
+{
+    GameObject *obj;         // Game object receiving the event (may be NULL)
+    EventFunction callback;  // Optional callback, HandleEvent is used if NULL
+    Event event;             // Event delivered when the timer fires
+    unsigned int expires;    // Tick at which the timer fires
+    unsigned int generation; // Bumped each time the pool slot is released
+    int slot;                // Wheel slot holding the timer, -1 when free
+    int next;                // Next timer in the slot (or free list)
+    int prev;                // Previous timer in the slot
+} TimerNode;
+
+static TimerNode *timers = NULL;
+static int timerCapacity = 0;
+static int freeTimer = -1;
+static int wheel[TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS];
+static unsigned int currentTick = 0;
+static float pendingTicks = 0.0f; // Simulated time not yet advanced, in ticks (below one after each update)
+
+/**
+ * GrowTimerPool - Grows the timer pool and threads new nodes onto the free list.
+ *
+ * Handles store pool indices, so growing with realloc keeps existing handles valid.
+ */
+static void GrowTimerPool()
+{
+    int newCapacity = timerCapacity ? timerCapacity * 2 : TIMER_POOL_INITIAL_CAPACITY;
+    TimerNode *grown = (TimerNode *)realloc(timers, sizeof(TimerNode) * newCapacity);
+    if (!grown)
+    {
+        fprintf(stderr, "Failed to allocate timer pool\n");
+        exit(1);
+    }
+
+    // Thread the new nodes onto the free list
+    for (int i = timerCapacity; i < newCapacity; i++)
+    {
+        grown[i].generation = 0;
+        grown[i].slot = -1;
+        grown[i].next = (i + 1 < newCapacity) ? i + 1 : freeTimer;
+        grown[i].prev = -1;
+    }
+
+    freeTimer = timerCapacity;
+    timers = grown;
+    timerCapacity = newCapacity;
+}
+
+/**
+ * LinkTimer - Places a timer into the wheel slot matching its expiry tick.
+ *
+ * The level is chosen by how far away the expiry is, so near timers go into the
+ * fine grained level and far timers are cascaded down as the wheel turns.
+ */
+static void LinkTimer(int index)
+{
+    TimerNode *node = &timers[index];
+    unsigned int delta = node->expires - currentTick;
+
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 &&
+           delta >= (1u << (TIMER_WHEEL_BITS * (level + 1))))
+    {
+        level++;
+    }
+
+    int slot = level * TIMER_WHEEL_SLOTS +
+               ((node->expires >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK);
+
+    // Push onto the front of the slot list
+    node->slot = slot;
+    node->prev = -1;
+    node->next = wheel[slot];
+    if (wheel[slot] != -1)
+    {
+        timers[wheel[slot]].prev = index;
+    }
+    wheel[slot] = index;
+}
+
+// Removes a timer from its wheel slot
+static void UnlinkTimer(int index)
+{
+    TimerNode *node = &timers[index];
+
+    if (node->prev != -1)
+        timers[node->prev].next = node->next;
+    else
+        wheel[node->slot] = node->next;
+
+    if (node->next != -1)
+        timers[node->next].prev = node->prev;
+
+    node->slot = -1;
+}
+
+// Returns a timer node to the free list, invalidating outstanding handles
+static void ReleaseTimer(int index)
+{
+    timers[index].generation++;
+    timers[index].next = freeTimer;
+    freeTimer = index;
+}
+
+/**
+ * CascadeTimers - Redistributes the timers of a higher level slot into lower levels.
+ *
+ * @level: The wheel level being cascaded (1 or above).
+ * @index: The slot within that level which has come due.
+ */
+static void CascadeTimers(int level, int index)
+{
+    int slot = level * TIMER_WHEEL_SLOTS + index;
+    int current = wheel[slot];
+    wheel[slot] = -1;
+
+    while (current != -1)
+    {
+        int next = timers[current].next;
+        LinkTimer(current);
+        current = next;
+    }
+}
+
+/**
+ * InitTimerWheel - Initialises the timer wheel service.
+ *
+ * Empties every wheel slot and resets the tick counter. The timer pool is
+ * allocated lazily on the first ScheduleTimer call.
+ */
+void InitTimerWheel()
+{
+    for (int i = 0; i < TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS; i++)
+    {
+        wheel[i] = -1;
+    }
+    currentTick = 0;
+    pendingTicks = 0.0f;
+}
+
+/**
+ * ScheduleTimer - Schedules an event to be delivered to a game object in the future.
+ *
+ * @obj:        The GameObject receiving the event (NULL for a bare timer).
+ * @event:      The event delivered when the timer fires.
+ * @delayTicks: Number of ticks until the timer fires (at least 1, clamped to the wheel range).
+ * @callback:   Optional function called instead of HandleEvent when the timer fires.
+ *
+ * Inserting is O(1): a node is taken from the free list and pushed onto one slot.
+ *
+ * Return: A handle that can be used to cancel or query the timer.
+ */
+TimerHandle ScheduleTimer(GameObject *obj, Event event, unsigned int delayTicks, EventFunction callback)
+{
+    if (freeTimer == -1)
+    {
+        GrowTimerPool();
+    }
+
+    // Clamp the delay so the timer always lands inside the wheel
+    if (delayTicks == 0)
+        delayTicks = 1;
+    if (delayTicks > TIMER_WHEEL_MAX_DELAY)
+        delayTicks = TIMER_WHEEL_MAX_DELAY;
+
+    int index = freeTimer;
+    TimerNode *node = &timers[index];
+    freeTimer = node->next;
+
+    node->obj = obj;
+    node->callback = callback;
+    node->event = event;
+    node->expires = currentTick + delayTicks;
+    LinkTimer(index);
+
+    return (TimerHandle){index, node->generation};
+}
+
+/**
+ * ScheduleTimerSeconds - Schedules a timer with a delay expressed in seconds.
+ *
+ * The delay is rounded up to whole ticks using TIMER_TICKS_PER_SECOND.
+ */
+TimerHandle ScheduleTimerSeconds(GameObject *obj, Event event, float seconds, EventFunction callback)
+{
+    float ticks = ceilf(seconds * TIMER_TICKS_PER_SECOND);
+    return ScheduleTimer(obj, event, ticks > 0.0f ? (unsigned int)ticks : 1u, callback);
+}
+
+/**
+ * IsTimerPending - Checks whether the timer behind a handle has yet to fire.
+ */
+bool IsTimerPending(TimerHandle handle)
+{
+    return handle.index >= 0 && handle.index < timerCapacity &&
+           timers[handle.index].generation == handle.generation &&
+           timers[handle.index].slot != -1;
+}
+
+/**
+ * CancelTimer - Cancels a pending timer in O(1).
+ *
+ * @handle: The handle of the timer, reset to TIMER_HANDLE_NONE on return.
+ *
+ * Return: true if a pending timer was cancelled, false if it had already fired
+ *         or the handle was empty.
+ */
+bool CancelTimer(TimerHandle *handle)
+{
+    bool pending = IsTimerPending(*handle);
+    if (pending)
+    {
+        UnlinkTimer(handle->index);
+        ReleaseTimer(handle->index);
+    }
+    *handle = TIMER_HANDLE_NONE;
+    return pending;
+}
+
+/**
+ * CancelTimersForGameObject - Cancels every pending timer targeting a game object.
+ *
+ * Used when a GameObject is deleted so no timer fires into freed memory. This walks
+ * the pool, it is meant for teardown rather than for per-frame use.
+ */
+void CancelTimersForGameObject(GameObject *obj)
+{
+    for (int i = 0; i < timerCapacity; i++)
+    {
+        if (timers[i].slot != -1 && timers[i].obj == obj)
+        {
+            UnlinkTimer(i);
+            ReleaseTimer(i);
+        }
+    }
+}
+
+/**
+ * AdvanceTick - Advances the wheel by one tick and fires expired timers.
+ *
+ * When the low level wraps around, the matching slot of the next level is cascaded
+ * down, so a timer is only ever touched when it is inserted, cascaded (at most once
+ * per level) and fired. Pending timers cost nothing on ticks where they do not fire.
+ */
+static void AdvanceTick()
+{
+    currentTick++;
+
+    // Cascade higher levels whenever the level below wraps
+    for (int level = 1; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        if ((currentTick & ((1u << (TIMER_WHEEL_BITS * level)) - 1)) != 0)
+            break;
+
+        CascadeTimers(level, (currentTick >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK);
+    }
+
+    // Fire the timers in the current slot, popping one at a time so callbacks can
+    // safely schedule or cancel other timers
+    int slot = currentTick & TIMER_WHEEL_MASK;
+    while (wheel[slot] != -1)
+    {
+        int index = wheel[slot];
+        TimerNode fired = timers[index];
+
+        UnlinkTimer(index);
+        ReleaseTimer(index);
+
+        if (fired.callback)
+        {
+            fired.callback(fired.obj, fired.event);
+        }
+        else if (fired.obj)
+        {
+            HandleEvent(fired.obj, fired.event);
+        }
+    }
+}
+
+/**
+ * AdvanceTimerWheel - Advances the wheel by the simulated time of an update.
+ *
+ * @dt: Seconds since the last update.
+ *
+ * The time is added up and every whole tick in it is advanced (none, one or
+ * several), the remainder carries over to the next update. Timers fire after
+ * their delay in simulated time whatever the frame rate.
+ */
+void AdvanceTimerWheel(float dt)
+{
+    pendingTicks += dt * TIMER_TICKS_PER_SECOND;
+    while (pendingTicks >= 1.0f)
+    {
+        pendingTicks -= 1.0f;
+        AdvanceTick();
+    }
+}
+
+// Current tick of the timer wheel
+unsigned int GetTimerTick()
+{
+    return currentTick;
+}
+
+/**
+ * ExitTimerWheel - Releases the timer pool.
+ */
+void ExitTimerWheel()
+{
+    free(timers);
+    timers = NULL;
+    timerCapacity = 0;
+    freeTimer = -1;
+    InitTimerWheel();
+}
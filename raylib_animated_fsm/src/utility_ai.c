@@ -0,0 +1,163 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../include/utils/utility_ai.h"
+
+// Score curves of every action over every input, an action's score is the
+// product of its curves (any curve at 0 vetoes the action)
+static const AICurve actionCurves[AI_ACTION_COUNT][AI_INPUT_COUNT] = {
+    [AI_ACTION_NONE] = {
+        [AI_INPUT_PROXIMITY] = {0.0f, -0.5f, 0.6f},     // Idle when the target is far
+        [AI_INPUT_HEALTH] = {0.0f, 0.0f, 1.0f},         // Health does not matter
+        [AI_INPUT_AGGRESSION] = {0.0f, -0.3f, 0.9f},    // Aggressive NPCs idle less
+        [AI_INPUT_TARGET_THREAT] = {0.0f, 0.0f, 1.0f},  // Threat does not matter
+    },
+    [AI_ACTION_ATTACK] = {
+        [AI_INPUT_PROXIMITY] = {1.0f, 0.0f, 0.0f},      // Rises sharply as the target gets close
+        [AI_INPUT_HEALTH] = {0.0f, 0.6f, 0.4f},         // Healthy NPCs attack more
+        [AI_INPUT_AGGRESSION] = {0.0f, 0.8f, 0.4f},     // Aggressive NPCs attack more
+        [AI_INPUT_TARGET_THREAT] = {0.0f, -0.3f, 1.0f}, // Less eager into an attacking target
+    },
+    [AI_ACTION_SHIELD] = {
+        [AI_INPUT_PROXIMITY] = {0.0f, 1.0f, 0.0f},      // Only worth it near the target
+        [AI_INPUT_HEALTH] = {0.0f, -0.6f, 1.0f},        // Hurt NPCs shield more
+        [AI_INPUT_AGGRESSION] = {0.0f, -0.6f, 1.0f},    // Cautious NPCs shield more
+        [AI_INPUT_TARGET_THREAT] = {0.0f, 0.9f, 0.1f},  // Mostly when the target attacks
+    },
+};
+
+// Command each action is carried out with
+static const Command actionCommands[AI_ACTION_COUNT] = {
+    [AI_ACTION_NONE] = COMMAND_NONE,
+    [AI_ACTION_ATTACK] = COMMAND_ATTACK,
+    [AI_ACTION_SHIELD] = COMMAND_SHIELD,
+};
+
+// Grows one of a batch's arrays
+static void *GrowBatchArray(void *array, size_t size)
+{
+    void *grown = realloc(array, size);
+    if (!grown)
+    {
+        fprintf(stderr, "Failed to allocate utility AI batch\n");
+        exit(1);
+    }
+    return grown;
+}
+
+/**
+ * ReserveUtilityBatch - Makes room for count agents in a batch.
+ *
+ * @batch: The batch (zeroed before its first use).
+ * @count: The number of agents the batch must hold.
+ */
+void ReserveUtilityBatch(UtilityBatch *batch, int count)
+{
+    if (count <= batch->capacity)
+    {
+        return;
+    }
+
+    int newCapacity = batch->capacity ? batch->capacity : 64;
+    while (newCapacity < count)
+    {
+        newCapacity *= 2;
+    }
+
+    for (int input = 0; input < AI_INPUT_COUNT; input++)
+    {
+        batch->inputs[input] = (float *)GrowBatchArray(batch->inputs[input], sizeof(float) * newCapacity);
+    }
+    for (int action = 0; action < AI_ACTION_COUNT; action++)
+    {
+        batch->noise[action] = (float *)GrowBatchArray(batch->noise[action], sizeof(float) * newCapacity);
+    }
+    batch->commands = (Command *)GrowBatchArray(batch->commands, sizeof(Command) * newCapacity);
+    batch->capacity = newCapacity;
+}
+
+// Multiplies the scores of a chunk by one curve over one input
+static void ApplyCurve(float *restrict scores, const float *restrict x, AICurve curve, int count)
+{
+    for (int k = 0; k < count; k++)
+    {
+        float value = (curve.a * x[k] + curve.b) * x[k] + curve.c;
+        value = value < 0.0f ? 0.0f : value;
+        value = value > 1.0f ? 1.0f : value;
+        scores[k] *= value;
+    }
+}
+
+/**
+ * ScoreUtilityBatch - Picks the best action of a range of agents.
+ *
+ * @batch: The batch, with the inputs and noise of the range filled in.
+ * @first: The first agent to score.
+ * @last:  One past the last agent to score.
+ *
+ * Works through the range a chunk at a time: for each action, each curve runs
+ * down one input array, then the best action per agent is selected. The curve
+ * loops are branch free over contiguous floats, so the compiler vectorises them
+ * and a thousand decisions cost a few microseconds. Only the range's own slots
+ * are written, so ranges can be scored on different threads.
+ */
+void ScoreUtilityBatch(UtilityBatch *batch, int first, int last)
+{
+    float scores[AI_ACTION_COUNT][UTILITY_AI_CHUNK];
+
+    for (int start = first; start < last; start += UTILITY_AI_CHUNK)
+    {
+        const int count = (last - start < UTILITY_AI_CHUNK) ? last - start : UTILITY_AI_CHUNK;
+
+        for (int action = 0; action < AI_ACTION_COUNT; action++)
+        {
+            float *restrict score = scores[action];
+            const float *restrict noise = &batch->noise[action][start];
+
+            for (int k = 0; k < count; k++)
+            {
+                score[k] = 1.0f;
+            }
+            for (int input = 0; input < AI_INPUT_COUNT; input++)
+            {
+                ApplyCurve(score, &batch->inputs[input][start], actionCurves[action][input], count);
+            }
+            for (int k = 0; k < count; k++)
+            {
+                score[k] += noise[k] * UTILITY_AI_NOISE;
+            }
+        }
+
+        // Highest score wins, earlier actions win ties
+        for (int k = 0; k < count; k++)
+        {
+            float bestScore = scores[0][k];
+            int bestAction = 0;
+            for (int action = 1; action < AI_ACTION_COUNT; action++)
+            {
+                bool better = scores[action][k] > bestScore;
+                bestScore = better ? scores[action][k] : bestScore;
+                bestAction = better ? action : bestAction;
+            }
+            batch->commands[start + k] = actionCommands[bestAction];
+        }
+    }
+}
+
+/**
+ * ReleaseUtilityBatch - Releases a batch's storage.
+ */
+void ReleaseUtilityBatch(UtilityBatch *batch)
+{
+    for (int input = 0; input < AI_INPUT_COUNT; input++)
+    {
+        free(batch->inputs[input]);
+    }
+    for (int action = 0; action < AI_ACTION_COUNT; action++)
+    {
+        free(batch->noise[action]);
+    }
+    free(batch->commands);
+    *batch = (UtilityBatch){0};
+}
@@ -0,0 +1,94 @@
+#include <raylib.h>
+
+#include "../include/render/world_camera.h"
+#include "../include/utils/constants.h"
+
+// Camera following the player through the world
+static Camera2D camera = {0};
+
+// World rectangle the camera sees, recalculated whenever the camera moves
+static Rectangle view = {0};
+
+// Clamps one axis of the camera target so the view stays inside [0, worldSize]
+static float ClampCameraAxis(float target, float halfView, float worldSize)
+{
+    // A world smaller than the view is centred instead
+    if (worldSize <= 2.0f * halfView)
+        return worldSize / 2.0f;
+
+    if (target < halfView)
+        return halfView;
+    if (target > worldSize - halfView)
+        return worldSize - halfView;
+    return target;
+}
+
+// Recalculates the visible world rectangle from the camera
+static void UpdateWorldView()
+{
+    Vector2 topLeft = GetScreenToWorld2D((Vector2){0.0f, 0.0f}, camera);
+    Vector2 bottomRight = GetScreenToWorld2D((Vector2){(float)GetScreenWidth(), (float)GetScreenHeight()}, camera);
+
+    view = (Rectangle){topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y};
+}
+
+/**
+ * InitWorldCamera - Initialises the world camera.
+ *
+ * @target: The world position the camera starts centred on.
+ *
+ * The camera keeps its target at the centre of the screen, so objects are drawn
+ * at their world positions between BeginMode2D(GetWorldCamera()) and EndMode2D.
+ */
+void InitWorldCamera(Vector2 target)
+{
+    camera.offset = (Vector2){GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f};
+    camera.rotation = 0.0f;
+    camera.zoom = 1.0f;
+
+    UpdateWorldCamera(target);
+}
+
+/**
+ * UpdateWorldCamera - Moves the camera to follow a target.
+ *
+ * @target: The world position to centre the camera on.
+ *
+ * Near the edges of the world the camera stops, so the view never shows anything
+ * outside of WORLD_WIDTH x WORLD_HEIGHT.
+ */
+void UpdateWorldCamera(Vector2 target)
+{
+    const float halfWidth = camera.offset.x / camera.zoom;
+    const float halfHeight = camera.offset.y / camera.zoom;
+
+    camera.target.x = ClampCameraAxis(target.x, halfWidth, WORLD_WIDTH);
+    camera.target.y = ClampCameraAxis(target.y, halfHeight, WORLD_HEIGHT);
+
+    UpdateWorldView();
+}
+
+// Get the camera to draw the world with (BeginMode2D)
+Camera2D GetWorldCamera()
+{
+    return camera;
+}
+
+// Get the part of the world the camera sees, in world coordinates
+Rectangle GetWorldView()
+{
+    return view;
+}
+
+// Check if a rectangle in world coordinates overlaps the camera's view
+bool IsWorldRectVisible(Rectangle rect)
+{
+    return CheckCollisionRecs(rect, view);
+}
+
+// Check if a point in world coordinates is within margin of the camera's view
+bool IsWorldPointNearView(Vector2 point, float margin)
+{
+    return point.x >= view.x - margin && point.x <= view.x + view.width + margin &&
+           point.y >= view.y - margin && point.y <= view.y + view.height + margin;
+}
@@ -0,0 +1,441 @@
+/**
+ * fsm_compiler - Compiles a text FSM definition (.fsm) into a binary blob (.fsmb).
+ *
+ * Usage: fsm_compiler <input.fsm> <output.fsmb>
+ *        fsm_compiler --dispatch <input.fsm> <output.h>
+ *
+ * With --dispatch the graph is emitted as C instead: a header of switch statements
+ * over the current state that call the handlers directly (see FSM_GENERATED_DISPATCH
+ * in fsm.c). The blob stays the dynamic fallback for objects without generated dispatch.
+ *
+ * Definition format, one directive per line, '#' starts a comment:
+ *
+ *   archetype Player               name prefixing the generated dispatch functions
+ *   state STATE_IDLE Player_Idle   begin a state (enum name, display name)
+ *   handle PlayerIdleHandleEvent   HandleEvent handler
+ *   entry  PlayerEnterIdle         Entry handler
+ *   update PlayerUpdateIdle        Update handler
+ *   exit   PlayerExitIdle          Exit handler
+ *   resume PlayerResumeIdle        Resume handler (see scheduler.h)
+ *   next   STATE_WALKING ...       valid next states
+ *   events EVENT_NONE ...          events the state reacts to (omit for every event)
+ *   end                            end of the state
+ *
+ * States that are not defined stay empty. Handler names are stored once and bound
+ * to function pointers at load time through the registry (see fsm_loader.h).
+ *
+ * Built for the host by the Makefile, it only depends on the FSM and event enums.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <ctype.h>
+
+#include "../include/fsm/fsm.h"
+#include "../include/fsm/fsm_blob.h"
+
+#define MAX_LINE 1024
+#define MAX_HANDLERS 256
+#define MAX_STRINGS 8192
+
+// Enum names as written in .fsm files, in enum order
+static const char *stateNames[] = {
+    "STATE_IDLE", "STATE_WALKING", "STATE_MOVING_UP", "STATE_MOVING_DOWN",
+    "STATE_MOVING_LEFT", "STATE_MOVING_RIGHT", "STATE_MOVING_UP_LEFT", "STATE_MOVING_UP_RIGHT",
+    "STATE_MOVING_DOWN_LEFT", "STATE_MOVING_DOWN_RIGHT", "STATE_ATTACKING", "STATE_SHIELD",
+    "STATE_DEAD", "STATE_RESPAWN", "STATE_COLLISION"};
+
+static const char *eventNames[] = {
+    "EVENT_NONE", "EVENT_MOVE_UP", "EVENT_MOVE_UP_RIGHT", "EVENT_MOVE_UP_LEFT",
+    "EVENT_MOVE_DOWN", "EVENT_MOVE_DOWN_RIGHT", "EVENT_MOVE_DOWN_LEFT", "EVENT_MOVE_LEFT",
+    "EVENT_MOVE_RIGHT", "EVENT_MOVE", "EVENT_ATTACK", "EVENT_DEFEND", "EVENT_DIE",
+    "EVENT_RESPAWN", "EVENT_SHIELD", "EVENT_TIMEOUT", "EVENT_COLLISION_START",
+    "EVENT_COLLISION_END"};
+
+_Static_assert(sizeof(stateNames) / sizeof(stateNames[0]) == STATE_COUNT, "stateNames out of sync with State");
+_Static_assert(sizeof(eventNames) / sizeof(eventNames[0]) == EVENT_COUNT, "eventNames out of sync with Event");
+
+// Handler directive keywords, in FsmHandlerKind order
+static const char *handlerKeywords[FSM_HANDLER_KIND_COUNT] = {"handle", "entry", "update", "exit", "resume"};
+
+// Handler parameter lists, in FsmHandlerKind order (must match the fsm.h function types)
+static const char *handlerParameters[FSM_HANDLER_KIND_COUNT] = {
+    "GameObject *obj, Event event", "GameObject *obj", "GameObject *obj", "GameObject *obj", "GameObject *obj, float elapsed"};
+
+// Dispatch function suffixes and call arguments for the single-handler kinds
+static const char *dispatchNames[FSM_HANDLER_KIND_COUNT] = {"Event", "Entry", "Update", "Exit", "Resume"};
+static const char *dispatchArguments[FSM_HANDLER_KIND_COUNT] = {"obj, event", "obj", "obj", "obj", "obj, elapsed"};
+
+typedef struct
+{
+    char name[128];
+    uint32_t handlers[FSM_HANDLER_KIND_COUNT];
+    int32_t next[STATE_COUNT];
+    uint32_t nextCount;
+    uint32_t transitionMask;
+    uint32_t eventMask;
+    int defined;
+} CompiledState;
+
+static CompiledState states[STATE_COUNT];
+static char handlerNames[MAX_HANDLERS][128];
+static int handlerKinds[MAX_HANDLERS];
+static uint32_t handlerCount = 0;
+static char archetype[64] = "";
+
+static const char *inputPath;
+static int lineNumber = 0;
+
+// Reports a syntax error and exits
+static void Fail(const char *message, const char *token)
+{
+    fprintf(stderr, "%s:%d: %s%s%s\n", inputPath, lineNumber, message, token ? ": " : "", token ? token : "");
+    exit(1);
+}
+
+// Looks a name up in an enum name table, -1 if not found
+static int Lookup(const char **names, int count, const char *name)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (strcmp(names[i], name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+// Checks that a name can be used as a C identifier
+static int IsIdentifier(const char *name)
+{
+    if (!isalpha((unsigned char)name[0]) && name[0] != '_')
+        return 0;
+    for (const char *c = name; *c; c++)
+    {
+        if (!isalnum((unsigned char)*c) && *c != '_')
+            return 0;
+    }
+    return 1;
+}
+
+// Returns the id of a handler name, adding it on first use
+static uint32_t HandlerId(const char *name, int kind)
+{
+    for (uint32_t i = 0; i < handlerCount; i++)
+    {
+        if (strcmp(handlerNames[i], name) == 0)
+        {
+            if (handlerKinds[i] != kind)
+                Fail("handler used for two different slots", name);
+            return i;
+        }
+    }
+    if (handlerCount == MAX_HANDLERS || strlen(name) >= sizeof(handlerNames[0]))
+        Fail("too many or too long handler names", name);
+    if (!IsIdentifier(name))
+        Fail("handler name is not a C identifier", name);
+
+    strcpy(handlerNames[handlerCount], name);
+    handlerKinds[handlerCount] = kind;
+    return handlerCount++;
+}
+
+static void Parse(FILE *file)
+{
+    char line[MAX_LINE];
+    CompiledState *current = NULL;
+
+    for (int s = 0; s < STATE_COUNT; s++)
+    {
+        for (int kind = 0; kind < FSM_HANDLER_KIND_COUNT; kind++)
+            states[s].handlers[kind] = FSM_BLOB_NONE;
+    }
+
+    while (fgets(line, sizeof(line), file))
+    {
+        lineNumber++;
+
+        char *comment = strchr(line, '#');
+        if (comment)
+            *comment = '\0';
+
+        char *directive = strtok(line, " \t\r\n");
+        if (!directive)
+            continue;
+
+        if (strcmp(directive, "archetype") == 0)
+        {
+            char *name = strtok(NULL, " \t\r\n");
+            if (current)
+                Fail("archetype inside a state", name);
+            if (!name || !IsIdentifier(name) || strlen(name) >= sizeof(archetype))
+                Fail("missing or invalid archetype name", name);
+
+            strcpy(archetype, name);
+            continue;
+        }
+
+        if (strcmp(directive, "state") == 0)
+        {
+            if (current)
+                Fail("missing 'end' before", directive);
+
+            char *enumName = strtok(NULL, " \t\r\n");
+            char *displayName = strtok(NULL, " \t\r\n");
+            int state = enumName ? Lookup(stateNames, STATE_COUNT, enumName) : -1;
+            if (state < 0)
+                Fail("unknown state", enumName);
+            if (states[state].defined)
+                Fail("state defined twice", enumName);
+            if (!displayName || strlen(displayName) >= sizeof(states[state].name))
+                Fail("missing or too long state name", enumName);
+
+            current = &states[state];
+            current->defined = 1;
+            strcpy(current->name, displayName);
+            continue;
+        }
+
+        if (!current)
+            Fail("directive outside of a state", directive);
+
+        if (strcmp(directive, "end") == 0)
+        {
+            current = NULL;
+            continue;
+        }
+
+        int kind = Lookup(handlerKeywords, FSM_HANDLER_KIND_COUNT, directive);
+        if (kind >= 0)
+        {
+            char *handler = strtok(NULL, " \t\r\n");
+            if (!handler)
+                Fail("missing handler name for", directive);
+            current->handlers[kind] = HandlerId(handler, kind);
+        }
+        else if (strcmp(directive, "next") == 0)
+        {
+            for (char *token = strtok(NULL, " \t\r\n"); token; token = strtok(NULL, " \t\r\n"))
+            {
+                int state = Lookup(stateNames, STATE_COUNT, token);
+                if (state < 0)
+                    Fail("unknown state", token);
+                if (current->transitionMask & (1u << state))
+                    continue; // Listed twice
+                current->next[current->nextCount++] = state;
+                current->transitionMask |= 1u << state;
+            }
+        }
+        else if (strcmp(directive, "events") == 0)
+        {
+            for (char *token = strtok(NULL, " \t\r\n"); token; token = strtok(NULL, " \t\r\n"))
+            {
+                int event = Lookup(eventNames, EVENT_COUNT, token);
+                if (event < 0)
+                    Fail("unknown event", token);
+                current->eventMask |= 1u << event;
+            }
+        }
+        else
+        {
+            Fail("unknown directive", directive);
+        }
+    }
+
+    if (current)
+        Fail("missing 'end' at end of file", NULL);
+}
+
+// Appends a string to the string table, returns its offset within the table
+static uint32_t AddString(char *strings, uint32_t *length, const char *string)
+{
+    uint32_t size = (uint32_t)strlen(string) + 1;
+    if (*length + size > MAX_STRINGS)
+        Fail("string table full", string);
+
+    uint32_t offset = *length;
+    memcpy(strings + offset, string, size);
+    *length += size;
+    return offset;
+}
+
+static void Write(const char *outputPath)
+{
+    static char strings[MAX_STRINGS];
+    uint32_t stringsLength = 0;
+
+    uint32_t handlerOffsets[MAX_HANDLERS];
+    for (uint32_t i = 0; i < handlerCount; i++)
+        handlerOffsets[i] = AddString(strings, &stringsLength, handlerNames[i]);
+
+    uint32_t transitionCount = 0;
+    for (int s = 0; s < STATE_COUNT; s++)
+        transitionCount += states[s].nextCount;
+
+    FsmBlobHeader header = {0};
+    header.magic = FSM_BLOB_MAGIC;
+    header.version = FSM_BLOB_VERSION;
+    header.stateCount = STATE_COUNT;
+    header.eventCount = EVENT_COUNT;
+    header.handlerCount = handlerCount;
+    header.handlersOffset = sizeof(FsmBlobHeader);
+    header.statesOffset = header.handlersOffset + handlerCount * sizeof(uint32_t);
+    header.transitionsOffset = header.statesOffset + STATE_COUNT * sizeof(FsmBlobState);
+    header.transitionCount = transitionCount;
+
+    uint32_t stringsOffset = header.transitionsOffset + transitionCount * sizeof(int32_t);
+
+    FsmBlobState blobStates[STATE_COUNT];
+    uint32_t first = 0;
+    for (int s = 0; s < STATE_COUNT; s++)
+    {
+        CompiledState *state = &states[s];
+        FsmBlobState *blobState = &blobStates[s];
+
+        blobState->name = state->defined ? stringsOffset + AddString(strings, &stringsLength, state->name) : FSM_BLOB_NONE;
+        memcpy(blobState->handlers, state->handlers, sizeof(blobState->handlers));
+        blobState->transitionMask = state->transitionMask;
+        blobState->eventMask = state->eventMask;
+        blobState->nextStatesFirst = first;
+        blobState->nextStatesCount = state->nextCount;
+        first += state->nextCount;
+    }
+    for (uint32_t i = 0; i < handlerCount; i++)
+        handlerOffsets[i] += stringsOffset;
+
+    // Pad the string table so the blob size stays 4 byte aligned
+    while (stringsLength % 4)
+        strings[stringsLength++] = '\0';
+    header.size = stringsOffset + stringsLength;
+
+    FILE *output = fopen(outputPath, "wb");
+    if (!output)
+    {
+        fprintf(stderr, "Cannot write %s\n", outputPath);
+        exit(1);
+    }
+
+    fwrite(&header, sizeof(header), 1, output);
+    fwrite(handlerOffsets, sizeof(uint32_t), handlerCount, output);
+    fwrite(blobStates, sizeof(FsmBlobState), STATE_COUNT, output);
+    for (int s = 0; s < STATE_COUNT; s++)
+        fwrite(states[s].next, sizeof(int32_t), states[s].nextCount, output);
+    fwrite(strings, 1, stringsLength, output);
+
+    if (fclose(output) != 0)
+    {
+        fprintf(stderr, "Failed writing %s\n", outputPath);
+        exit(1);
+    }
+
+    printf("%s -> %s (%u handlers, %u transitions, %u bytes)\n",
+           inputPath, outputPath, handlerCount, transitionCount, header.size);
+}
+
+// Emits a switch over the current state calling one kind of handler directly
+static void WriteDispatchSwitch(FILE *output, int kind)
+{
+    fprintf(output, "static inline void %sDispatch%s(%s)\n{\n", archetype, dispatchNames[kind], handlerParameters[kind]);
+    fprintf(output, "    switch (obj->currentState)\n    {\n");
+    for (int s = 0; s < STATE_COUNT; s++)
+    {
+        uint32_t id = states[s].handlers[kind];
+        if (id == FSM_BLOB_NONE)
+            continue;
+        fprintf(output, "    case %s:\n        %s(%s);\n        break;\n", stateNames[s], handlerNames[id], dispatchArguments[kind]);
+    }
+    fprintf(output, "    default:\n        break;\n    }\n}\n\n");
+}
+
+// Emits a switch over a state returning one of its masks
+static void WriteMaskSwitch(FILE *output, const char *function, const char *parameters, const char *test, int transitions)
+{
+    fprintf(output, "static inline bool %s%s(%s)\n{\n", archetype, function, parameters);
+    fprintf(output, "    switch (state)\n    {\n");
+    for (int s = 0; s < STATE_COUNT; s++)
+    {
+        uint32_t mask = transitions ? states[s].transitionMask : states[s].eventMask;
+        if (mask == 0)
+            continue; // No transitions (false) or reacts to every event (true), handled by the default case
+        fprintf(output, "    case %s:\n        return (0x%08Xu >> %s) & 1u;\n", stateNames[s], mask, test);
+    }
+    fprintf(output, "    default:\n        return %s;\n    }\n}\n\n", transitions ? "false" : "true");
+}
+
+static void WriteDispatch(const char *outputPath)
+{
+    if (archetype[0] == '\0')
+    {
+        fprintf(stderr, "%s: an 'archetype' directive is needed to generate dispatch code\n", inputPath);
+        exit(1);
+    }
+
+    char guard[sizeof(archetype) + 16];
+    size_t length = 0;
+    for (const char *c = archetype; *c; c++)
+        guard[length++] = (char)toupper((unsigned char)*c);
+    strcpy(guard + length, "_DISPATCH_H");
+
+    FILE *output = fopen(outputPath, "w");
+    if (!output)
+    {
+        fprintf(stderr, "Cannot write %s\n", outputPath);
+        exit(1);
+    }
+
+    fprintf(output, "// Generated by tools/fsm_compiler from %s, do not edit\n", inputPath);
+    fprintf(output, "#ifndef %s\n#define %s\n\n", guard, guard);
+    fprintf(output, "#include <stdbool.h>\n\n#include \"include/gameobjects/gameobject.h\"\n\n");
+
+    // Prototypes, so the header does not depend on the archetype's own header
+    for (uint32_t i = 0; i < handlerCount; i++)
+        fprintf(output, "void %s(%s);\n", handlerNames[i], handlerParameters[handlerKinds[i]]);
+    fprintf(output, "\n");
+
+    WriteMaskSwitch(output, "CanEnterState", "State state, State newState", "newState", 1);
+    WriteMaskSwitch(output, "AcceptsEvent", "State state, Event event", "event", 0);
+    for (int kind = 0; kind < FSM_HANDLER_KIND_COUNT; kind++)
+        WriteDispatchSwitch(output, kind);
+
+    fprintf(output, "#endif // %s\n", guard);
+
+    if (fclose(output) != 0)
+    {
+        fprintf(stderr, "Failed writing %s\n", outputPath);
+        exit(1);
+    }
+
+    printf("%s -> %s (%s dispatch, %u handlers)\n", inputPath, outputPath, archetype, handlerCount);
+}
+
+int main(int argc, char *argv[])
+{
+    int dispatch = (argc == 4 && strcmp(argv[1], "--dispatch") == 0);
+    if (argc != 3 && !dispatch)
+    {
+        fprintf(stderr, "Usage: %s <input.fsm> <output.fsmb>\n", argv[0]);
+        fprintf(stderr, "       %s --dispatch <input.fsm> <output.h>\n", argv[0]);
+        return 1;
+    }
+    if (dispatch)
+    {
+        argv++;
+    }
+
+    inputPath = argv[1];
+    FILE *input = fopen(inputPath, "r");
+    if (!input)
+    {
+        fprintf(stderr, "Cannot open %s\n", inputPath);
+        return 1;
+    }
+
+    Parse(input);
+    fclose(input);
+
+    if (dispatch)
+        WriteDispatch(argv[2]);
+    else
+        Write(argv[2]);
+    return 0;
+}